@@ -11,6 +11,8 @@
   *  @brief Clase Random
   *
   * Una instancia del type Random será un generador modular de números aleatorios.
+  * Cada hebra tiene su propio generador, de forma que varias hebras pueden generar
+  * secuencias independientes y reproducibles fijando cada una su semilla.
   *
   *
   * @author Antonio David Villegas Yeguas
@@ -18,6 +20,7 @@
   */
 
 #include <random>
+#include <vector>
 
 
 class Random{
@@ -33,7 +36,7 @@ class Random{
 		  *
 		  */
 
-		static std::mt19937 generator_;
+		static thread_local std::mt19937 generator_;
 
 		/**
 		  * @brief Constructor sin parámetros que iniciliza la semilla a un value aleatorio
@@ -46,7 +49,7 @@ class Random{
 	public:
 
 		/**
-		 * @brief Inicializar la semilla
+		 * @brief Inicializar la semilla del generador de la hebra actual
 		 *
 		 * @param seed Nueva semilla para el generador
 		 */
@@ -107,6 +110,17 @@ class Random{
 
 		static float get_float(const float HIGH);
 
+		/**
+		  * @brief Rellenar un vector con valores reales aleatorios entre dos valores dados,
+		  * los mismos que se obtendrían llamando a get_float(LOW, HIGH) para cada posición
+		  *
+		  * @param values Vector a rellenar
+		  * @param LOW Límite inferior para los valores a generar
+		  * @param HIGH Límite superior para los valores a generar
+		  */
+
+		static void fill_float(std::vector<double> & values, const float LOW, const float HIGH);
+
 
 		/**
 		  * @brief Generar un value entero aleatorio entre dos valores dados
@@ -139,6 +153,15 @@ class Random{
 
 		static std::mt19937 get_generator();
 
+		/**
+		  * @brief Sustituir el generador de aleatorios de la hebra actual, por ejemplo
+		  * para restaurar uno obtenido con get_generator
+		  *
+		  * @param generador Nuevo generador de la hebra actual
+		  */
+
+		static void set_generator(const std::mt19937 & generador);
+
 };
 
 #endif
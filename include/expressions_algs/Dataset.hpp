@@ -0,0 +1,454 @@
+/**
+  * \@file Dataset.hpp
+  * @brief Header file of the Dataset class
+  *
+  */
+
+#ifndef DATASET_H_INCLUDED
+#define DATASET_H_INCLUDED
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace expressions_algs {
+
+/**
+  *  @brief Dataset Class
+  *
+  *  An instance of type Dataset stores a set of rows of numeric features and
+  *  their labels. The features live in one contiguous block of memory, either
+  *  row-major (when they are parsed from a delimited text file or copied from a
+  *  matrix) or column-major (when a binary dataset file is memory mapped without
+  *  copying). Every access goes through the strides, so both layouts are used in
+  *  the same way. Copies of a Dataset share the same immutable features, and
+  *  so do views, datasets made of some rows of another one through a list of
+  *  row indices.
+  *
+  *  The binary format, written by write_binary and convert_text_file, is a 64
+  *  byte header (magic, version, number of columns and rows, column stride,
+  *  offset of the first column and a hash of the column data), followed by the
+  *  offset and the type of each column, and then the columns, each one starting
+  *  at a multiple of 64 bytes: the features in order and the label the last
+  *  one. Values are native endian doubles.
+  *
+  *  A mapped dataset does not need to fit in memory: it is read by windows of
+  *  rows, asking the kernel to read ahead the next window while the current one
+  *  is used and dropping the pages of the windows already used.
+  *
+  *
+  * @author Antonio David Villegas Yeguas
+  * @date Octubre 2026
+  */
+
+class Dataset {
+	private:
+
+		/**
+		  * @page repDataset Representation of the Dataset class
+		  *
+		  * @section invDataset Representation invariant
+		  *
+		  * labels_.size == num_rows_, and features_ points to a block that lives as long as storage_,
+		  * which is a file mapping if and only if mapped_. If row_index_ is not null,
+		  * row_index_->size == num_rows_
+		  *
+		  * @section faDataset Abstraction function
+		  *
+		  * A valid object @e rep of class Dataset represents the data where the
+		  * feature j of the row i is
+		  *
+		  * rep.features_[r * rep.row_stride_ + j * rep.column_stride_]
+		  *
+		  * with r = (*rep.row_index_)[i] for a view and r = i otherwise
+		  *
+		  * And the label of the row i is
+		  *
+		  * rep.labels_[i]
+		  *
+		  */
+
+		/**
+		  * @brief Number of rows
+		  */
+
+		unsigned num_rows_;
+
+		/**
+		  * @brief Number of features of each row
+		  */
+
+		unsigned num_columns_;
+
+		/**
+		  * @brief Distance, in values, between two consecutive rows of a column
+		  */
+
+		std::size_t row_stride_;
+
+		/**
+		  * @brief Distance, in values, between two consecutive columns of a row
+		  */
+
+		std::size_t column_stride_;
+
+		/**
+		  * @brief Owner of the memory of the features: a vector or a file mapping
+		  */
+
+		std::shared_ptr<const void> storage_;
+
+		/**
+		  * @brief First feature of the first row
+		  */
+
+		const double * features_;
+
+		/**
+		  * @brief Label of each row
+		  */
+
+		std::vector<double> labels_;
+
+		/**
+		  * @brief Hash of the content of the binary file, 0 if the data was not read from one
+		  */
+
+		std::uint64_t content_hash_;
+
+		/**
+		  * @brief True if the features are read from a file mapping
+		  */
+
+		bool mapped_;
+
+		/**
+		  * @brief Size, in bytes, of a window of rows of a mapped dataset
+		  */
+
+		std::size_t stream_window_bytes_;
+
+		/**
+		  * @brief Row of the shared features of each row of a view, null if it is not a view
+		  */
+
+		std::shared_ptr<const std::vector<std::uint32_t> > row_index_;
+
+		/**
+		  * @brief Build a row-major dataset that takes the ownership of the features.
+		  *
+		  * @param num_columns Number of features of each row.
+		  * @param values Features of all the rows, row after row.
+		  * @param labels Label of each row.
+		  */
+
+		Dataset(const unsigned num_columns, std::vector<double> && values, std::vector<double> && labels);
+
+		/**
+		  * @brief Give advice to the kernel about the pages of the mapping that hold some rows.
+		  *
+		  * @param first First row.
+		  * @param last Row after the last one.
+		  * @param advice Advice for madvise.
+		  * @param whole_pages Only include the pages that hold nothing but those rows.
+		  */
+
+		void advise_rows(const unsigned first, const unsigned last, const int advice,
+							  const bool whole_pages) const;
+
+	public:
+
+		/**
+		  * @brief Magic bytes at the beginning of a binary dataset file
+		  */
+
+		static constexpr char BINARY_MAGIC[9] = "GAPDSET1";
+
+		/**
+		  * @brief Alignment, in bytes, of each column of a binary dataset file
+		  */
+
+		static const unsigned BINARY_ALIGNMENT = 64;
+
+		/**
+		  * @brief Default size, in bytes, of a window of rows of a mapped dataset
+		  */
+
+		static const std::size_t STREAM_WINDOW_BYTES = 1 << 25;
+
+		/**
+		  * @brief Default constructor, empty dataset.
+		  */
+
+		Dataset();
+
+		/**
+		  * @brief Constructor with two parameters. Copy the data in row-major order.
+		  *
+		  * @param data Matrix with the features of each row.
+		  * @param labels Label of each row.
+		  *
+		  * @pre All the rows of data have the same size, and data.size == labels.size
+		  */
+
+		Dataset(const std::vector<std::vector<double> > & data, const std::vector<double> & labels);
+
+		/**
+		  * @brief Get the number of rows.
+		  *
+		  * @return Number of rows.
+		  */
+
+		unsigned get_num_rows() const;
+
+		/**
+		  * @brief Get the number of features of each row.
+		  *
+		  * @return Number of features.
+		  */
+
+		unsigned get_num_columns() const;
+
+		/**
+		  * @brief Get the first feature of a row. The feature j of the row is at
+		  * position j * get_column_stride().
+		  *
+		  * @param row Index of the row.
+		  *
+		  * @return Pointer to the first feature of the row.
+		  */
+
+		const double * get_row(const unsigned row) const;
+
+		/**
+		  * @brief Get the distance, in values, between two consecutive features of a row.
+		  *
+		  * @return 1 for row-major data, the padded number of rows for column-major data.
+		  */
+
+		std::size_t get_column_stride() const;
+
+		/**
+		  * @brief Get a feature of a row.
+		  *
+		  * @param row Index of the row.
+		  * @param column Index of the feature.
+		  *
+		  * @return Value of the feature.
+		  */
+
+		double get_value(const unsigned row, const unsigned column) const;
+
+		/**
+		  * @brief Copy the features of a row.
+		  *
+		  * @param row Index of the row.
+		  *
+		  * @return Vector with the features of the row.
+		  */
+
+		std::vector<double> get_row_values(const unsigned row) const;
+
+		/**
+		  * @brief Get the labels of all the rows.
+		  *
+		  * @return Labels, one per row.
+		  */
+
+		const std::vector<double> & get_labels() const;
+
+		/**
+		  * @brief Get the hash of the content of the binary file the data was read from.
+		  *
+		  * @return Hash of the columns, 0 if the data was not read from a binary file.
+		  */
+
+		std::uint64_t get_content_hash() const;
+
+		/**
+		  * @brief Check if the features are read from a file mapping instead of from memory.
+		  *
+		  * @return True if the dataset was mapped with map_binary.
+		  */
+
+		bool is_mapped() const;
+
+		/**
+		  * @brief Get the number of rows of each window in which the data is read.
+		  *
+		  * @return Rows of a window of get_stream_window_bytes bytes for a mapped dataset,
+		  * all the rows for a dataset in memory or a view.
+		  */
+
+		unsigned get_stream_rows() const;
+
+		/**
+		  * @brief Get the size of a window of rows of a mapped dataset.
+		  *
+		  * @return Size, in bytes, of a window.
+		  */
+
+		std::size_t get_stream_window_bytes() const;
+
+		/**
+		  * @brief Set the size of a window of rows of a mapped dataset.
+		  *
+		  * @param bytes Size, in bytes, of a window.
+		  */
+
+		void set_stream_window_bytes(const std::size_t bytes);
+
+		/**
+		  * @brief Ask the kernel to start reading some rows of a mapped dataset, without
+		  * waiting for them. Does nothing for a dataset in memory.
+		  *
+		  * @param first First row.
+		  * @param last Row after the last one.
+		  */
+
+		void prefetch_rows(const unsigned first, const unsigned last) const;
+
+		/**
+		  * @brief Drop from memory the pages of some rows of a mapped dataset, they are read
+		  * again from the file if they are used later. Does nothing for a dataset in memory.
+		  *
+		  * @param first First row.
+		  * @param last Row after the last one.
+		  */
+
+		void release_rows(const unsigned first, const unsigned last) const;
+
+		/**
+		  * @brief Copy the features to a matrix with one vector per row.
+		  *
+		  * @return Matrix with the features of each row.
+		  */
+
+		std::vector<std::vector<double> > to_matrix() const;
+
+		/**
+		  * @brief Copy some rows to a new row-major dataset.
+		  *
+		  * @param rows Index of each row to copy, in the order they are stored.
+		  *
+		  * @return Dataset with the rows and their labels.
+		  */
+
+		Dataset select_rows(const std::vector<std::uint32_t> & rows) const;
+
+		/**
+		  * @brief Make a view of some rows, which shares the features with this dataset
+		  * without copying them; only the labels of the rows are copied. A view of a
+		  * mapped dataset is not read by windows.
+		  *
+		  * @param rows Index of each row of the view, in the order they are used.
+		  *
+		  * @return View with the rows.
+		  */
+
+		Dataset view_rows(std::vector<std::uint32_t> rows) const;
+
+		/**
+		  * @brief Check if the dataset is a view of the rows of another one.
+		  *
+		  * @return True if it was made with view_rows.
+		  */
+
+		bool is_view() const;
+
+		/**
+		  * @brief Read a delimited text file. Lines starting with comment_char, empty lines
+		  * and lines starting with a blank are ignored; in the rest of lines, the last
+		  * field is the label and the previous ones are the features.
+		  *
+		  * The file is memory mapped, split in one chunk per thread at line boundaries
+		  * and parsed in parallel straight into the preallocated matrix.
+		  *
+		  * @param data_file Path of the file.
+		  * @param comment_char Character that marks a line as a comment.
+		  * @param delimiter Character that separates the fields of a line.
+		  * @param dataset Where the data is stored.
+		  *
+		  * @return True if the file was read. False if it could not be mapped or if its lines
+		  * do not have all the same number of fields, in which case dataset is not modified.
+		  */
+
+		static bool read_file(const std::string & data_file, const char comment_char,
+									 const char delimiter, Dataset & dataset);
+
+		/**
+		  * @brief Write the dataset in the binary columnar format.
+		  *
+		  * @param data_file Path of the file to write.
+		  *
+		  * @return True if the file was written.
+		  */
+
+		bool write_binary(const std::string & data_file) const;
+
+		/**
+		  * @brief Convert a delimited text file to the binary columnar format without loading
+		  * it, so the data does not need to fit in memory. The text is read twice, first to
+		  * count the rows and then by blocks of rows that are written to each column of the
+		  * output file, and at last the output is read back to compute its hash.
+		  *
+		  * @param text_file Path of the text file, read as in read_file.
+		  * @param binary_file Path of the file to write.
+		  * @param comment_char Character that marks a line as a comment.
+		  * @param delimiter Character that separates the fields of a line.
+		  * @param num_rows Where the number of rows converted is stored.
+		  * @param num_columns Where the number of features of each row is stored.
+		  *
+		  * @return True if the file was converted. False if the text file could not be mapped,
+		  * has no rows or its lines do not have all the same number of fields, or if the output
+		  * could not be written.
+		  */
+
+		static bool convert_text_file(const std::string & text_file, const std::string & binary_file,
+												const char comment_char, const char delimiter,
+												unsigned & num_rows, unsigned & num_columns);
+
+		/**
+		  * @brief Check if a file is a binary dataset file.
+		  *
+		  * @param data_file Path of the file.
+		  *
+		  * @return True if the file starts with BINARY_MAGIC.
+		  */
+
+		static bool is_binary_file(const std::string & data_file);
+
+		/**
+		  * @brief Memory map a binary dataset file. The features are used from the
+		  * mapping without copying them; only the labels are copied.
+		  *
+		  * @param data_file Path of the file.
+		  * @param dataset Where the data is stored.
+		  * @param verify_hash Check the hash of the content, which reads the whole file.
+		  *
+		  * @return True if the file was mapped. False if it could not be mapped or it is
+		  * not a valid binary dataset, in which case dataset is not modified.
+		  */
+
+		static bool map_binary(const std::string & data_file, Dataset & dataset,
+									  const bool verify_hash = false);
+
+		/**
+		  * @brief Load a dataset file, either binary or delimited text.
+		  *
+		  * @param data_file Path of the file.
+		  * @param comment_char Character that marks a line as a comment in a text file.
+		  * @param delimiter Character that separates the fields of a line in a text file.
+		  *
+		  * @return Dataset read, empty if the file could not be read.
+		  */
+
+		static Dataset load(const std::string & data_file, const char comment_char,
+								  const char delimiter = ',');
+
+};
+
+} // namespace expressions_algs
+
+#endif
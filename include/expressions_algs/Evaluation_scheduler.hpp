@@ -0,0 +1,175 @@
+/**
+  * \@file Evaluation_scheduler.hpp
+  * @brief Header file of the Evaluation_scheduler class
+  *
+  */
+
+#ifndef EVALUATION_SCHEDULER_H_INCLUDED
+#define EVALUATION_SCHEDULER_H_INCLUDED
+
+#include "expressions_algs/aux_expressions_alg.hpp"
+
+namespace expressions_algs {
+
+/**
+  * @brief Possible axes to split the evaluation of a population between threads
+  */
+
+enum class EvaluationAxis {INDIVIDUALS, ROWS, TILES};
+
+/**
+  *  @brief Evaluation_scheduler Class
+  *
+  *  An instance of type Evaluation_scheduler decides how to split the evaluation
+  *  of a set of individuals between the available threads: across individuals,
+  *  across blocks of rows, or across both in a 2D tiling of
+  *  (individual, block of rows).
+  *
+  *
+  * @author Antonio David Villegas Yeguas
+  * @date Octubre 2026
+  */
+
+class Evaluation_scheduler {
+	private:
+
+		/**
+		  * @page repEvaluation_scheduler Representation of the Evaluation_scheduler class
+		  *
+		  * @section invEvaluation_scheduler Representation invariant
+		  *
+		  * row_blocks_ >= 1 and num_threads_ >= 1. If axis_ == INDIVIDUALS, row_blocks_ == 1
+		  *
+		  * @section faEvaluation_scheduler Abstraction function
+		  *
+		  * A valid object @e rep of class Evaluation_scheduler represents a plan of evaluation
+		  * along the axis
+		  *
+		  * rep.axis_
+		  *
+		  * Splitting the rows in rep.row_blocks_ blocks and using rep.num_threads_ threads
+		  *
+		  */
+
+		/**
+		  * @brief Axis to split the evaluation
+		  */
+
+		EvaluationAxis axis_;
+
+		/**
+		  * @brief Number of blocks in which the rows of each individual are split
+		  */
+
+		unsigned row_blocks_;
+
+		/**
+		  * @brief Number of threads to use
+		  */
+
+		unsigned num_threads_;
+
+	public:
+
+		/**
+		  * @brief Minimum number of rows of a block, smaller blocks do not pay the cost of the split
+		  */
+
+		static const unsigned MIN_ROWS_PER_BLOCK = 1024;
+
+		/**
+		  * @brief Minimum work (nodes times rows) to evaluate in parallel
+		  */
+
+		static const unsigned long MIN_PARALLEL_WORK = 1UL << 16;
+
+		/**
+		  * @brief Number of tasks per thread needed to balance the load
+		  */
+
+		static const unsigned TASKS_PER_THREAD = 4;
+
+		/**
+		  * @brief Size of the data that is assumed to fit in the L2 cache of a core
+		  */
+
+		static const unsigned long L2_CACHE_BYTES = 1UL << 20;
+
+		/**
+		  * @brief Size of a block of rows in cache blocked evaluation, leaving room for the trees
+		  */
+
+		static const unsigned long CACHE_BLOCK_BYTES = L2_CACHE_BYTES / 4;
+
+		/**
+		  * @brief Constructor with four parameters. Decide the plan of evaluation.
+		  *
+		  * @param num_individuals Number of individuals to evaluate.
+		  * @param total_length Sum of the tree lengths of the individuals to evaluate.
+		  * @param num_rows Number of rows of the data.
+		  * @param num_threads Number of available threads.
+		  *
+		  */
+
+		Evaluation_scheduler(const unsigned num_individuals, const unsigned long total_length,
+									const unsigned num_rows, const unsigned num_threads = available_threads());
+
+		/**
+		  * @brief Get the axis to split the evaluation.
+		  *
+		  * @return Axis of the evaluation.
+		  */
+
+		EvaluationAxis get_axis() const;
+
+		/**
+		  * @brief Get the number of blocks of rows of each individual.
+		  *
+		  * @return Number of blocks of rows.
+		  */
+
+		unsigned get_row_blocks() const;
+
+		/**
+		  * @brief Get the number of threads to use.
+		  *
+		  * @return Number of threads.
+		  */
+
+		unsigned get_num_threads() const;
+
+		/**
+		  * @brief Check if the individuals should be evaluated block by block of rows, so each
+		  * block is loaded in cache once for a whole group of individuals.
+		  *
+		  * @param num_rows Number of rows of the data.
+		  * @param row_bytes Approximate size in bytes of a row of the data.
+		  *
+		  * @return True if the evaluation is split across individuals and the data does not fit in L2.
+		  */
+
+		bool cache_blocking(const unsigned num_rows, const unsigned long row_bytes) const;
+
+		/**
+		  * @brief Get the number of rows of a block in cache blocked evaluation.
+		  *
+		  * @param row_bytes Approximate size in bytes of a row of the data.
+		  *
+		  * @return Number of rows that fit in CACHE_BLOCK_BYTES, at least 1.
+		  */
+
+		static unsigned cache_block_rows(const unsigned long row_bytes);
+
+		/**
+		  * @brief Get the number of threads available for the evaluation.
+		  *
+		  * @return Number of threads of the global Task_scheduler.
+		  */
+
+		static unsigned available_threads();
+
+};
+
+} // namespace expressions_algs
+
+#endif
@@ -9,6 +9,7 @@
 
 #include "expressions_algs/Node.hpp"
 #include "expressions_algs/aux_expressions_alg.hpp"
+#include "expressions_algs/Dataset.hpp"
 
 
 namespace expressions_algs {
@@ -48,6 +49,10 @@ class Expression{
 		  *
 		  * rep.is_evaluated_
 		  *
+		  * If the fitness is only an estimation over a sample of the data
+		  *
+		  * rep.is_estimated_
+		  *
 		  */
 
 		/**
@@ -62,6 +67,18 @@ class Expression{
 
 		bool is_evaluated_;
 
+		/**
+		  * @brief Attribute to check if the fitness is only an estimation obtained on a sample of the data.
+		  */
+
+		bool is_estimated_;
+
+		/**
+		  * @brief Fitness values of the parents of the expression, if it is an offspring.
+		  */
+
+		std::pair<double, double> parents_fitness_;
+
 
 		/**
 		  * @brief Max depth for the tree representing the expression.
@@ -79,6 +96,12 @@ class Expression{
 		  */
 		unsigned num_variables_;
 
+		/**
+		  * @brief Maximum number of nodes, or of genes, accepted by read, so corrupt data
+		  * does not reserve memory without limit.
+		  */
+		static const std::uint32_t MAX_SERIALIZED_LENGTH = 1u << 24;
+
 		/**
 		  * @brief Initialize an expression as empty.
 		  *
@@ -100,6 +123,15 @@ class Expression{
 
 		void copy_data(const Expression & another);
 
+		/**
+		  * @brief Move data from another expression, which is left as a valid empty expression.
+		  *
+		  * @param another Expression from where to move data.
+		  *
+		  */
+
+		void move_data(Expression & another) noexcept;
+
 		/**
 		  * @brief Count the levels of the tree that represents an Expression.
 		  *
@@ -111,17 +143,36 @@ class Expression{
 
 		unsigned count_levels(std::stack<Node> & stack, unsigned actual_level) const;
 
+		/**
+		  * @brief Probability that generate_random_expression, at each point of the generation,
+		  * ends the tree within a budget of nodes. The table is computed once per thread for
+		  * each pair of max_length and budget.
+		  *
+		  * @param max_length Max length of the random expression.
+		  * @param budget Max number of nodes of the tree.
+		  *
+		  * @return Table where position i * (budget + 1) + r is the probability of ending within
+		  * budget nodes after generating i nodes with r free branches.
+		  *
+		  * @pre budget <= max_length
+		  */
+
+		static const std::vector<double> & subtree_fit_probabilities(const unsigned max_length,
+																						 const unsigned budget);
+
+
 		/**
 		  * @brief Evaluate the expression with a set of data. 
 		  *
 		  * @param stack Stack with the expression to evaluate
-		  * @param dato Data to evaluate
+		  * @param dato Data to evaluate, the variable j is at dato[j * stride]
+		  * @param stride Distance between two consecutive variables of dato
 		  *
 		  * @return Regression value obtained from evaluating data in stack.
 		  */
 
 		double evaluate_data(std::stack<Node> & stack,
-								 const std::vector<double> & dato) const;
+								 const double * dato, const std::size_t stride) const;
 
 		/**
 		  * @brief Obtain the numeric value of a node
@@ -200,6 +251,15 @@ class Expression{
 
 		Expression(const Expression & another);
 
+		/**
+		  * @brief Move constructor. Takes the tree of another expression without copying it.
+		  *
+		  * @param another Expression to move, left as a valid empty expression.
+		  *
+		  */
+
+		Expression(Expression && another) noexcept;
+
 
 		/**
 		  * @brief Constructor with three parameters, read an expression from a file.
@@ -237,6 +297,38 @@ class Expression{
 					 									 	const double prob_variable,
 														 	const unsigned num_variables);
 
+		/**
+		  * @brief Make this object a new random expression, in place, as the constructor
+		  * with the same parameters would do.
+		  *
+		  * @param max_length Max allowed length for the random expression
+		  * @param prob_variable Probability of a terminal symbol to be a variable
+		  * @param num_vars Number of variables to use in the expression.
+		  * @param max_depth Max depth allowed for this expression.
+		  */
+
+		virtual void initialize_random(const unsigned max_length, const double prob_variable,
+												 const unsigned num_vars, const unsigned max_depth);
+
+		/**
+		  * @brief Append a random subtree to a tree. The subtree has the distribution of the
+		  * trees of generate_random_expression conditioned to have at most budget nodes, so it
+		  * is generated in a single attempt, in time proportional to its size (after the first
+		  * call with the same max_length and budget in the thread).
+		  *
+		  * @param max_length Max length of the random expression.
+		  * @param budget Max number of nodes of the subtree.
+		  * @param prob_variable Probability of a terminal symbol to be a variable.
+		  * @param num_variables Number of variables to use in the subtree.
+		  * @param tree Tree where the nodes of the subtree are appended in preorder.
+		  *
+		  * @pre 1 <= budget <= max_length
+		  */
+
+		static void append_random_subtree(const unsigned max_length, const unsigned budget,
+													 const double prob_variable, const unsigned num_variables,
+													 std::vector<Node> & tree);
+
 		/**
 		  * @brief Check if the expression has been evaluated on a set of data since the last change.
 		  *
@@ -245,6 +337,40 @@ class Expression{
 
 		bool is_evaluated() const;
 
+		/**
+		  * @brief Check if the fitness is an estimation obtained on a sample of the data.
+		  *
+		  * @return Boolean: True if the fitness is estimated, false otherwise.
+		  */
+
+		bool is_estimated() const;
+
+		/**
+		  * @brief Set an estimated fitness, obtained on a sample of the data. The expression
+		  * is still considered as not evaluated.
+		  *
+		  * @param estimation Estimated fitness value.
+		  */
+
+		void set_estimated_fitness(const double estimation);
+
+		/**
+		  * @brief Set the fitness values of the parents of the expression.
+		  *
+		  * @param first_parent Fitness of the first parent.
+		  * @param second_parent Fitness of the second parent.
+		  */
+
+		void set_parents_fitness(const double first_parent, const double second_parent);
+
+		/**
+		  * @brief Get the fitness values of the parents of the expression.
+		  *
+		  * @return Pair with the fitness of both parents, infinity if unknown.
+		  */
+
+		std::pair<double, double> get_parents_fitness() const;
+
 		/**
 		  * @brief Get the fitness value of the expression in certain data.
 		  *
@@ -253,6 +379,17 @@ class Expression{
 
 		double get_fitness() const;
 
+		/**
+		  * @brief Set the fitness value obtained evaluating the expression on the whole data,
+		  * for evaluations done outside of evaluate_expression.
+		  *
+		  * @param fitness Fitness value of the expression.
+		  *
+		  * @post The expression is evaluated.
+		  */
+
+		void set_fitness(const double fitness);
+
 
 		/**
 		  * @brief Check the tree length.
@@ -289,6 +426,95 @@ class Expression{
 								 	 aux::eval_function_t evaluation_f,
 								 	 const bool force_evaluation = false);
 
+		/**
+		  * @brief Evaluate a expression with new data. A mapped dataset is read by windows of rows.
+		  * A decomposable evaluation function (see aux::get_metric_reduction) is accumulated row
+		  * by row, without storing the predictions.
+		  *
+		  * @param data Data to evaluate the expression
+		  * @param labels Labels associated to data.
+		  * @param evaluation_f Function used to evaluate the expression
+		  * @param force_evaluation Boolean to force evaluation, if false, if the expression has not changed since the last evaluation, it will not be evaluated
+		  *
+		  * @post fitness = Error returned by evaluation_f in data using the expression.
+		  */
+
+		void evaluate_expression(const Dataset & data,
+									 const std::vector<double> & labels,
+								 	 aux::eval_function_t evaluation_f,
+								 	 const bool force_evaluation = false);
+
+		/**
+		  * @brief Compute several errors of the expression with a single prediction of the data.
+		  * The fitness of the expression is not modified.
+		  *
+		  * @param data Data to evaluate the expression
+		  * @param labels Labels associated to data.
+		  * @param functions Evaluation functions whose values are stored in Metrics::values
+		  *
+		  * @return Errors of the expression in data.
+		  */
+
+		aux::Metrics evaluate_metrics(const std::vector<std::vector<double>> & data,
+												const std::vector<double> & labels,
+												const std::vector<aux::eval_function_t> & functions = {}) const;
+
+		/**
+		  * @brief Compute several errors of the expression with a single prediction of the data.
+		  * The fitness of the expression is not modified. A mapped dataset is read by windows of rows.
+		  *
+		  * @param data Data to evaluate the expression
+		  * @param labels Labels associated to data.
+		  * @param functions Evaluation functions whose values are stored in Metrics::values
+		  *
+		  * @return Errors of the expression in data.
+		  */
+
+		aux::Metrics evaluate_metrics(const Dataset & data,
+												const std::vector<double> & labels,
+												const std::vector<aux::eval_function_t> & functions = {}) const;
+
+		/**
+		  * @brief Predict all the rows of the data using the expression. A mapped dataset is
+		  * read by windows of rows.
+		  *
+		  * @param data Data to predict.
+		  *
+		  * @return Prediction of each row.
+		  */
+
+		std::vector<double> predict(const Dataset & data) const;
+
+		/**
+		  * @brief Predict a range of rows of the data using the expression.
+		  *
+		  * @param data Data to predict.
+		  * @param first First row to predict.
+		  * @param last Row after the last row to predict.
+		  * @param predictions Vector where the prediction of row i is stored in position i.
+		  *
+		  * @pre predictions.size() >= last
+		  */
+
+		void predict_rows(const std::vector<std::vector<double>> & data,
+								const unsigned first, const unsigned last,
+								std::vector<double> & predictions) const;
+
+		/**
+		  * @brief Predict a range of rows of the data using the expression.
+		  *
+		  * @param data Data to predict.
+		  * @param first First row to predict.
+		  * @param last Row after the last row to predict.
+		  * @param predictions Vector where the prediction of row i is stored in position i.
+		  *
+		  * @pre predictions.size() >= last
+		  */
+
+		void predict_rows(const Dataset & data,
+								const unsigned first, const unsigned last,
+								std::vector<double> & predictions) const;
+
 		/**
 		  * @brief Evaluate a unique data using the expression.
 		  *
@@ -299,6 +525,18 @@ class Expression{
 
 		double evaluate_data(const std::vector<double> & data) const ;
 
+		/**
+		  * @brief Evaluate a unique data, stored with a stride between its variables,
+		  * using the expression.
+		  *
+		  * @param data First variable of the data to evaluate
+		  * @param stride Distance between two consecutive variables of data
+		  *
+		  * @return Estimated value by expression.
+		  */
+
+		double evaluate_data(const double * data, const std::size_t stride = 1) const ;
+
 		/**
 		  * @brief Exchange certain part of the expression by another given expression. 
 		  * 
@@ -317,13 +555,16 @@ class Expression{
 										  Expression & son) const;
 
 		/**
-		  * @brief Crossover between two trees representing expressions.
+		  * @brief Crossover between two trees representing expressions. The pair of crossover
+		  * points is drawn uniformly among the pairs that give two sons within the max depth,
+		  * using the size of the subtrees, so the sons are built in a single attempt.
 		  *
 		  * @param another Another expression, the crossover will be the result of crossing this and another.
 		  * @param son1 Expression to save the first son of the crossover.
 		  * @param son2 Expression to save the second son of the crossover.
 		  *
 		  * @pre another Is not an empty expression.
+		  * @post If no pair of points gives valid sons, son1 and son2 are not modified.
 		  */
 
 
@@ -346,6 +587,37 @@ class Expression{
 
 		Expression & operator= (const Expression & another);
 
+		/**
+		  * @brief Move assign operator: Takes the tree of another expression without copying it.
+		  *
+		  * @param another Expression to move, left as a valid empty expression.
+		  *
+		  * @return Reference to this expression.
+		  */
+
+		Expression & operator= (Expression && another) noexcept;
+
+		/**
+		  * @brief Write the expression in binary form: fitness, flags, depth, number of
+		  * variables and the nodes of the tree. Values are native endian, so it is meant to be
+		  * read by another process of the same machine or of a machine of the same architecture.
+		  *
+		  * @param os Stream where the expression is written.
+		  */
+
+		virtual void write(std::ostream & os) const;
+
+		/**
+		  * @brief Read an expression written with write.
+		  *
+		  * @param is Stream from where the expression is read.
+		  *
+		  * @return True if the expression was read. False if the stream ended before or the data
+		  * is not valid, in which case the expression is left in a valid but unspecified state.
+		  */
+
+		virtual bool read(std::istream & is);
+
 		/**
 		  * @brief Obtain the subtree that represents an expression since certain position
 		  *
@@ -357,6 +629,14 @@ class Expression{
 
 		std::vector<Node> get_subtree(const std::vector<Node> & subtree, int pos) const;
 
+		/**
+		  * @brief Compute the size of the subtree that starts at each node of the tree.
+		  *
+		  * @return Vector with the number of nodes of the subtree starting at each position.
+		  */
+
+		std::vector<unsigned> get_subtree_sizes() const;
+
 		/**
 		  * @brief Comput the depth of an expression
 		  *
@@ -414,7 +694,9 @@ class Expression{
 
 		/**
 		 *
-		 *  @brief Mutation of Genetic Programming
+		 *  @brief Mutation of Genetic Programming. Either a node is changed by another of the
+		 *  same arity, or the subtree of a random node is replaced by a random subtree that fits
+		 *  in the nodes left by the max depth.
 		 *
 		 *  @param num_vars Number of possible variables that the expression can use
 		 *
@@ -0,0 +1,150 @@
+/**
+  * \@file Fold_executor.hpp
+  * @brief Header file of the Fold_executor class
+  *
+  */
+
+#ifndef FOLD_EXECUTOR_H_INCLUDED
+#define FOLD_EXECUTOR_H_INCLUDED
+
+#include <functional>
+
+#include "expressions_algs/Evaluation_scheduler.hpp"
+
+namespace expressions_algs {
+
+/**
+  *  @brief Fold_executor Class
+  *
+  *  An instance of type Fold_executor runs a set of independent folds of a
+  *  validation concurrently as tasks of the global Task_scheduler. At most
+  *  num_threads folds run at the same time, and the parallel loops inside
+  *  the folds share the threads of the scheduler with the other folds. A
+  *  fold that waits for its parallel loops only helps with its own tasks,
+  *  so the time of a fold never includes the work of another fold.
+  *  Each fold runs with its own random generator, so the results do not
+  *  depend on how many folds run at the same time, and the wall time of each
+  *  fold is recorded.
+  *
+  *
+  * @author Antonio David Villegas Yeguas
+  * @date Octubre 2026
+  */
+
+class Fold_executor {
+	private:
+
+		/**
+		  * @page repFold_executor Representation of the Fold_executor class
+		  *
+		  * @section invFold_executor Representation invariant
+		  *
+		  * 1 <= concurrent_folds_ <= max(num_folds_, 1) and fold_times_.size == num_folds_
+		  *
+		  * @section faFold_executor Abstraction function
+		  *
+		  * A valid object @e rep of class Fold_executor represents the execution of
+		  * rep.num_folds_ folds, rep.concurrent_folds_ at a time, where the fold i took
+		  *
+		  * rep.fold_times_[i]
+		  *
+		  * seconds and all of them rep.wall_time_ seconds
+		  *
+		  */
+
+		/**
+		  * @brief Number of folds
+		  */
+
+		unsigned num_folds_;
+
+		/**
+		  * @brief Number of folds that run at the same time
+		  */
+
+		unsigned concurrent_folds_;
+
+		/**
+		  * @brief Wall time, in seconds, of each fold in the last execution
+		  */
+
+		std::vector<double> fold_times_;
+
+		/**
+		  * @brief Wall time, in seconds, of the last execution
+		  */
+
+		double wall_time_;
+
+	public:
+
+		/**
+		  * @brief Constructor with two parameters.
+		  *
+		  * @param num_folds Number of folds.
+		  * @param num_threads Number of threads available for all the folds.
+		  */
+
+		Fold_executor(const unsigned num_folds,
+						  const unsigned num_threads = Evaluation_scheduler::available_threads());
+
+		/**
+		  * @brief Run all the folds and record their wall time. The random generator of
+		  * the calling thread is the same after the execution.
+		  *
+		  * @param fold_task Function that runs a fold, given its index. It is called from
+		  * several threads at the same time and must set the seed of the random generator
+		  * (see fold_seed) before using it.
+		  */
+
+		void run(const std::function<void(const unsigned)> & fold_task);
+
+		/**
+		  * @brief Get the number of folds that run at the same time.
+		  *
+		  * @return Number of concurrent folds.
+		  */
+
+		unsigned get_concurrent_folds() const;
+
+		/**
+		  * @brief Get the wall time of each fold in the last execution.
+		  *
+		  * @return Seconds taken by each fold.
+		  */
+
+		const std::vector<double> & get_fold_times() const;
+
+		/**
+		  * @brief Get the wall time of the last execution.
+		  *
+		  * @return Seconds taken by all the folds.
+		  */
+
+		double get_wall_time() const;
+
+		/**
+		  * @brief Get the speedup of the last execution over running the folds one after another.
+		  *
+		  * @return Sum of the times of the folds divided by the wall time. With more concurrent
+		  * folds than cores the folds also take longer, so it overstates the real speedup.
+		  */
+
+		double get_speedup() const;
+
+		/**
+		  * @brief Get the seed of the random generator of a fold.
+		  *
+		  * @param seed Seed of the whole validation.
+		  * @param fold Index of the fold.
+		  *
+		  * @return Seed of the fold, different for each fold.
+		  */
+
+		static unsigned long fold_seed(const unsigned long seed, const unsigned fold);
+
+};
+
+} // namespace expressions_algs
+
+#endif
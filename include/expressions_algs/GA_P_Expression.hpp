@@ -88,6 +88,15 @@ class GA_P_Expression : public Expression {
 
 		void copy_data(const GA_P_Expression & another);
 
+		/**
+		  * @brief Move the data of a given expression to this expression.
+		  *
+		  * @param another Expression to move, left as a valid empty expression.
+		  *
+		  */
+
+		void move_data(GA_P_Expression & another) noexcept;
+
 
 
 		/**
@@ -177,6 +186,15 @@ class GA_P_Expression : public Expression {
 
 		GA_P_Expression(const GA_P_Expression & another);
 
+		/**
+		  * @brief Move constructor. Takes the tree and the chromosome without copying them.
+		  *
+		  * @param another Expression to move, left as a valid empty expression.
+		  *
+		  */
+
+		GA_P_Expression(GA_P_Expression && another) noexcept;
+
 		/**
 		  * @brief Destructor.
 		  *
@@ -198,6 +216,19 @@ class GA_P_Expression : public Expression {
 			 									 const double prob_variable,
 												 const unsigned num_variables) override;
 
+		/**
+		  * @brief Make this object a new random expression, with a new random chromosome, in
+		  * place, as the constructor with the same parameters would do.
+		  *
+		  * @param max_length Length of the expression to be generated.
+		  * @param prob_variable Probability of a node to be a variable.
+		  * @param num_vars Number of variables that can use the Expression
+		  * @param max_depth Maximum depth of the Expression, and length of the chromosome
+		  */
+
+		void initialize_random(const unsigned max_length, const double prob_variable,
+									  const unsigned num_vars, const unsigned max_depth) override;
+
 		/**
  		  * @brief Consult the length of the chromosome.
  		  *
@@ -216,6 +247,24 @@ class GA_P_Expression : public Expression {
 
 		void assign_chromosome(const std::vector<double> & new_chromosome);
 
+		/**
+		  * @brief Write the expression in binary form, the tree followed by the chromosome.
+		  *
+		  * @param os Stream where the expression is written.
+		  */
+
+		void write(std::ostream & os) const override;
+
+		/**
+		  * @brief Read an expression written with write.
+		  *
+		  * @param is Stream from where the expression is read.
+		  *
+		  * @return True if the expression was read.
+		  */
+
+		bool read(std::istream & is) override;
+
 		/**
 		  * @brief Assignment operator of an expression. We assign an expression to another.
 		  *
@@ -226,6 +275,16 @@ class GA_P_Expression : public Expression {
 
 		GA_P_Expression & operator= (const GA_P_Expression & another);
 
+		/**
+		  * @brief Move assignment operator. Takes the tree and the chromosome without copying them.
+		  *
+		  * @param another Expression to move, left as a valid empty expression.
+		  *
+		  * @return Reference to this Expressions, allows a = b = c
+		  */
+
+		GA_P_Expression & operator= (GA_P_Expression && another) noexcept;
+
 
 		/**
 		 * @brief Crossover operator for Expression chromosomes. By crossing two chromosomes we will obtain two new chromosomes.
@@ -33,7 +33,6 @@ class GA_P_alg : public Population_alg<GA_P_Expression> {
 	private:
 		using Population_alg<GA_P_Expression>::population_;
 		using Population_alg<GA_P_Expression>::data_;
-		using Population_alg<GA_P_Expression>::output_data_;
 		using Population_alg<GA_P_Expression>::expressions_depth_;
 
 		using Population_alg<GA_P_Expression>::read_data;
@@ -45,13 +44,14 @@ class GA_P_alg : public Population_alg<GA_P_Expression> {
 		using Population_alg<GA_P_Expression>::apply_elitism;
 		using Population_alg<GA_P_Expression>::apply_GP_mutations;
 		using Population_alg<GA_P_Expression>::initialize;
+		using Population_alg<GA_P_Expression>::evaluate_population;
 
 		/**
 		  * @page repGA_P Representation of GA_P_alg class
 		  *
 		  * @section invGA_P Invariant of the class
 		  *
-		  *  data_.size > 0 and output_data_.size == data.size
+		  *  data_.get_num_rows > 0
 		  *
 		  * @section faGA_P Abstraction function
 		  *
@@ -59,7 +59,6 @@ class GA_P_alg : public Population_alg<GA_P_Expression> {
 		  * represents a set of data with its respective tags
 		  *
 		  * rep.data_
-		  * rep.output_data_
 		  *
 		  * As well as a population of expressions to estimate the data.
 		  *
@@ -78,6 +77,64 @@ class GA_P_alg : public Population_alg<GA_P_Expression> {
 
 		  int inter_niche_selection(const int mom, const std::vector<bool> & chosen) const;
 
+		/**
+		  * @brief Intra-niche crossover: BLX-alpha crossover and GA mutation of the chromosomes.
+		  *
+		  * @param mom First parent
+		  * @param dad Second parent, in the same niche as mom
+		  * @param son1 First child
+		  * @param son2 Second child
+		  * @param parameters Parameters with the probabilities of the operators
+		  * @param generation Current generation, used by the GA mutation
+		  * @param num_generations Total number of generations
+		  *
+		  * @return For each child, true if it is different from its parent
+		  */
+
+		std::pair<bool, bool> breed_intra_niche(const GA_P_Expression & mom, const GA_P_Expression & dad,
+															 GA_P_Expression & son1, GA_P_Expression & son2,
+															 const Parameters & parameters, const int generation,
+															 const int num_generations) const;
+
+		/**
+		  * @brief Inter-niche crossover: GP and BLX-alpha crossover, and GA and GP mutation.
+		  *
+		  * @param mom First parent
+		  * @param dad Second parent
+		  * @param son1 First child
+		  * @param son2 Second child
+		  * @param parameters Parameters with the probabilities of the operators
+		  * @param generation Current generation, used by the GA mutation
+		  * @param num_generations Total number of generations
+		  *
+		  * @return For each child, true if it is different from its parent
+		  */
+
+		std::pair<bool, bool> breed_inter_niche(const GA_P_Expression & mom, const GA_P_Expression & dad,
+															 GA_P_Expression & son1, GA_P_Expression & son2,
+															 const Parameters & parameters, const int generation,
+															 const int num_generations);
+
+		/**
+		  * @brief Generate two children, with the intra-niche crossover if the parents share
+		  * niche and it is chosen with the inter-niche probability, and the inter-niche one if not.
+		  *
+		  * @param mom First parent
+		  * @param dad Second parent
+		  * @param son1 First child
+		  * @param son2 Second child
+		  * @param parameters Parameters with the probabilities of the operators
+		  * @param generation Current generation, used by the GA mutation
+		  * @param num_generations Total number of generations
+		  *
+		  * @return For each child, true if it is different from its parent
+		  */
+
+		std::pair<bool, bool> breed(const GA_P_Expression & mom, const GA_P_Expression & dad,
+											 GA_P_Expression & son1, GA_P_Expression & son2,
+											 const Parameters & parameters, const int generation,
+											 const int num_generations) override;
+
 
 	public:
 
@@ -96,6 +153,20 @@ class GA_P_alg : public Population_alg<GA_P_Expression> {
 		GA_P_alg(const std::vector<std::vector<double> > & data, const std::vector<double> & labels,
 			 			  const unsigned long seed, const unsigned population_size, const unsigned max_depth, const double prob_var);
 
+		/**
+		 *  @brief Contructor with 5 parameters, to use the GA_P_alg given a dataset, shared without copying it
+		 *
+		 *  @param data Data to fit, with their associated tags
+		 *  @param seed Random seed to use
+		 *  @param population_size Number of individuals in the population
+		 *  @param max_depth Maximum depth of expressions used
+		 *  @param prob_var Probability of a Node being a variable
+		 *
+		 */
+
+		GA_P_alg(const Dataset & data, const unsigned long seed, const unsigned population_size,
+				 const unsigned max_depth, const double prob_var);
+
 
 		/**
 		  * @brief Constructor with seven parameters
@@ -131,6 +202,17 @@ class GA_P_alg : public Population_alg<GA_P_Expression> {
 		~GA_P_alg() = default;
 
 
+		using Population_alg<GA_P_Expression>::fit;
+
+		/**
+		 *  @brief Copy the algorithm, with its population and its data
+		 *
+		 *  @return Copy of the algorithm
+		 *
+		 **/
+
+		std::unique_ptr<Population_alg<GA_P_Expression> > clone() const;
+
 		/**
 		 *  @brief Fit the population using the current data with the given parameters
 		 *
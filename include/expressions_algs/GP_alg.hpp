@@ -29,7 +29,6 @@ class GP_alg : public Population_alg<Expression> {
 
 		using Population_alg<Expression>::population_;
 		using Population_alg<Expression>::data_;
-		using Population_alg<Expression>::output_data_;
 		using Population_alg<Expression>::expressions_depth_;
 
 		using Population_alg<Expression>::read_data;
@@ -41,6 +40,23 @@ class GP_alg : public Population_alg<Expression> {
 		using Population_alg<Expression>::apply_elitism;
 		using Population_alg<Expression>::apply_GP_mutations;
 		using Population_alg<Expression>::initialize;
+		using Population_alg<Expression>::evaluate_population;
+
+		/**
+		  * @brief Generate two children with GP crossover and GP mutation.
+		  *
+		  * @param mom First parent
+		  * @param dad Second parent
+		  * @param son1 First child
+		  * @param son2 Second child
+		  * @param parameters Parameters with the probabilities of the operators
+		  *
+		  * @return For each child, true if it is different from its parent
+		  */
+
+		std::pair<bool, bool> breed(const Expression & mom, const Expression & dad,
+											 Expression & son1, Expression & son2,
+											 const Parameters & parameters, const int, const int) override;
 
 
 
@@ -50,14 +66,13 @@ class GP_alg : public Population_alg<Expression> {
 		  *
 		  * @section invPG Representation invariant
 		  *
-		  * The invariant is; data_.size > 0 and output_data.size == data_.size
+		  * The invariant is; data_.get_num_rows > 0
 		  *
 		  * @section faPG Abstraction function
 		  *
 		  * A valid object @e rep of class GP_alg represents a set of data with their respective labels
 		  *
 		  * rep.data_
-		  * rep.output_data_
 		  *
 		  * As well as a population of expressions to estimate the data.
 		  *
@@ -83,6 +98,20 @@ class GP_alg : public Population_alg<Expression> {
 		GP_alg(const std::vector<std::vector<double> > & data, const std::vector<double> & labels,
 						const unsigned long seed, const unsigned population_size, const unsigned depth, const double prob_var);
 
+		/**
+		 *  @brief Contructor with 5 parameters, to use the GP_alg given a dataset, shared without copying it
+		 *
+		 *  @param data Data to fit, with their associated tags
+		 *  @param seed Random seed to use
+		 *  @param population_size Number of individuals in the population
+		 *  @param max_depth Maximum depth of expressions used
+		 *  @param prob_var Probability of a Node being a variable
+		 *
+		 */
+
+		GP_alg(const Dataset & data, const unsigned long seed, const unsigned population_size,
+				 const unsigned max_depth, const double prob_var);
+
 
 		/**
 		  * @brief Constructor with seven parameters
@@ -118,6 +147,17 @@ class GP_alg : public Population_alg<Expression> {
 		~GP_alg();
 
 
+		using Population_alg<Expression>::fit;
+
+		/**
+		 *  @brief Copy the algorithm, with its population and its data
+		 *
+		 *  @return Copy of the algorithm
+		 *
+		 **/
+
+		std::unique_ptr<Population_alg<Expression> > clone() const;
+
 		/**
 		 *  @brief Adjust the population using the current data with the given parameters
 		 *
@@ -0,0 +1,297 @@
+/**
+  * \@file Island_coordinator.hpp
+  * @brief Header file of the Island_coordinator class
+  *
+  */
+
+#ifndef ISLAND_COORDINATOR_H_INCLUDED
+#define ISLAND_COORDINATOR_H_INCLUDED
+
+#include "expressions_algs/Socket_channel.hpp"
+
+#include <random>
+#include <vector>
+
+namespace expressions_algs {
+
+/**
+  * @brief Islands to which each island sends its migrants
+  *
+  */
+
+enum class MigrationTopology {
+	RING,             ///< Island i sends to island i + 1, and the last one to the first one
+	RANDOM,           ///< Each island sends to another island drawn again in every migration
+	FULLY_CONNECTED   ///< Each island sends to all the other islands
+};
+
+/**
+  * @brief Types of the messages exchanged by the coordinator and the islands
+  *
+  */
+
+enum class IslandMessage : std::uint32_t {
+	HELLO = 1,   ///< An island asks to take part, empty payload
+	START,       ///< The coordinator assigns an island, payload from Island_assignment::encode
+	MIGRANTS,    ///< An island finished an epoch and sends its emigrants
+	INBOX,       ///< The coordinator sends to an island the emigrants of its senders
+	RESULT       ///< An island finished and sends the fitness and its best individual
+};
+
+/**
+  * @brief What the coordinator tells an island at the start
+  *
+  */
+
+struct Island_assignment {
+	unsigned island = 0;              ///< Index of the island
+	unsigned num_islands = 1;         ///< Number of islands
+	unsigned long seed = 0;           ///< Seed of the island model
+	unsigned migration_interval = 1;  ///< Generations between two migrations
+	unsigned num_migrants = 0;        ///< Individuals sent by an island in each migration
+	std::string configuration;        ///< Free text given to the coordinator, the same for all the islands
+
+	/**
+	  * @brief Write the assignment in binary form.
+	  *
+	  * @return Payload of a START message.
+	  */
+	std::string encode() const;
+
+	/**
+	  * @brief Read an assignment written with encode.
+	  *
+	  * @param payload Payload of a START message.
+	  *
+	  * @return True if the payload is a valid assignment.
+	  */
+	bool decode(const std::string & payload);
+};
+
+/**
+  *  @brief Island_coordinator Class
+  *
+  *  An instance of type Island_coordinator runs an island model whose islands
+  *  are separate processes, in the same machine or in several ones, connected
+  *  to it through a Socket_channel. Each process sends HELLO and receives in
+  *  START the island it runs, in the order in which they connected, and the
+  *  configuration of the model. At the end of every epoch each island sends
+  *  its emigrants in a MIGRANTS message, and once all of them have arrived the
+  *  coordinator draws the destinations of the topology and sends every island
+  *  an INBOX with the emigrants of its senders, in the order of the senders.
+  *  When all the islands have sent their RESULT the model is finished.
+  *
+  *  The coordinator does not know the type of the individuals: emigrants and
+  *  results are forwarded as bytes. Since the destinations are drawn as
+  *  Island_model draws them and the islands follow its epochs
+  *  (see Island_worker), the result is the same as with an Island_model of
+  *  the same seed.
+  *
+  * @author Antonio David Villegas Yeguas
+  * @date Octubre 2026
+  */
+
+class Island_coordinator {
+	private:
+
+		/**
+		  * @page repIsland_coordinator Representation of the Island_coordinator class
+		  *
+		  * @section invIsland_coordinator Representation invariant
+		  *
+		  * num_islands_ >= 1, migration_interval_ >= 1 and
+		  * results_.size == result_fitness_.size, which is num_islands_ after a successful run
+		  *
+		  * @section faIsland_coordinator Abstraction function
+		  *
+		  * A valid object @e rep of class Island_coordinator represents the coordinator of
+		  * rep.num_islands_ islands that connect to rep.listener_ and exchange
+		  * rep.num_migrants_ individuals every rep.migration_interval_ generations along
+		  * rep.topology_, where the best individual of the island i, in bytes, is
+		  *
+		  * rep.results_[i]
+		  *
+		  * with fitness rep.result_fitness_[i]
+		  *
+		  */
+
+		/**
+		  * @brief Socket where the islands connect
+		  */
+
+		Socket_channel listener_;
+
+		/**
+		  * @brief Number of islands
+		  */
+
+		unsigned num_islands_;
+
+		/**
+		  * @brief Seed of the island model
+		  */
+
+		unsigned long seed_;
+
+		/**
+		  * @brief Generations between two migrations
+		  */
+
+		unsigned migration_interval_;
+
+		/**
+		  * @brief Individuals sent by an island in each migration
+		  */
+
+		unsigned num_migrants_;
+
+		/**
+		  * @brief Islands to which each island sends its migrants
+		  */
+
+		MigrationTopology topology_;
+
+		/**
+		  * @brief Fitness of the best individual of each island in the last run
+		  */
+
+		std::vector<double> result_fitness_;
+
+		/**
+		  * @brief Best individual of each island in the last run, as written by its write method
+		  */
+
+		std::vector<std::string> results_;
+
+		/**
+		  * @brief Number of migrations done in the last run
+		  */
+
+		unsigned num_migrations_;
+
+	public:
+
+		/**
+		  * @brief Constructor with five parameters.
+		  *
+		  * @param num_islands Number of islands.
+		  * @param seed Seed of the islands and of the topology.
+		  * @param migration_interval Generations between two migrations.
+		  * @param num_migrants Individuals sent by an island in each migration.
+		  * @param topology Islands to which each island sends its migrants.
+		  */
+
+		Island_coordinator(const unsigned num_islands, const unsigned long seed,
+								 const unsigned migration_interval = 10, const unsigned num_migrants = 5,
+								 const MigrationTopology topology = MigrationTopology::RING);
+
+		/**
+		  * @brief Start listening for the islands, before starting them.
+		  *
+		  * @param address Address of the socket, see Socket_channel.
+		  *
+		  * @return True if the socket is listening.
+		  */
+
+		bool listen(const std::string & address);
+
+		/**
+		  * @brief Get the address where the islands must connect.
+		  *
+		  * @return Address of the socket, with the real port if it listens on port 0.
+		  */
+
+		const std::string & get_address() const;
+
+		/**
+		  * @brief Wait for all the islands, coordinate their migrations and collect their results.
+		  *
+		  * @param configuration Text sent to all the islands in their assignment.
+		  *
+		  * @pre listen was successful.
+		  *
+		  * @return True if all the islands finished. False if an island disconnected or sent
+		  * an unexpected message, in which case the rest of the islands are disconnected.
+		  */
+
+		bool run(const std::string & configuration = "");
+
+		/**
+		  * @brief Get the number of islands.
+		  *
+		  * @return Number of islands.
+		  */
+
+		unsigned get_num_islands() const;
+
+		/**
+		  * @brief Get the number of migrations done in the last run.
+		  *
+		  * @return Number of migrations.
+		  */
+
+		unsigned get_num_migrations() const;
+
+		/**
+		  * @brief Get the island with the best individual, the first one if several tie.
+		  *
+		  * @pre The last run was successful.
+		  *
+		  * @return Index of the best island.
+		  */
+
+		unsigned get_best_island() const;
+
+		/**
+		  * @brief Get the fitness of the best individual of an island.
+		  *
+		  * @param island Index of the island.
+		  *
+		  * @return Fitness sent by the island.
+		  */
+
+		double get_fitness(const unsigned island) const;
+
+		/**
+		  * @brief Get the best individual of an island, to be read with the read method of its type.
+		  *
+		  * @param island Index of the island.
+		  *
+		  * @return Bytes of the individual.
+		  */
+
+		const std::string & get_result(const unsigned island) const;
+
+		/**
+		  * @brief Connect to a coordinator as an island and wait for the island assigned.
+		  *
+		  * @param address Address of the coordinator, see Socket_channel.
+		  * @param channel Where the connection with the coordinator is stored.
+		  * @param assignment Where the island assigned is stored.
+		  * @param attempts Maximum number of attempts to connect, one every 100 ms.
+		  *
+		  * @return True if an island was assigned.
+		  */
+
+		static bool join(const std::string & address, Socket_channel & channel,
+							  Island_assignment & assignment, const unsigned attempts = 100);
+
+		/**
+		  * @brief Islands to which an island sends its migrants in the next migration.
+		  *
+		  * @param topology Topology of the migrations.
+		  * @param island Sender.
+		  * @param num_islands Number of islands.
+		  * @param generator Generator of the destinations of the random topology.
+		  *
+		  * @return Receivers, in increasing order.
+		  */
+
+		static std::vector<unsigned> destinations(const MigrationTopology topology, const unsigned island,
+																const unsigned num_islands, std::mt19937 & generator);
+
+};
+
+} // namespace expressions_algs
+
+#endif
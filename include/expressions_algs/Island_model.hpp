@@ -0,0 +1,232 @@
+/**
+  * \@file Island_model.hpp
+  * @brief Header file of the Island_model class
+  *
+  */
+
+#ifndef ISLAND_MODEL_H_INCLUDED
+#define ISLAND_MODEL_H_INCLUDED
+
+#include "expressions_algs/Population_alg.hpp"
+#include "expressions_algs/Island_coordinator.hpp"
+
+#include <atomic>
+#include <limits>
+
+namespace expressions_algs {
+
+/**
+  *  @brief Island_model Class
+  *
+  *  An instance of type Island_model evolves several sub-populations (islands)
+  *  of the same algorithm in parallel. Each island is a copy of the given
+  *  algorithm, with its own initial population and its own random generator.
+  *  The islands are trained by epochs of a number of generations. The threads
+  *  are split in groups, one per island trained at the same time, and each
+  *  group is a dedicated Task_scheduler pinned to its own cores, so all the
+  *  parallel loops of an island run on the threads of its group. With more
+  *  islands than groups each group trains its islands one after another. At
+  *  the end of an epoch every island posts copies of its
+  *  best individuals to the mailboxes of the islands of the topology, and at
+  *  the beginning of the next one it replaces its worst individuals by the
+  *  migrants it received.
+  *
+  *  A mailbox has one slot per sender and per parity of the epoch, so posting
+  *  and collecting take no locks: a slot has a single writer, which publishes it
+  *  with an atomic stamp, and it is not written again until every island has
+  *  finished the next epoch. The migrants are collected in the order of the
+  *  senders, so the result only depends on the seed and on the number of
+  *  islands, not on the number of threads.
+  *
+  * @tparam T Type of the individuals of the algorithm
+  *
+  * @author Antonio David Villegas Yeguas
+  * @date Octubre 2026
+  */
+
+template <class T>
+class Island_model {
+	private:
+
+		/**
+		  * @page repIsland_model Representation of the Island_model class
+		  *
+		  * @section invIsland_model Representation invariant
+		  *
+		  * islands_.size == generators_.size >= 1, migration_interval_ >= 1
+		  * and num_migrants_ < the population size of every island
+		  *
+		  * @section faIsland_model Abstraction function
+		  *
+		  * A valid object @e rep of class Island_model represents the islands
+		  *
+		  * *rep.islands_[i]
+		  *
+		  * that exchange rep.num_migrants_ individuals every rep.migration_interval_
+		  * generations along rep.topology_
+		  *
+		  */
+
+		/**
+		  * @brief Migrants sent to an island, one slot per sender and per parity of the epoch
+		  */
+
+		struct Mailbox {
+			/**
+			  * @brief Migrants of each slot, slot = (epoch % 2) * number of islands + sender
+			  */
+			std::vector<std::vector<T> > migrants;
+
+			/**
+			  * @brief Epoch + 1 of the migrants of each slot, 0 if the slot was never written
+			  */
+			std::vector<std::atomic<unsigned> > stamps;
+
+			/**
+			  * @brief Constructor, empty mailbox.
+			  *
+			  * @param num_islands Number of islands that can send migrants.
+			  */
+			explicit Mailbox(const unsigned num_islands);
+
+			/**
+			  * @brief Post the migrants of a sender at the end of an epoch.
+			  *
+			  * @param sender Island that sends the migrants.
+			  * @param epoch Epoch that has just finished.
+			  * @param individuals Migrants.
+			  */
+			void post(const unsigned sender, const unsigned epoch, std::vector<T> individuals);
+
+			/**
+			  * @brief Collect the migrants posted at the end of an epoch, in the order of the senders.
+			  *
+			  * @param epoch Epoch at the end of which the migrants were posted.
+			  *
+			  * @return Migrants of all the senders.
+			  */
+			std::vector<T> collect(const unsigned epoch) const;
+		};
+
+		/**
+		  * @brief Algorithm of each island
+		  */
+
+		std::vector<std::unique_ptr<Population_alg<T> > > islands_;
+
+		/**
+		  * @brief Random generator of each island, kept between epochs
+		  */
+
+		std::vector<std::mt19937> generators_;
+
+		/**
+		  * @brief Generator of the destinations of the random topology
+		  */
+
+		std::mt19937 topology_generator_;
+
+		/**
+		  * @brief Generations between two migrations
+		  */
+
+		unsigned migration_interval_;
+
+		/**
+		  * @brief Individuals sent by an island in each migration
+		  */
+
+		unsigned num_migrants_;
+
+		/**
+		  * @brief Islands to which each island sends its migrants
+		  */
+
+		MigrationTopology topology_;
+
+		/**
+		  * @brief Number of migrations done in the last fit
+		  */
+
+		unsigned num_migrations_;
+
+	public:
+
+		/**
+		  * @brief Constructor with six parameters. The first island keeps the population of
+		  * the given algorithm and the rest generate a new one of the same size.
+		  *
+		  * @param algorithm Algorithm with the training data, copied for every island.
+		  * @param num_islands Number of islands.
+		  * @param seed Seed of the random generators of the islands and of the topology.
+		  * @param migration_interval Generations between two migrations.
+		  * @param num_migrants Individuals sent by an island in each migration.
+		  * @param topology Islands to which each island sends its migrants.
+		  */
+
+		Island_model(const Population_alg<T> & algorithm, const unsigned num_islands,
+						 const unsigned long seed, const unsigned migration_interval = 10,
+						 const unsigned num_migrants = 5,
+						 const MigrationTopology topology = MigrationTopology::RING);
+
+		/**
+		  * @brief Fit all the islands. The evaluations of the parameters are split evenly
+		  * between the islands, so the total budget is the same as with a single algorithm.
+		  *
+		  * @param parameters Parameters of every island.
+		  * @param num_threads Number of threads of all the groups of the islands. The calling
+		  * thread only waits.
+		  */
+
+		void fit(const Parameters & parameters,
+					const unsigned num_threads = Evaluation_scheduler::available_threads());
+
+		/**
+		  * @brief Get the island with the best individual, the first one if several tie.
+		  *
+		  * @return Index of the best island.
+		  */
+
+		unsigned get_best_island() const;
+
+		/**
+		  * @brief Get the best individual of all the islands.
+		  *
+		  * @return Best individual.
+		  */
+
+		T get_best_individual() const;
+
+		/**
+		  * @brief Get the algorithm of an island.
+		  *
+		  * @param island Index of the island.
+		  *
+		  * @return Algorithm of the island.
+		  */
+
+		const Population_alg<T> & get_island(const unsigned island) const;
+
+		/**
+		  * @brief Get the number of islands.
+		  *
+		  * @return Number of islands.
+		  */
+
+		unsigned get_num_islands() const;
+
+		/**
+		  * @brief Get the number of migrations done in the last fit.
+		  *
+		  * @return Number of migrations.
+		  */
+
+		unsigned get_num_migrations() const;
+
+};
+
+} // namespace expressions_algs
+
+#include "expressions_algs/Island_model.tpp"
+
+#endif
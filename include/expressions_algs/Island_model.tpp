@@ -0,0 +1,196 @@
+
+namespace expressions_algs {
+
+template <class T>
+Island_model<T>::Mailbox :: Mailbox(const unsigned num_islands)
+	:migrants(2 * num_islands), stamps(2 * num_islands)
+{
+	for ( unsigned i = 0; i < stamps.size(); i++) {
+		stamps[i].store(0);
+	}
+}
+
+template <class T>
+void Island_model<T>::Mailbox :: post(const unsigned sender, const unsigned epoch, std::vector<T> individuals) {
+	const unsigned casilla = (epoch % 2) * (migrants.size() / 2) + sender;
+
+	// cada casilla tiene un solo escritor, el sello publica los emigrantes sin cerrojos
+	migrants[casilla] = std::move(individuals);
+	stamps[casilla].store(epoch + 1, std::memory_order_release);
+}
+
+template <class T>
+std::vector<T> Island_model<T>::Mailbox :: collect(const unsigned epoch) const {
+	const unsigned num_islas = migrants.size() / 2;
+	std::vector<T> resultado;
+
+	// en el orden de los emisores, asi los inmigrantes no dependen de que isla termino antes
+	for ( unsigned emisor = 0; emisor < num_islas; emisor++) {
+		const unsigned casilla = (epoch % 2) * num_islas + emisor;
+
+		if ( stamps[casilla].load(std::memory_order_acquire) == epoch + 1 ) {
+			resultado.insert(resultado.end(), migrants[casilla].begin(), migrants[casilla].end());
+		}
+	}
+
+	return resultado;
+}
+
+template <class T>
+Island_model<T> :: Island_model(const Population_alg<T> & algorithm, const unsigned num_islands,
+										  const unsigned long seed, const unsigned migration_interval,
+										  const unsigned num_migrants, const MigrationTopology topology)
+	:topology_generator_(Fold_executor::fold_seed(seed, std::max(num_islands, 1u))),
+	 migration_interval_(std::max(migration_interval, 1u)),
+	 num_migrants_(std::min(num_migrants, std::max(algorithm.get_population_size(), 1u) - 1)),
+	 topology_(topology), num_migrations_(0)
+{
+
+	const unsigned num_islas = std::max(num_islands, 1u);
+
+	for ( unsigned i = 0; i < num_islas; i++) {
+		islands_.push_back(algorithm.clone());
+		generators_.emplace_back(Fold_executor::fold_seed(seed, i));
+	}
+
+	// la primera isla conserva la poblacion del algoritmo, las demas generan la suya con su generador
+	const std::mt19937 generador = Random::get_generator();
+
+	for ( unsigned i = 1; i < num_islas; i++) {
+		Random::set_generator(generators_[i]);
+		islands_[i]->regenerate_population(algorithm.get_population_size());
+		generators_[i] = Random::get_generator();
+	}
+
+	Random::set_generator(generador);
+
+}
+
+template <class T>
+void Island_model<T> :: fit(const Parameters & parameters, const unsigned num_threads) {
+
+	const unsigned num_islas = islands_.size();
+	const long evaluaciones_isla = parameters.get_num_evaluations() / num_islas;
+	const long evaluaciones_epoca = static_cast<long>(migration_interval_) * islands_.front()->get_population_size();
+	const unsigned num_epocas = std::max((evaluaciones_isla + evaluaciones_epoca - 1) / std::max(evaluaciones_epoca, 1L), 1L);
+
+	// buzones nuevos en cada ajuste, para que no queden sellos de un ajuste anterior
+	std::vector<std::unique_ptr<Mailbox> > buzones;
+
+	for ( unsigned i = 0; i < num_islas; i++) {
+		buzones.push_back(std::make_unique<Mailbox>(num_islas));
+	}
+
+	num_migrations_ = 0;
+
+	// un pool dedicado de hebras, fijado a sus nucleos, por cada isla que se ajusta a la vez; los
+	// bucles paralelos de una isla solo usan las hebras de su pool
+	const unsigned num_grupos = std::max(std::min(num_islas, num_threads), 1u);
+	std::vector<std::unique_ptr<Task_scheduler> > grupos;
+
+	for ( unsigned g = 0; g < num_grupos; g++) {
+		const unsigned hebras = num_threads / num_grupos + ( g < num_threads % num_grupos ? 1 : 0 );
+
+		grupos.push_back(std::make_unique<Task_scheduler>(std::max(hebras, 1u), Task_scheduler::reserve_cores(hebras)));
+	}
+
+	for ( unsigned epoca = 0; epoca < num_epocas; epoca++) {
+		const long presupuesto = std::min(evaluaciones_epoca, evaluaciones_isla - epoca * evaluaciones_epoca);
+		const bool migrar = epoca + 1 < num_epocas && num_migrants_ > 0 && num_islas > 1;
+
+		// los destinos se sortean antes de la epoca y en el orden de las islas
+		std::vector<std::vector<unsigned> > destinos (num_islas);
+
+		for ( unsigned i = 0; i < num_islas && migrar; i++) {
+			destinos[i] = Island_coordinator::destinations(topology_, i, num_islas, topology_generator_);
+		}
+
+		const auto ajustar_isla = [&](const unsigned i) {
+			Random::set_generator(generators_[i]);
+
+			if ( epoca > 0 ) {
+				const std::vector<T> inmigrantes = buzones[i]->collect(epoca - 1);
+
+				if ( !inmigrantes.empty() ) {
+					islands_[i]->receive_migrants(inmigrantes);
+				}
+			}
+
+			Parameters parametros = parameters;
+			parametros.set_num_evaluations(presupuesto);
+
+			islands_[i]->fit(parametros);
+
+			if ( migrar ) {
+				const std::vector<T> emigrantes = islands_[i]->get_best_individuals(num_migrants_);
+
+				for ( unsigned d = 0; d < destinos[i].size(); d++) {
+					buzones[destinos[i][d]]->post(i, epoca, emigrantes);
+				}
+			}
+
+			generators_[i] = Random::get_generator();
+		};
+
+		// cada grupo ajusta sus islas una tras otra, la hebra actual solo espera
+		std::vector<std::unique_ptr<Task_group> > tareas;
+
+		for ( unsigned g = 0; g < num_grupos; g++) {
+			tareas.push_back(std::make_unique<Task_group>(*grupos[g]));
+
+			tareas.back()->run([&ajustar_isla, g, num_grupos, num_islas]() {
+				for ( unsigned i = g; i < num_islas; i += num_grupos) {
+					ajustar_isla(i);
+				}
+			});
+		}
+
+		for ( unsigned g = 0; g < num_grupos; g++) {
+			tareas[g]->wait();
+		}
+
+		if ( migrar ) {
+			num_migrations_++;
+		}
+	}
+
+}
+
+template <class T>
+unsigned Island_model<T> :: get_best_island() const {
+	unsigned mejor = 0;
+
+	for ( unsigned i = 1; i < islands_.size(); i++) {
+		const double fitness = islands_[i]->get_best_individual().get_fitness();
+		const double fitness_mejor = islands_[mejor]->get_best_individual().get_fitness();
+
+		// un NaN nunca es el mejor, a igual fitness se queda la primera isla
+		if ( !std::isnan(fitness) && ( std::isnan(fitness_mejor) || fitness < fitness_mejor ) ) {
+			mejor = i;
+		}
+	}
+
+	return mejor;
+}
+
+template <class T>
+T Island_model<T> :: get_best_individual() const {
+	return islands_[get_best_island()]->get_best_individual();
+}
+
+template <class T>
+const Population_alg<T> & Island_model<T> :: get_island(const unsigned island) const {
+	return *islands_[island];
+}
+
+template <class T>
+unsigned Island_model<T> :: get_num_islands() const {
+	return islands_.size();
+}
+
+template <class T>
+unsigned Island_model<T> :: get_num_migrations() const {
+	return num_migrations_;
+}
+
+} // namespace expressions_algs
@@ -0,0 +1,162 @@
+/**
+  * \@file Island_worker.hpp
+  * @brief Header file of the Island_worker class
+  *
+  */
+
+#ifndef ISLAND_WORKER_H_INCLUDED
+#define ISLAND_WORKER_H_INCLUDED
+
+#include "expressions_algs/Population_alg.hpp"
+#include "expressions_algs/Island_coordinator.hpp"
+
+namespace expressions_algs {
+
+/**
+  *  @brief Island_worker Class
+  *
+  *  An instance of type Island_worker runs one island of an island model
+  *  coordinated by an Island_coordinator, usually in its own process. It
+  *  connects to the coordinator, which assigns the island, and then fits the
+  *  algorithm of the island by epochs as Island_model does: the island keeps
+  *  the population of the algorithm if it is the first one and generates a
+  *  new one with its own generator otherwise, and at the end of every epoch
+  *  it sends its best individuals to the coordinator and waits for the
+  *  migrants of its senders, which replace its worst individuals.
+  *
+  *  The individuals travel in the binary form of their write and read
+  *  methods, so T must provide both.
+  *
+  * @tparam T Type of the individuals of the algorithm
+  *
+  * @author Antonio David Villegas Yeguas
+  * @date Octubre 2026
+  */
+
+template <class T>
+class Island_worker {
+	private:
+
+		/**
+		  * @page repIsland_worker Representation of the Island_worker class
+		  *
+		  * @section invIsland_worker Representation invariant
+		  *
+		  * assignment_.island < assignment_.num_islands once connected
+		  *
+		  * @section faIsland_worker Abstraction function
+		  *
+		  * A valid object @e rep of class Island_worker represents the island
+		  * rep.assignment_.island of an island model, connected to its coordinator through
+		  *
+		  * rep.channel_
+		  *
+		  */
+
+		/**
+		  * @brief Connection with the coordinator
+		  */
+
+		Socket_channel channel_;
+
+		/**
+		  * @brief Island assigned by the coordinator
+		  */
+
+		Island_assignment assignment_;
+
+		/**
+		  * @brief Number of migrations done in the last fit
+		  */
+
+		unsigned num_migrations_;
+
+	public:
+
+		/**
+		  * @brief Default constructor, not connected.
+		  */
+
+		Island_worker();
+
+		/**
+		  * @brief Constructor with two parameters, for an island already assigned with
+		  * Island_coordinator::join.
+		  *
+		  * @param channel Connection with the coordinator.
+		  * @param assignment Island assigned by the coordinator.
+		  */
+
+		Island_worker(Socket_channel && channel, const Island_assignment & assignment);
+
+		/**
+		  * @brief Connect to the coordinator and wait for the island assigned to this worker.
+		  *
+		  * @param address Address of the coordinator, see Socket_channel.
+		  * @param attempts Maximum number of attempts to connect, one every 100 ms.
+		  *
+		  * @return True if an island was assigned.
+		  */
+
+		bool connect(const std::string & address, const unsigned attempts = 100);
+
+		/**
+		  * @brief Get the island assigned by the coordinator, with the configuration of the model.
+		  *
+		  * @return Assignment received in connect.
+		  */
+
+		const Island_assignment & get_assignment() const;
+
+		/**
+		  * @brief Fit the island and send its best individual to the coordinator. The
+		  * evaluations of the parameters are split evenly between the islands, as in
+		  * Island_model. The random generator of the calling thread is the same after the fit.
+		  *
+		  * @param algorithm Algorithm of the island, built in every island in the same way.
+		  * @param parameters Parameters of every island.
+		  *
+		  * @pre connect was successful.
+		  *
+		  * @return True if the island finished, false if the connection with the coordinator was lost.
+		  */
+
+		bool fit(Population_alg<T> & algorithm, const Parameters & parameters);
+
+		/**
+		  * @brief Get the number of migrations done in the last fit.
+		  *
+		  * @return Number of migrations.
+		  */
+
+		unsigned get_num_migrations() const;
+
+		/**
+		  * @brief Write some individuals in binary form.
+		  *
+		  * @param individuals Individuals to write.
+		  *
+		  * @return Number of individuals followed by each one of them.
+		  */
+
+		static std::string encode(const std::vector<T> & individuals);
+
+		/**
+		  * @brief Read some individuals written with encode, appending them to a vector.
+		  * The random generator of the calling thread is the same after the call.
+		  *
+		  * @param bytes Individuals in binary form.
+		  * @param individuals Vector where the individuals are appended.
+		  *
+		  * @return True if all the individuals were read.
+		  */
+
+		static bool decode(const std::string & bytes, std::vector<T> & individuals);
+
+};
+
+} // namespace expressions_algs
+
+#include "expressions_algs/Island_worker.tpp"
+
+#endif
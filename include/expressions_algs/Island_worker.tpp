@@ -0,0 +1,153 @@
+
+namespace expressions_algs {
+
+template <class T>
+Island_worker<T> :: Island_worker()
+	:num_migrations_(0)
+{
+}
+
+template <class T>
+Island_worker<T> :: Island_worker(Socket_channel && channel, const Island_assignment & assignment)
+	:channel_(std::move(channel)), assignment_(assignment), num_migrations_(0)
+{
+}
+
+template <class T>
+bool Island_worker<T> :: connect(const std::string & address, const unsigned attempts) {
+	return Island_coordinator::join(address, channel_, assignment_, attempts);
+}
+
+template <class T>
+const Island_assignment & Island_worker<T> :: get_assignment() const {
+	return assignment_;
+}
+
+template <class T>
+bool Island_worker<T> :: fit(Population_alg<T> & algorithm, const Parameters & parameters) {
+
+	const std::mt19937 generador_llamada = Random::get_generator();
+
+	const unsigned isla = assignment_.island;
+	const unsigned num_islas = assignment_.num_islands;
+	const unsigned tam_poblacion = algorithm.get_population_size();
+	const unsigned num_emigrantes = std::min(assignment_.num_migrants, std::max(tam_poblacion, 1u) - 1);
+
+	// el mismo generador y la misma poblacion inicial que la isla de Island_model
+	Random::set_generator(std::mt19937(Fold_executor::fold_seed(assignment_.seed, isla)));
+
+	if ( isla > 0 ) {
+		algorithm.regenerate_population(tam_poblacion);
+	}
+
+	const long evaluaciones_isla = parameters.get_num_evaluations() / num_islas;
+	const long evaluaciones_epoca = static_cast<long>(assignment_.migration_interval) * tam_poblacion;
+	const unsigned num_epocas = std::max((evaluaciones_isla + evaluaciones_epoca - 1) / std::max(evaluaciones_epoca, 1L), 1L);
+
+	std::vector<T> inmigrantes;
+	std::uint32_t tipo = 0;
+	std::string mensaje;
+	bool correcto = true;
+
+	num_migrations_ = 0;
+
+	for ( unsigned epoca = 0; epoca < num_epocas && correcto; epoca++) {
+		const long presupuesto = std::min(evaluaciones_epoca, evaluaciones_isla - epoca * evaluaciones_epoca);
+		const bool migrar = epoca + 1 < num_epocas && num_emigrantes > 0 && num_islas > 1;
+
+		if ( !inmigrantes.empty() ) {
+			algorithm.receive_migrants(inmigrantes);
+			inmigrantes.clear();
+		}
+
+		Parameters parametros = parameters;
+		parametros.set_num_evaluations(presupuesto);
+
+		algorithm.fit(parametros);
+
+		if ( migrar ) {
+			// el coordinador espera a todas las islas y devuelve los emigrantes de los remitentes
+			correcto = channel_.send(static_cast<std::uint32_t>(IslandMessage::MIGRANTS),
+											 encode(algorithm.get_best_individuals(num_emigrantes))) &&
+						  channel_.receive(tipo, mensaje) && tipo == static_cast<std::uint32_t>(IslandMessage::INBOX);
+
+			std::istringstream buzon (mensaje);
+			std::uint32_t num_remitentes = 0;
+
+			correcto = correcto && aux::read_binary(buzon, num_remitentes);
+
+			for ( std::uint32_t r = 0; r < num_remitentes && correcto; r++) {
+				std::uint64_t longitud = 0;
+				correcto = aux::read_binary(buzon, longitud) && longitud <= mensaje.size();
+
+				if ( correcto ) {
+					std::string emigrantes (longitud, '\0');
+					correcto = static_cast<bool>(buzon.read(&emigrantes[0], longitud)) &&
+								  decode(emigrantes, inmigrantes);
+				}
+			}
+
+			num_migrations_++;
+		}
+	}
+
+	if ( correcto ) {
+		const T mejor = algorithm.get_best_individual();
+		std::ostringstream resultado;
+
+		aux::write_binary(resultado, mejor.get_fitness());
+		mejor.write(resultado);
+
+		correcto = channel_.send(static_cast<std::uint32_t>(IslandMessage::RESULT), resultado.str());
+	}
+
+	channel_.close();
+	Random::set_generator(generador_llamada);
+
+	return correcto;
+}
+
+template <class T>
+unsigned Island_worker<T> :: get_num_migrations() const {
+	return num_migrations_;
+}
+
+template <class T>
+std::string Island_worker<T> :: encode(const std::vector<T> & individuals) {
+	std::ostringstream salida;
+
+	aux::write_binary(salida, static_cast<std::uint32_t>(individuals.size()));
+
+	for ( const T & individuo : individuals ) {
+		individuo.write(salida);
+	}
+
+	return salida.str();
+}
+
+template <class T>
+bool Island_worker<T> :: decode(const std::string & bytes, std::vector<T> & individuals) {
+	std::istringstream entrada (bytes);
+	std::uint32_t num_individuos = 0;
+
+	// el constructor por defecto puede usar el generador (GA_P_Expression sortea su cromosoma),
+	// se restaura para que leer los inmigrantes no cambie la evolucion de la isla
+	const std::mt19937 generador = Random::get_generator();
+
+	bool correcto = aux::read_binary(entrada, num_individuos);
+
+	for ( std::uint32_t i = 0; i < num_individuos && correcto; i++) {
+		T individuo;
+		correcto = individuo.read(entrada);
+
+		if ( correcto ) {
+			individuals.push_back(std::move(individuo));
+		}
+	}
+
+	Random::set_generator(generador);
+
+	return correcto;
+}
+
+} // namespace expressions_algs
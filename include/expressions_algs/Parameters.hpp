@@ -42,6 +42,14 @@ class Parameters {
 		  * rep.ga_mutation_probability_
 		  * rep.tournament_size_
 		  * rep.show_evolution_
+		  * rep.racing_sample_size_
+		  * rep.racing_top_quantile_
+		  * rep.racing_confidence_
+		  * rep.use_surrogate_
+		  * rep.surrogate_exploration_fraction_
+		  * rep.steady_state_
+		  * rep.pipelined_
+		  * rep.pipeline_ready_fraction_
 		  *
 		  */
 
@@ -132,6 +140,70 @@ class Parameters {
 
  		 std::vector<aux::eval_function_t> eval_error_functions_;
 
+		/**
+		 *
+		 * @brief Number of rows of the stratified sample used to race the offspring. 0 disables racing.
+		 *
+		 */
+
+		unsigned racing_sample_size_;
+
+		/**
+		 *
+		 * @brief Quantile of the population fitness that an offspring has to reach to be fully evaluated.
+		 *
+		 */
+
+		double racing_top_quantile_;
+
+		/**
+		 *
+		 * @brief Number of standard errors used as the confidence interval of the racing estimation.
+		 *
+		 */
+
+		double racing_confidence_;
+
+		/**
+		 *
+		 * @brief Boolean to control whether a surrogate model skips the evaluation of likely poor offspring.
+		 *
+		 */
+
+		bool use_surrogate_;
+
+		/**
+		 *
+		 * @brief Fraction of the offspring predicted as poor that are evaluated anyway.
+		 *
+		 */
+
+		double surrogate_exploration_fraction_;
+
+		/**
+		 *
+		 * @brief Boolean to control whether the algorithm evolves in steady state instead of by generations.
+		 *
+		 */
+
+		bool steady_state_;
+
+		/**
+		 *
+		 * @brief Boolean to control whether the generations are pipelined, breeding a generation while the previous one is evaluated.
+		 *
+		 */
+
+		bool pipelined_;
+
+		/**
+		 *
+		 * @brief Fraction of a generation that must be evaluated before the next one starts its selection.
+		 *
+		 */
+
+		double pipeline_ready_fraction_;
+
 	public:
 
 		/**
@@ -187,6 +259,13 @@ class Parameters {
 
 		int get_num_evaluations() const;
 
+		/**
+		 *  @brief Set the number of evaluations with which fit
+		 *  @param num_evaluations Number of evaluations with which you fit
+		 */
+
+		void set_num_evaluations(const int num_evaluations);
+
 		/**
 		 *  @brief Obtain the probability of crossing the GP
 		 *  @return Probability of crossing the GP
@@ -264,6 +343,99 @@ class Parameters {
 
 		unsigned get_num_evaluation_functions() const;
 
+		/**
+		 *  @brief Enable the racing of the offspring on a small stratified sample of the data.
+		 *
+		 *  @param sample_size Number of rows of the sample. 0 disables racing.
+		 *  @param top_quantile Quantile of the population fitness an offspring has to reach to be fully evaluated.
+		 *  @param confidence Number of standard errors of the confidence interval of the estimation.
+		 *
+		 */
+
+		void set_racing(const unsigned sample_size, const double top_quantile = 0.25,
+							 const double confidence = 2.0);
+
+		/**
+		 *  @brief Get the number of rows of the racing sample
+		 *  @return Number of rows of the racing sample, 0 if racing is disabled
+		 */
+		unsigned get_racing_sample_size() const;
+
+		/**
+		 *  @brief Get the quantile an offspring has to reach to be fully evaluated
+		 *  @return Racing quantile
+		 */
+		double get_racing_top_quantile() const;
+
+		/**
+		 *  @brief Get the number of standard errors of the racing confidence interval
+		 *  @return Racing confidence
+		 */
+		double get_racing_confidence() const;
+
+		/**
+		 *  @brief Enable the fitness surrogate that skips the evaluation of offspring predicted
+		 *  to be clearly worse than the tournament threshold.
+		 *
+		 *  @param use_surrogate True to enable the surrogate.
+		 *  @param exploration_fraction Fraction of the skipped offspring that are evaluated anyway.
+		 *
+		 */
+
+		void set_surrogate(const bool use_surrogate, const double exploration_fraction = 0.1);
+
+		/**
+		 *  @brief Get if the fitness surrogate is used
+		 *  @return Boolean: true if the surrogate is used
+		 */
+		bool get_use_surrogate() const;
+
+		/**
+		 *  @brief Get the fraction of the offspring predicted as poor that are evaluated anyway
+		 *  @return Exploration fraction of the surrogate
+		 */
+		double get_surrogate_exploration_fraction() const;
+
+		/**
+		 *  @brief Enable the steady-state evolution, where each thread breeds, evaluates and
+		 *  inserts offspring without waiting for the rest of a generation.
+		 *
+		 *  @param steady_state True to evolve in steady state.
+		 *
+		 */
+
+		void set_steady_state(const bool steady_state);
+
+		/**
+		 *  @brief Get if the algorithm evolves in steady state
+		 *  @return Boolean: true if the evolution is steady state, false if it is by generations
+		 */
+		bool get_steady_state() const;
+
+		/**
+		 *  @brief Enable the pipelined generations, where the offspring are evaluated as soon as
+		 *  they are bred and the selection of the next generation starts once a fraction of the
+		 *  current one has been evaluated.
+		 *
+		 *  @param pipelined True to pipeline the generations.
+		 *  @param ready_fraction Fraction of a generation, in (0, 1], evaluated before the next one starts.
+		 *
+		 */
+
+		void set_pipelined(const bool pipelined, const double ready_fraction = 0.5);
+
+		/**
+		 *  @brief Get if the generations are pipelined
+		 *  @return Boolean: true if the generations are pipelined
+		 */
+		bool get_pipelined() const;
+
+		/**
+		 *  @brief Get the fraction of a generation evaluated before the next one starts its selection
+		 *  @return Ready fraction of the pipeline
+		 */
+		double get_pipeline_ready_fraction() const;
+
 };
 
 }
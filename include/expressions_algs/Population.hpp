@@ -9,6 +9,11 @@
 
 #include "expressions_algs/Expression.hpp"
 #include "expressions_algs/GA_P_Expression.hpp"
+#include "expressions_algs/Racing_evaluator.hpp"
+#include "expressions_algs/Evaluation_scheduler.hpp"
+#include "expressions_algs/Work_stealing_queue.hpp"
+#include "expressions_algs/Fold_executor.hpp"
+#include "expressions_algs/Task_scheduler.hpp"
 
 namespace expressions_algs {
 
@@ -86,8 +91,185 @@ class Population{
 
 		double fitness_sum() const;
 
+		/**
+		  * @brief Evaluar los individuos dados por bloques de filas que caben en caché.
+		  * Los bloques se recorren uno tras otro y todas las hebras evalúan a la vez el
+		  * mismo bloque, cada una con su grupo de individuos, así cada bloque se lee de
+		  * memoria una sola vez, acumulando el error parcial de cada individuo. Si los
+		  * datos están proyectados se recorren por ventanas, adelantando la lectura de
+		  * la siguiente ventana y liberando la memoria de las ya recorridas. Con menos
+		  * individuos que hebras las hebras se reparten los bloques de cada ventana y
+		  * el error se acumula después en el orden de las filas.
+		  *
+		  * @param individuos Indices de los individuos a evaluar
+		  * @param data Datos con los que se evaluarán los individuos
+		  * @param labels Valores correspondientes a los data dados
+		  * @param metrica Función de evaluación acumulada por filas (ver aux::Mean_squared_error)
+		  * @param plan Plan de evaluación con el número de hebras
+		  * @param filas_bloque Número de filas de cada bloque
+		  *
+		  * @tparam Metric Tipo de la métrica, con init, accumulate, combine y finalize
+		  *
+		  * @pre Ninguno de los individuos es una expresión vacía
+		  */
+
+		/**
+		  * @brief Evaluar los individuos dados por teselas (individuo, bloque de filas)
+		  * repartidas entre las hebras según el plan, de mayor a menor coste desde una
+		  * cola con robo de tareas. Con el eje de individuos cada individuo se evalúa
+		  * entero, con los otros ejes se guardan sus predicciones.
+		  *
+		  * @param individuos Indices de los individuos a evaluar
+		  * @param data Datos con los que se evaluarán los individuos
+		  * @param plan Plan de evaluación con el eje, el número de bloques y de hebras
+		  * @param evaluar Función que evalúa un individuo completo, vacío o no
+		  * @param finalizar Función que obtiene el fitness de un individuo a partir de
+		  * sus predicciones en todas las filas
+		  *
+		  * @tparam Evaluate Tipo de evaluar, llamado con un T &
+		  * @tparam Finalize Tipo de finalizar, llamado con un std::vector<double>
+		  */
+
+		template <class Evaluate, class Finalize>
+		void evaluate_individuals_tiles(const std::vector<unsigned> & individuos,
+												  const Dataset & data,
+												  const Evaluation_scheduler & plan,
+												  Evaluate evaluar,
+												  Finalize finalizar);
+
+		template <class Metric>
+		void evaluate_individuals_blocked(const std::vector<unsigned> & individuos,
+													 const Dataset & data,
+													 const std::vector<double> & labels,
+													 const Metric & metrica,
+													 const Evaluation_scheduler & plan,
+													 const unsigned filas_bloque);
+
+		/**
+		  * @brief Candidato a mejor individuo, usado para buscar el mejor
+		  * individuo con una reducción en paralelo.
+		  */
+
+		struct Candidato_mejor {
+			/**
+			  * @brief Indice del individuo, -1 si no hay candidato
+			  */
+			int indice = -1;
+
+			/**
+			  * @brief Indica si el individuo está evaluado con todos los datos
+			  */
+			bool evaluado = false;
+
+			/**
+			  * @brief Fitness del individuo
+			  */
+			double fitness = std::numeric_limits<double>::infinity();
+
+			/**
+			  * @brief Elegir el mejor de dos candidatos. Se prefieren los evaluados,
+			  * después el menor fitness (NaN es el peor) y por último el menor indice,
+			  * de forma que el resultado no depende del orden de la reducción.
+			  *
+			  * @param a Primer candidato
+			  * @param b Segundo candidato
+			  *
+			  * @return El mejor de los dos candidatos
+			  */
+			static Candidato_mejor mejor(const Candidato_mejor & a, const Candidato_mejor & b);
+
+			/**
+			  * @brief Comprobar si un candidato es mejor que otro, con el mismo criterio que mejor.
+			  *
+			  * @param a Primer candidato
+			  * @param b Segundo candidato
+			  *
+			  * @return True si a es mejor que b
+			  */
+			static bool es_mejor(const Candidato_mejor & a, const Candidato_mejor & b);
+		};
+
+		/**
+		  * @brief Élite de la población: los mejores individuos hasta una capacidad
+		  * dada, en un montículo con el peor de ellos en la cima. Insertar un candidato
+		  * cuesta O(log capacidad), por lo que la élite se mantiene sin ordenar la
+		  * población. Se usa también como reducción en paralelo.
+		  */
+
+		struct Elite {
+			/**
+			  * @brief Número máximo de candidatos de la élite
+			  */
+			unsigned capacidad;
+
+			/**
+			  * @brief Candidatos de la élite, montículo con el peor en la cima
+			  */
+			std::vector<Candidato_mejor> candidatos;
+
+			/**
+			  * @brief Constructor, élite vacía.
+			  *
+			  * @param capacidad Número máximo de candidatos de la élite
+			  */
+			explicit Elite(const unsigned capacidad = 1);
+
+			/**
+			  * @brief Ofrecer un candidato a la élite, entra si hay sitio o si es
+			  * mejor que el peor de la élite, que sale.
+			  *
+			  * @param candidato Candidato a insertar
+			  */
+			void insertar(const Candidato_mejor & candidato);
+
+			/**
+			  * @brief Añadir los candidatos de otra élite a esta.
+			  *
+			  * @param otra Élite a combinar con esta
+			  */
+			void combinar(const Elite & otra);
+
+			/**
+			  * @brief Obtener los indices de los candidatos, del mejor al peor.
+			  *
+			  * @return Indices de los individuos de la élite
+			  */
+			std::vector<int> indices() const;
+		};
+
+		/**
+		  * @brief Mejores individuos de la población, se actualiza al buscar el mejor
+		  * individuo y al insertar
+		  */
+
+		Elite elite_;
+
+		/**
+		  * @brief Candidato a mejor individuo de un individuo de la población.
+		  *
+		  * @param indice Indice del individuo
+		  *
+		  * @return Candidato con el fitness del individuo
+		  */
+
+		Candidato_mejor candidato(const unsigned indice) const;
+
 	public:
 
+		/**
+		  * @brief Número de individuos que se generan con la misma secuencia de aleatorios
+		  * al construir una población aleatoria
+		  */
+
+		static const unsigned INIT_BLOCK_SIZE = 64;
+
+		/**
+		  * @brief Mínimo número de individuos que recorre cada tarea al buscar la élite,
+		  * con menos individuos la búsqueda es secuencial
+		  */
+
+		static const unsigned SEARCH_GRAIN = 1000;
+
 		/**
 		  * @brief Constructor con sin parameters, generamos una poblacion vacia.
 		  *
@@ -104,6 +286,15 @@ class Population{
 
 		Population(const Population & otra);
 
+		/**
+		  * @brief Constructor de movimiento. Se queda con los individuos de otra sin copiarlos.
+		  *
+		  * @param otra Population a mover, queda vacía.
+		  *
+		  */
+
+		Population(Population && otra) noexcept;
+
 
 
 
@@ -120,6 +311,10 @@ class Population{
 		  * @param prof_expre Profundidad máxima de las expresiones de
 		  * la población
 		  *
+		  * Los individuos se generan en paralelo por bloques de INIT_BLOCK_SIZE, cada
+		  * bloque con su propia semilla obtenida del generador de la hebra actual, por
+		  * lo que la población es la misma con cualquier número de hebras.
+		  *
 		  */
 
 
@@ -205,10 +400,132 @@ class Population{
 		  *
 		  */
 
-		void evaluate_population(const std::vector<std::vector<double> > & data,
+		void evaluate_population(const Dataset & data,
 									 const std::vector<double> & labels,
 								 	 aux::eval_function_t funcion_evaluacion);
 
+		/**
+		  * @brief Evaluar todos los elementos de la población con una métrica que se
+		  * acumula fila a fila, sin guardar las predicciones (ver evaluate_individuals).
+		  *
+		  * @param data Datos con los que se evaluará la población
+		  * @param labels Valores correspondientes a los data dados
+		  * @param metrica Métrica a utilizar
+		  *
+		  * @tparam Metric Tipo de la métrica, con init, accumulate, combine y finalize
+		  * como aux::Mean_squared_error
+		  *
+		  * @pre data.size == labels.size
+		  *
+		  * @post El mejor individuo de la población se vera actualizado.
+		  *
+		  */
+
+		template <class Metric>
+		void evaluate_population(const Dataset & data,
+									 const std::vector<double> & labels,
+								 	 const Metric & metrica);
+
+		/**
+		  * @brief Evaluar los elementos de la población compitiendo antes sobre una
+		  * muestra de los datos. Solo los individuos cuya estimación alcanza el cuantil
+		  * superior de la población se evaluan con todos los datos, el resto se quedan
+		  * con su fitness estimado.
+		  *
+		  * @param data Datos con los que se evaluará la población
+		  * @param labels Valores correspondientes a los data dados
+		  * @param funcion_evaluacion Funcion de evaluación a utilizar
+		  * @param racing Evaluador con la muestra de los datos
+		  *
+		  * @pre data.size == labels.size
+		  *
+		  * @post El mejor individuo de la población, de entre los evaluados, se vera actualizado.
+		  *
+		  */
+
+		void evaluate_population(const Dataset & data,
+									 const std::vector<double> & labels,
+								 	 aux::eval_function_t funcion_evaluacion,
+									 const Racing_evaluator & racing);
+
+		/**
+		  * @brief Obtener los individuos de la población que no están evaluados
+		  * con todos los datos.
+		  *
+		  * @return Indices de los individuos sin evaluar
+		  */
+
+		std::vector<unsigned> get_unevaluated_individuals() const;
+
+		/**
+		  * @brief Evaluar con todos los datos los individuos dados.
+		  *
+		  * @param individuos Indices de los individuos a evaluar
+		  * @param data Datos con los que se evaluarán los individuos
+		  * @param labels Valores correspondientes a los data dados
+		  * @param funcion_evaluacion Funcion de evaluación a utilizar
+		  *
+		  * @post El mejor individuo no se actualiza.
+		  *
+		  * El reparto entre hebras (por individuos, por bloques de filas o por
+		  * ambos) lo decide un Evaluation_scheduler según el número de individuos,
+		  * su longitud y el número de filas. El trabajo se entrega de mayor a menor
+		  * coste estimado desde una cola con robo de tareas, a tareas del
+		  * Task_scheduler global. Si la función de evaluación se puede acumular por
+		  * filas (ver aux::get_metric_reduction) se evalúa con su métrica, como en la
+		  * versión con una métrica.
+		  *
+		  * @pre Los individuos dados no están evaluados.
+		  */
+
+		void evaluate_individuals(const std::vector<unsigned> & individuos,
+										  const Dataset & data,
+										  const std::vector<double> & labels,
+										  aux::eval_function_t funcion_evaluacion);
+
+		/**
+		  * @brief Evaluar con todos los datos los individuos dados con una métrica
+		  * que se acumula fila a fila. El reparto es el de la versión con una función
+		  * de evaluación, pero el error se acumula en línea: si los datos no caben en
+		  * caché o en una ventana los individuos se evalúan por bloques de filas, sin
+		  * guardar las predicciones.
+		  *
+		  * @param individuos Indices de los individuos a evaluar
+		  * @param data Datos con los que se evaluarán los individuos
+		  * @param labels Valores correspondientes a los data dados
+		  * @param metrica Métrica a utilizar
+		  *
+		  * @tparam Metric Tipo de la métrica, como aux::Mean_squared_error: un tipo
+		  * state_t, init() con el estado sin filas, accumulate(estado, predicho, real)
+		  * que añade una fila, combine(estado, estado) que une dos conjuntos de filas
+		  * disjuntos y finalize(estado, num_filas) con el valor de la métrica
+		  *
+		  * @post El mejor individuo no se actualiza.
+		  *
+		  * @pre Los individuos dados no están evaluados.
+		  */
+
+		template <class Metric>
+		void evaluate_individuals(const std::vector<unsigned> & individuos,
+										  const Dataset & data,
+										  const std::vector<double> & labels,
+										  const Metric & metrica);
+
+		/**
+		  * @brief Competir los individuos dados sobre la muestra del evaluador.
+		  * Los que no alcanzan el cuantil superior se quedan con su fitness estimado.
+		  *
+		  * @param candidatos Indices de los individuos a competir
+		  * @param racing Evaluador con la muestra de los datos
+		  * @param funcion_evaluacion Funcion de evaluación a utilizar
+		  *
+		  * @return Indices de los individuos que se han de evaluar con todos los datos
+		  */
+
+		std::vector<unsigned> race_individuals(const std::vector<unsigned> & candidatos,
+															const Racing_evaluator & racing,
+															aux::eval_function_t funcion_evaluacion);
+
 		/**
 		 * @brief Seleccionar un individuo de la población
 		 *
@@ -229,6 +546,17 @@ class Population{
 
 		Population & operator= (const Population & otra);
 
+		/**
+		  * @brief Operador de asignación con movimiento. Se queda con los
+		  * individuos de otra sin copiarlos.
+		  *
+		  * @param otra Poblacion a mover, queda vacía.
+		  *
+		  * @return Referencia a la poblacion.
+		  */
+
+		Population & operator= (Population && otra) noexcept;
+
 		/**
 		  * @brief Cambiar el tamaño de la Population por el dado.
 		  *
@@ -248,6 +576,15 @@ class Population{
 
 		void insert(const T & nuevo_elemento);
 
+		/**
+		  * @brief Insertar un elemento en la Population sin copiarlo.
+		  *
+		  * @param nuevo_elemento Elemento a insertar, se mueve a la población.
+		  *
+		  */
+
+		void insert(T && nuevo_elemento);
+
 		/**
 		  * @brief Eliminar un elemento en la Population.
 		  *
@@ -273,14 +610,72 @@ class Population{
 
 		void set_best_individual(const int nuevo_mejor);
 
+		/**
+		 * @brief Cambiar el número de individuos de la élite. La élite se
+		 * recalcula en la siguiente búsqueda del mejor individuo.
+		 *
+		 * @param tam Número de mejores individuos a mantener, al menos 1
+		 *
+		 */
+
+		void set_elite_size(const unsigned tam);
+
+		/**
+		 * @brief Obtener los mejores individuos de la población sin ordenarla, según
+		 * la última búsqueda del mejor individuo y las inserciones posteriores
+		 *
+		 * @return Indices de los individuos de la élite, del mejor al peor
+		 *
+		 */
+
+		std::vector<int> get_elite() const;
+
+		/**
+		 * @brief Obtener los mejores individuos de la población, sin ordenarla ni
+		 * cambiar su élite
+		 *
+		 * @param tam Número de individuos a obtener
+		 *
+		 * @return Indices de los tam mejores individuos, del mejor al peor
+		 *
+		 */
+
+		std::vector<int> get_best_indices(const unsigned tam) const;
+
+		/**
+		 * @brief Sustituir los peores individuos de la población por los dados. Los
+		 * peores se buscan con una selección parcial, sin ordenar la población.
+		 *
+		 * @param nuevos Individuos a insertar
+		 *
+		 * @pre nuevos.size < get_population_size
+		 *
+		 */
+
+		void replace_worst(const std::vector<T> & nuevos);
+
 
 		/**
-		 * @brief Buscar el mejor individuo en la población
+		 * @brief Buscar el mejor individuo en la población, de entre los
+		 * individuos evaluados
 		 *
 		 *
 		 */
 		void search_best_individual();
 
+		/**
+		 * @brief Buscar el mejor individuo en la población. Si ningún individuo
+		 * está evaluado, se evalua con todos los datos el mejor estimado.
+		 *
+		 * @param data Datos con los que evaluar el mejor individuo estimado
+		 * @param labels Valores correspondientes a los data dados
+		 * @param funcion_evaluacion Funcion de evaluación a utilizar
+		 *
+		 */
+		void search_best_individual(const Dataset & data,
+											 const std::vector<double> & labels,
+											 aux::eval_function_t funcion_evaluacion);
+
 };
 
 } // namespace expressions_algs
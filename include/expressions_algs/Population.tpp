@@ -11,17 +11,28 @@ template <class T>
 Population<T> :: Population(const unsigned tam, const unsigned lon_expre,
 							const double prob_var, const unsigned num_vars,
 							const unsigned prof_expre){
-	// liberamos memoria para initialize a vacio
-	expressions_ = std::vector<T>();
+	// los individuos se construyen vacios, sin cromosoma, y se generan en su sitio sin copiar temporales
+	expressions_ = std::vector<T>(tam, T(0));
 
+	// cada bloque de individuos tiene su propia secuencia de aleatorios, derivada de una unica
+	// semilla, asi la poblacion no depende del numero de hebras
+	const unsigned long semilla = Random::get_int(std::numeric_limits<int>::max());
+	const unsigned num_bloques = (tam + INIT_BLOCK_SIZE - 1) / INIT_BLOCK_SIZE;
 
-	// reservamos memoria para tam individuos
-	expressions_.resize(tam);
-	// inicializamos todas las expresiones de la poblacion
+	// la hebra actual tambien genera bloques, conservamos su generador
+	const std::mt19937 generador = Random::get_generator();
 
-	for (unsigned i = 0; i < tam; i++){
-		expressions_[i] = T(lon_expre, prob_var, num_vars, prof_expre);
-	}
+	Task_scheduler::global().parallel_for(0, num_bloques, 1, [&](const unsigned bloque){
+		Random::set_seed(Fold_executor::fold_seed(semilla, bloque));
+
+		const unsigned fin = std::min((bloque + 1) * INIT_BLOCK_SIZE, tam);
+
+		for (unsigned i = bloque * INIT_BLOCK_SIZE; i < fin; i++){
+			expressions_[i].initialize_random(lon_expre, prob_var, num_vars, prof_expre);
+		}
+	});
+
+	Random::set_generator(generador);
 
 }
 
@@ -32,6 +43,16 @@ Population<T> :: Population ( const Population & otra) {
 	(*this) = otra;
 }
 
+template <class T>
+Population<T> :: Population ( Population && otra) noexcept
+	:expressions_(std::move(otra.expressions_)), mejor_individuo_(otra.mejor_individuo_),
+	 elite_(std::move(otra.elite_))
+{
+	otra.expressions_.clear();
+	otra.mejor_individuo_ = -1;
+	otra.elite_.candidatos.clear();
+}
+
 template <class T>
 Population<T> :: ~Population(){
 }
@@ -40,36 +61,388 @@ template <class T>
 void Population<T> :: copy_data(const Population & otra){
 	// copiamos los atributos
 	mejor_individuo_ = otra.mejor_individuo_;
+	elite_ = otra.elite_;
 
 	expressions_ = otra.expressions_;
 }
 
 template <class T>
-void Population<T> :: evaluate_population(const std::vector<std::vector<double> > & data,
+void Population<T> :: evaluate_population(const Dataset & data,
 												  const std::vector<double> & labels,
 											  	  aux::eval_function_t f_evaluacion){
-	// establecemos el mejor individuo al primero
-	mejor_individuo_ = 0;
 
-	if (!expressions_[0].is_evaluated()) {
-		expressions_[0].evaluate_expression(data, labels, f_evaluacion);
+	evaluate_individuals(get_unevaluated_individuals(), data, labels, f_evaluacion);
+
+	// el mejor se busca con una reduccion en lugar de una seccion critica
+	search_best_individual();
+}
+
+template <class T>
+void Population<T> :: evaluate_population(const Dataset & data,
+												  const std::vector<double> & labels,
+											  	  aux::eval_function_t f_evaluacion,
+												  const Racing_evaluator & racing){
+
+	if ( !racing.is_active() ) {
+		evaluate_population(data, labels, f_evaluacion);
+	} else {
+		std::vector<unsigned> promocionados = race_individuals(get_unevaluated_individuals(),
+																				 racing, f_evaluacion);
+
+		evaluate_individuals(promocionados, data, labels, f_evaluacion);
+
+		search_best_individual(data, labels, f_evaluacion);
+	}
+
+}
+
+template <class T>
+std::vector<unsigned> Population<T> :: get_unevaluated_individuals() const {
+	std::vector<unsigned> pendientes;
+
+	for ( unsigned i = 0; i < expressions_.size(); i++) {
+		if ( !expressions_[i].is_evaluated() ) {
+			pendientes.push_back(i);
+		}
+	}
+
+	return pendientes;
+}
+
+template <class T>
+template <class Metric>
+void Population<T> :: evaluate_population(const Dataset & data,
+												  const std::vector<double> & labels,
+											  	  const Metric & metrica){
+
+	evaluate_individuals(get_unevaluated_individuals(), data, labels, metrica);
+
+	search_best_individual();
+}
+
+template <class T>
+void Population<T> :: evaluate_individuals(const std::vector<unsigned> & individuos,
+												 	    const Dataset & data,
+												 	    const std::vector<double> & labels,
+												 	    aux::eval_function_t f_evaluacion) {
+
+	const aux::Runtime_metric metrica (f_evaluacion);
+
+	// cada metrica que se acumula por filas tiene su propia version del bucle, con la reduccion en linea
+	if ( metrica.is_decomposable() ) {
+		aux::dispatch_metric(metrica.get_reduction(), [&](const auto reduccion) {
+			evaluate_individuals(individuos, data, labels, reduccion);
+		});
+		return ;
 	}
 
-	// evaluamos el resto de individuos
-	#pragma omp parallel for
-	for ( unsigned i = 1; i < expressions_.size(); i++){
-		if (!expressions_[i].is_evaluated()){
-			expressions_[i].evaluate_expression(data, labels, f_evaluacion);
+	unsigned long longitud_total = 0;
+
+	for ( unsigned i = 0; i < individuos.size(); i++) {
+		longitud_total += expressions_[individuos[i]].get_tree_length();
+	}
+
+	const Evaluation_scheduler plan (individuos.size(), longitud_total, data.get_num_rows());
+
+	evaluate_individuals_tiles(individuos, data, plan,
+										[&](T & expresion) {
+											expresion.evaluate_expression(data, labels, f_evaluacion);
+										},
+										[&](const std::vector<double> & predicciones) {
+											return f_evaluacion(predicciones, labels);
+										});
+}
+
+template <class T>
+template <class Metric>
+void Population<T> :: evaluate_individuals(const std::vector<unsigned> & individuos,
+												 	    const Dataset & data,
+												 	    const std::vector<double> & labels,
+												 	    const Metric & metrica) {
+
+	std::vector<unsigned> no_vacios;
+	unsigned long longitud_total = 0;
+
+	// una expresion vacia no necesita recorrer los datos, se queda con su fitness como en evaluate_expression
+	for ( unsigned i = 0; i < individuos.size(); i++) {
+		T & expresion = expressions_[individuos[i]];
+
+		if ( expresion.get_tree_length() > 0 ) {
+			no_vacios.push_back(individuos[i]);
+			longitud_total += expresion.get_tree_length();
+		} else {
+			expresion.set_fitness(expresion.get_fitness());
 		}
+	}
+
+	const Evaluation_scheduler plan (no_vacios.size(), longitud_total, data.get_num_rows());
+
+	// bytes de una fila, junto con su etiqueta
+	const unsigned long tam_fila = (data.get_num_columns() + 1) * sizeof(double);
+
+	// unos datos que no caben en una ventana se recorren por bloques, sin guardar las predicciones
+	const bool por_ventanas = data.get_stream_rows() < data.get_num_rows();
 
-		#pragma omp critical
-		{
-			if (expressions_[i].get_fitness() < expressions_[mejor_individuo_].get_fitness()){
-				mejor_individuo_ = i;
+	if ( por_ventanas || plan.cache_blocking(data.get_num_rows(), tam_fila) ) {
+		evaluate_individuals_blocked(no_vacios, data, labels, metrica, plan,
+											  Evaluation_scheduler::cache_block_rows(tam_fila));
+		return ;
+	}
+
+	const std::size_t paso = data.get_column_stride();
+
+	evaluate_individuals_tiles(no_vacios, data, plan,
+										[&](T & expresion) {
+											// el individuo completo, con el error acumulado en linea
+											typename Metric::state_t suma = metrica.init();
+
+											for ( unsigned fila = 0; fila < data.get_num_rows(); fila++) {
+												suma = metrica.accumulate(suma, expresion.evaluate_data(data.get_row(fila), paso),
+																				  labels[fila]);
+											}
+
+											expresion.set_fitness(metrica.finalize(suma, labels.size()));
+										},
+										[&](const std::vector<double> & predicciones) {
+											return aux::reduce_metric(metrica, predicciones, labels);
+										});
+}
+
+template <class T>
+template <class Evaluate, class Finalize>
+void Population<T> :: evaluate_individuals_tiles(const std::vector<unsigned> & individuos,
+																 const Dataset & data,
+																 const Evaluation_scheduler & plan,
+																 Evaluate evaluar,
+																 Finalize finalizar) {
+
+	const int num_hebras = plan.get_num_threads();
+
+	// cada tarea es una tesela (individuo, bloque de filas), con coste proporcional a longitud por filas
+	const unsigned num_bloques = plan.get_row_blocks();
+	const unsigned tam_bloque = (data.get_num_rows() + num_bloques - 1) / num_bloques;
+
+	std::vector<unsigned> teselas (individuos.size() * num_bloques);
+	std::vector<double> costes (teselas.size());
+
+	for ( unsigned tesela = 0; tesela < teselas.size(); tesela++) {
+		const unsigned primera = (tesela % num_bloques) * tam_bloque;
+		const unsigned ultima = std::min(primera + tam_bloque, data.get_num_rows());
+
+		teselas[tesela] = tesela;
+		costes[tesela] = static_cast<double>(expressions_[individuos[tesela / num_bloques]].get_tree_length()) *
+							  (ultima - primera);
+	}
+
+	Work_stealing_queue cola (teselas, costes, num_hebras);
+
+	if ( plan.get_axis() == EvaluationAxis::INDIVIDUALS ) {
+		// cada tarea evalua individuos completos, primero los mas largos
+		Task_scheduler::global().parallel_for(0, num_hebras, 1, [&](const unsigned hebra) {
+			unsigned i;
+
+			while ( cola.next(hebra, i) ) {
+				evaluar(expressions_[individuos[i]]);
+			}
+		});
+	} else {
+		std::vector<std::vector<double> > predicciones (individuos.size(),
+																		std::vector<double>(data.get_num_rows()));
+
+		Task_scheduler::global().parallel_for(0, num_hebras, 1, [&](const unsigned hebra) {
+			unsigned tesela;
+
+			while ( cola.next(hebra, tesela) ) {
+				const unsigned i = tesela / num_bloques;
+				const unsigned primera = (tesela % num_bloques) * tam_bloque;
+				const unsigned ultima = std::min(primera + tam_bloque, data.get_num_rows());
+
+				if ( expressions_[individuos[i]].get_tree_length() > 0 ) {
+					expressions_[individuos[i]].predict_rows(data, primera, ultima, predicciones[i]);
+				}
+			}
+		});
+
+		// con todas las predicciones calculamos el fitness de cada individuo
+		Task_scheduler::global().parallel_for(0, individuos.size(), 1, [&](const unsigned i) {
+			if ( expressions_[individuos[i]].get_tree_length() > 0 ) {
+				expressions_[individuos[i]].set_fitness(finalizar(predicciones[i]));
+			} else {
+				evaluar(expressions_[individuos[i]]);
+			}
+		});
+	}
+
+}
+
+template <class T>
+template <class Metric>
+void Population<T> :: evaluate_individuals_blocked(const std::vector<unsigned> & individuos,
+																	const Dataset & data,
+																	const std::vector<double> & labels,
+																	const Metric & metrica,
+																	const Evaluation_scheduler & plan,
+																	const unsigned filas_bloque) {
+
+	// un grupo de individuos por hebra, todos los grupos recorren a la vez el mismo bloque
+	const unsigned num_grupos = std::min(plan.get_num_threads(), static_cast<unsigned>(individuos.size()));
+
+	std::vector<double> costes (individuos.size());
+
+	for ( unsigned i = 0; i < individuos.size(); i++) {
+		costes[i] = expressions_[individuos[i]].get_tree_length();
+	}
+
+	// repartimos los individuos de mayor a menor coste para equilibrar los grupos
+	std::vector<unsigned> orden (individuos.size());
+
+	for ( unsigned i = 0; i < orden.size(); i++) {
+		orden[i] = i;
+	}
+
+	std::stable_sort(orden.begin(), orden.end(), [&costes](const unsigned a, const unsigned b) {
+		return costes[a] > costes[b];
+	});
+
+	std::vector<std::vector<unsigned> > grupos (num_grupos);
+
+	for ( unsigned i = 0; i < orden.size(); i++) {
+		grupos[i % num_grupos].push_back(individuos[orden[i]]);
+	}
+
+	const std::size_t paso = data.get_column_stride();
+
+	// error parcial acumulado de cada individuo de cada grupo
+	std::vector<std::vector<typename Metric::state_t> > sumas (num_grupos);
+
+	for ( unsigned g = 0; g < num_grupos; g++) {
+		sumas[g].assign(grupos[g].size(), metrica.init());
+	}
+
+	// los datos en memoria forman una unica ventana
+	const unsigned filas_ventana = std::max(data.get_stream_rows(), 1u);
+
+	// con menos individuos que hebras cada grupo tiene un solo individuo y habria hebras paradas:
+	// las hebras se reparten entonces los bloques de la ventana, guardando las predicciones
+	const bool por_filas = individuos.size() < plan.get_num_threads();
+
+	std::vector<std::vector<double> > predicciones (por_filas ? num_grupos : 0,
+																	std::vector<double>(filas_ventana));
+
+	for ( unsigned ventana = 0; ventana < data.get_num_rows(); ventana += filas_ventana) {
+		const unsigned fin_ventana = std::min(ventana + filas_ventana, data.get_num_rows());
+
+		// el nucleo lee la siguiente ventana mientras se evalua esta
+		data.prefetch_rows(fin_ventana, std::min(fin_ventana + filas_ventana, data.get_num_rows()));
+
+		if ( por_filas ) {
+			// al menos un bloque por hebra aunque la ventana quepa en cache
+			const unsigned tam_bloque = std::max(std::min(filas_bloque, (fin_ventana - ventana + plan.get_num_threads() - 1) /
+																		 plan.get_num_threads()), 1u);
+			const unsigned num_bloques = (fin_ventana - ventana + tam_bloque - 1) / tam_bloque;
+
+			// cada tarea recorre un bloque con todos los individuos, que se queda en cache entre ellos
+			Task_scheduler::global().parallel_for(0, num_bloques, 1, [&](const unsigned b) {
+				const unsigned inicio = ventana + b * tam_bloque;
+				const unsigned fin = std::min(inicio + tam_bloque, fin_ventana);
+
+				for ( unsigned g = 0; g < num_grupos; g++) {
+					const T & expresion = expressions_[grupos[g].front()];
+
+					for ( unsigned fila = inicio; fila < fin; fila++) {
+						predicciones[g][fila - ventana] = expresion.evaluate_data(data.get_row(fila), paso);
+					}
+				}
+			});
+
+			// el error se acumula en el orden de las filas, asi no depende del reparto de los bloques
+			Task_scheduler::global().parallel_for(0, num_grupos, 1, [&](const unsigned g) {
+				typename Metric::state_t suma = sumas[g].front();
+
+				for ( unsigned fila = ventana; fila < fin_ventana; fila++) {
+					suma = metrica.accumulate(suma, predicciones[g][fila - ventana], labels[fila]);
+				}
+
+				sumas[g].front() = suma;
+			});
+		} else {
+			// el bloque es el bucle externo, compartido por todas las hebras: se trae de memoria
+			// una sola vez y se queda en cache mientras lo recorren todos los individuos
+			for ( unsigned inicio = ventana; inicio < fin_ventana; inicio += filas_bloque) {
+				const unsigned fin = std::min(inicio + filas_bloque, fin_ventana);
+
+				Task_scheduler::global().parallel_for(0, num_grupos, 1, [&](const unsigned g) {
+					const std::vector<unsigned> & grupo = grupos[g];
+
+					for ( unsigned k = 0; k < grupo.size(); k++) {
+						const T & expresion = expressions_[grupo[k]];
+						typename Metric::state_t suma = sumas[g][k];
+
+						for ( unsigned fila = inicio; fila < fin; fila++) {
+							suma = metrica.accumulate(suma, expresion.evaluate_data(data.get_row(fila), paso), labels[fila]);
+						}
+
+						sumas[g][k] = suma;
+					}
+				});
 			}
 		}
 
+		data.release_rows(ventana, fin_ventana);
+	}
+
+	for ( unsigned g = 0; g < num_grupos; g++) {
+		for ( unsigned k = 0; k < grupos[g].size(); k++) {
+			expressions_[grupos[g][k]].set_fitness(metrica.finalize(sumas[g][k], labels.size()));
+		}
 	}
+
+}
+
+template <class T>
+std::vector<unsigned> Population<T> :: race_individuals(const std::vector<unsigned> & candidatos,
+																		 const Racing_evaluator & racing,
+																		 aux::eval_function_t f_evaluacion) {
+
+	std::vector<unsigned> promocionados;
+
+	if ( !racing.is_active() ) {
+		promocionados = candidatos;
+	} else {
+		std::vector<double> referencia;
+
+		// los individuos ya evaluados sirven de referencia para la competicion
+		for ( unsigned i = 0; i < expressions_.size(); i++) {
+			if ( expressions_[i].is_evaluated() ) {
+				referencia.push_back(expressions_[i].get_fitness());
+			}
+		}
+
+		std::vector<std::pair<double, double> > estimaciones (candidatos.size());
+
+		Task_scheduler::global().parallel_for(0, candidatos.size(), 1, [&](const unsigned i) {
+			estimaciones[i] = racing.estimate(expressions_[candidatos[i]], f_evaluacion);
+		});
+
+		// en la poblacion inicial no hay nadie evaluado, comparamos las estimaciones entre si
+		if ( referencia.empty() ) {
+			for ( unsigned i = 0; i < estimaciones.size(); i++) {
+				referencia.push_back(estimaciones[i].first);
+			}
+		}
+
+		const double umbral = racing.threshold(referencia);
+
+		for ( unsigned i = 0; i < candidatos.size(); i++) {
+			if ( racing.promote(estimaciones[i], umbral) ) {
+				promocionados.push_back(candidatos[i]);
+			} else {
+				expressions_[candidatos[i]].set_estimated_fitness(estimaciones[i].first);
+			}
+		}
+	}
+
+	return promocionados;
 }
 
 template <class T>
@@ -152,6 +525,24 @@ Population<T> & Population<T> :: operator= (const Population & otra) {
 
 }
 
+template <class T>
+Population<T> & Population<T> :: operator= (Population && otra) noexcept {
+
+	if (this != &otra){
+		// nos quedamos con los individuos de la otra, que queda vacia
+		expressions_ = std::move(otra.expressions_);
+		mejor_individuo_ = otra.mejor_individuo_;
+		elite_ = std::move(otra.elite_);
+
+		otra.expressions_.clear();
+		otra.mejor_individuo_ = -1;
+		otra.elite_.candidatos.clear();
+	}
+
+	return (*this);
+
+}
+
 template <class T>
 void Population<T> :: set_individual(const unsigned index, const T & n_individuo) {
 	expressions_[index] = n_individuo;
@@ -159,11 +550,27 @@ void Population<T> :: set_individual(const unsigned index, const T & n_individuo
 
 template <class T>
 void Population<T> :: insert(const T & nuevo_elemento) {
-	expressions_.push_back(nuevo_elemento);
+	insert(T(nuevo_elemento));
+}
+
+template <class T>
+void Population<T> :: insert(T && nuevo_elemento) {
+	expressions_.push_back(std::move(nuevo_elemento));
+	const T & nuevo = expressions_.back();
+
+	Candidato_mejor candidato;
+	candidato.indice = expressions_.size() - 1;
+	candidato.evaluado = nuevo.is_evaluated();
+	candidato.fitness = nuevo.get_fitness();
+
+	elite_.insertar(candidato);
 
 	if ( expressions_.size() == 1) {
 		mejor_individuo_ = 0;
-	} else if (expressions_[mejor_individuo_].get_fitness() > nuevo_elemento.get_fitness()) {
+	} else if ( nuevo.is_evaluated() &&
+				   ( !expressions_[mejor_individuo_].is_evaluated() ||
+					  expressions_[mejor_individuo_].get_fitness() > nuevo.get_fitness() ) ) {
+		// los individuos con fitness estimado no pueden ser el mejor
 		mejor_individuo_ = expressions_.size() - 1;
 	}
 }
@@ -174,19 +581,169 @@ void Population<T> :: set_best_individual(const int nuevo_mejor) {
 }
 
 template <class T>
-void Population<T> :: search_best_individual() {
-	mejor_individuo_ = -1;
+void Population<T> :: set_elite_size(const unsigned tam) {
+	elite_ = Elite(tam);
+}
 
-	if ( expressions_.size() > 0) {
-		mejor_individuo_ = 0;
+template <class T>
+std::vector<int> Population<T> :: get_elite() const {
+	return elite_.indices();
+}
 
-		for ( unsigned i = 0; i < expressions_.size(); i++) {
-			if (expressions_[i].get_fitness() < expressions_[mejor_individuo_].get_fitness()) {
-				mejor_individuo_ = i;
-			}
+template <class T>
+typename Population<T>::Candidato_mejor Population<T> :: candidato(const unsigned indice) const {
+	Candidato_mejor resultado;
+
+	resultado.indice = indice;
+	resultado.evaluado = expressions_[indice].is_evaluated();
+	resultado.fitness = expressions_[indice].get_fitness();
+
+	return resultado;
+}
+
+template <class T>
+std::vector<int> Population<T> :: get_best_indices(const unsigned tam) const {
+	Elite mejores (tam);
+
+	for ( unsigned i = 0; i < expressions_.size(); i++) {
+		mejores.insertar(candidato(i));
+	}
+
+	return mejores.indices();
+}
+
+template <class T>
+void Population<T> :: replace_worst(const std::vector<T> & nuevos) {
+	std::vector<Candidato_mejor> candidatos (expressions_.size());
+
+	for ( unsigned i = 0; i < candidatos.size(); i++) {
+		candidatos[i] = candidato(i);
+	}
+
+	// los peores quedan al final, el orden es total asi que la eleccion es determinista
+	const unsigned primero = candidatos.size() - nuevos.size();
+
+	std::nth_element(candidatos.begin(), candidatos.begin() + primero, candidatos.end(),
+						  Candidato_mejor::es_mejor);
+
+	for ( unsigned i = 0; i < nuevos.size(); i++) {
+		expressions_[candidatos[primero + i].indice] = nuevos[i];
+	}
+
+	search_best_individual();
+}
+
+template <class T>
+typename Population<T>::Candidato_mejor Population<T>::Candidato_mejor :: mejor(const Candidato_mejor & a,
+																											  const Candidato_mejor & b) {
+	Candidato_mejor resultado = a;
+
+	if ( a.indice == -1 ) {
+		resultado = b;
+	} else if ( b.indice != -1 ) {
+		const bool a_nan = std::isnan(a.fitness);
+		const bool b_nan = std::isnan(b.fitness);
+
+		if ( a.evaluado != b.evaluado ) {
+			resultado = a.evaluado ? a : b;
+		} else if ( a_nan != b_nan ) {
+			resultado = a_nan ? b : a;
+		} else if ( a.fitness < b.fitness ) {
+			resultado = a;
+		} else if ( b.fitness < a.fitness ) {
+			resultado = b;
+		} else {
+			resultado = a.indice < b.indice ? a : b;
 		}
 	}
 
+	return resultado;
+}
+
+template <class T>
+bool Population<T>::Candidato_mejor :: es_mejor(const Candidato_mejor & a, const Candidato_mejor & b) {
+	return a.indice != b.indice && mejor(a, b).indice == a.indice;
+}
+
+template <class T>
+Population<T>::Elite :: Elite(const unsigned capacidad)
+	:capacidad(std::max(capacidad, 1u))
+{
+}
+
+template <class T>
+void Population<T>::Elite :: insertar(const Candidato_mejor & candidato) {
+
+	// con es_mejor como comparacion la cima del monticulo es el peor candidato
+	if ( candidatos.size() < capacidad ) {
+		candidatos.push_back(candidato);
+		std::push_heap(candidatos.begin(), candidatos.end(), Candidato_mejor::es_mejor);
+	} else if ( Candidato_mejor::es_mejor(candidato, candidatos.front()) ) {
+		std::pop_heap(candidatos.begin(), candidatos.end(), Candidato_mejor::es_mejor);
+		candidatos.back() = candidato;
+		std::push_heap(candidatos.begin(), candidatos.end(), Candidato_mejor::es_mejor);
+	}
+
+}
+
+template <class T>
+void Population<T>::Elite :: combinar(const Elite & otra) {
+	for ( const Candidato_mejor & candidato : otra.candidatos ) {
+		insertar(candidato);
+	}
+}
+
+template <class T>
+std::vector<int> Population<T>::Elite :: indices() const {
+	std::vector<Candidato_mejor> ordenados = candidatos;
+
+	// solo se ordenan los candidatos de la elite, no la poblacion
+	std::sort_heap(ordenados.begin(), ordenados.end(), Candidato_mejor::es_mejor);
+
+	std::vector<int> resultado (ordenados.size());
+
+	for ( unsigned i = 0; i < ordenados.size(); i++) {
+		resultado[i] = ordenados[i].indice;
+	}
+
+	return resultado;
+}
+
+template <class T>
+void Population<T> :: search_best_individual() {
+
+	// los individuos con fitness estimado solo pueden ser el mejor si no hay ninguno evaluado
+	Elite elite = Task_scheduler::global().parallel_reduce(0, expressions_.size(), SEARCH_GRAIN, Elite(elite_.capacidad),
+		[this](const unsigned i, Elite & parcial) {
+			parcial.insertar(candidato(i));
+		},
+		[](Elite & total, const Elite & parcial) {
+			total.combinar(parcial);
+		});
+
+	// el orden es total, asi que la elite no depende del reparto entre hebras
+	elite_ = std::move(elite);
+	Candidato_mejor mejor;
+
+	for ( const Candidato_mejor & candidato : elite_.candidatos ) {
+		mejor = Candidato_mejor::mejor(mejor, candidato);
+	}
+
+	mejor_individuo_ = mejor.indice;
+
+}
+
+
+template <class T>
+void Population<T> :: search_best_individual(const Dataset & data,
+															const std::vector<double> & labels,
+															aux::eval_function_t f_evaluacion) {
+	search_best_individual();
+
+	// siempre tiene que haber un mejor individuo evaluado con todos los datos
+	if ( mejor_individuo_ != -1 && !expressions_[mejor_individuo_].is_evaluated() ) {
+		expressions_[mejor_individuo_].evaluate_expression(data, labels, f_evaluacion);
+	}
 }
 
 
@@ -200,7 +757,9 @@ template <class T>
 void Population<T> :: ordenar() {
 
 	std::sort(expressions_.begin(), expressions_.end());
-	mejor_individuo_ = 0;
+
+	// el primero puede tener un fitness estimado
+	search_best_individual();
 
 }
 
@@ -11,6 +11,15 @@
 #include "expressions_algs/aux_expressions_alg.hpp"
 #include "expressions_algs/Population.hpp"
 #include "expressions_algs/Parameters.hpp"
+#include "expressions_algs/Surrogate_model.hpp"
+#include "expressions_algs/Fold_executor.hpp"
+#include "expressions_algs/Task_scheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 
 /**
@@ -58,15 +67,11 @@ class Population_alg {
 
 
 		/**
-		  * @brief Datos con los que fit el algoritmo
+		  * @brief Datos con los que fit el algoritmo, junto con las etiquetas
+		  * para comprobar el error de la estimación.
 		  *
 		  */
-		std::vector<std::vector<double> > data_;
-
-		/**
-		  * @brief Etiquetas para comprobar el error de la estimación.
-		  */
-		std::vector<double> output_data_;
+		Dataset data_;
 
 
 		/**
@@ -90,6 +95,20 @@ class Population_alg {
 
 		double probabilidad_variable_;
 
+		/**
+		  * @brief Evaluador con la muestra de los datos para competir las expresiones
+		  *
+		  */
+
+		Racing_evaluator racing_;
+
+		/**
+		  * @brief Modelo que predice el fitness de los hijos para no evaluar los claramente peores
+		  *
+		  */
+
+		Surrogate_model surrogate_;
+
 
 
 		/**
@@ -125,10 +144,99 @@ class Population_alg {
 		std::pair<bool, bool> apply_GP_mutations(T & son1, T & son2,
 			 													 const double prob_mutacion);
 
+		/**
+		 *  @brief Evaluar la poblacion con los datos cargados. Si los parametros lo indican,
+		 * antes se descartan los hijos que el surrogate predice claramente peores que el
+		 * umbral del torneo y se compiten sobre una muestra de los datos
+		 *
+		 * @param parameters Parametros con la funcion de evaluacion y la configuracion de la competicion
+		 *
+		 */
+
+		void evaluate_population(const Parameters & parameters);
+
+		/**
+		 *  @brief Generar dos hijos a partir de dos padres con los operadores geneticos
+		 * del algoritmo. Se llama a la vez desde varias hebras en el modo estacionario,
+		 * por lo que solo puede leer el estado del algoritmo.
+		 *
+		 * @param mom Primer padre
+		 * @param dad Segundo padre
+		 * @param son1 Primer hijo, se sobrescribe con la copia de mom antes de cruzar
+		 * @param son2 Segundo hijo, se sobrescribe con la copia de dad antes de cruzar
+		 * @param parameters Parametros con las probabilidades de los operadores
+		 * @param generation Generacion actual, para los operadores que dependen de ella
+		 * @param num_generations Numero total de generaciones
+		 *
+		 * @return Pareja de booleanos, verdadero si el hijo ha cambiado respecto a su padre
+		 */
+
+		virtual std::pair<bool, bool> breed(const T & mom, const T & dad, T & son1, T & son2,
+														const Parameters & parameters, const int generation,
+														const int num_generations) = 0;
+
+		/**
+		 *  @brief Torneo sobre una copia del fitness de la poblacion que se lee sin cerrojos.
+		 * Los participantes se escogen con reemplazamiento y un fitness NaN es el peor.
+		 *
+		 * @param fitness Fitness de cada individuo
+		 * @param tam_torneo Numero de participantes
+		 * @param mejor Verdadero para escoger al mejor participante, falso para el peor
+		 *
+		 * @return Indice del ganador del torneo
+		 */
+
+		static unsigned steady_state_tournament(const std::vector<std::atomic<double> > & fitness,
+															 const unsigned tam_torneo, const bool mejor);
+
+		/**
+		 *  @brief Cruzar parejas de la poblacion en paralelo y sustituir a cada padre por
+		 * su hijo si este ha cambiado. Las parejas se cruzan por bloques de BREED_BLOCK_SIZE,
+		 * cada bloque con su propia semilla obtenida del generador de la hebra actual, por
+		 * lo que la poblacion resultante no depende del numero de hebras.
+		 *
+		 * @param parejas Indices de la madre y el padre de cada cruce, cada individuo en una pareja como mucho
+		 * @param cruzar Funcion que recibe el indice de la pareja, la madre, el padre y los dos hijos,
+		 * y devuelve si cada hijo ha cambiado, como breed. Se llama a la vez desde varias hebras.
+		 */
+
+		/**
+		 *  @brief Torneo entre los individuos de una generacion que ya estan evaluados.
+		 * Los participantes se escogen con reemplazamiento y un fitness NaN es el peor.
+		 *
+		 * @param generacion Individuos de la generacion
+		 * @param evaluados Posiciones de los individuos evaluados, en el orden en el que se evaluaron
+		 * @param num_evaluados Numero de posiciones de evaluados que se pueden escoger
+		 * @param tam_torneo Numero de participantes
+		 *
+		 * @pre num_evaluados > 0
+		 *
+		 * @return Posicion en generacion del ganador del torneo
+		 */
+
+		static unsigned pipeline_tournament(const std::vector<T> & generacion, const std::vector<unsigned> & evaluados,
+														const unsigned num_evaluados, const unsigned tam_torneo);
+
+		template <class Breed>
+		void breed_pairs(const std::vector<std::pair<unsigned, unsigned> > & parejas, const Breed & cruzar);
+
+		/**
+		  * @brief Numero de parejas que se cruzan con la misma secuencia de aleatorios
+		  */
+
+		static const unsigned BREED_BLOCK_SIZE = 32;
+
+		/**
+		  * @brief Minimo numero de filas que predice cada tarea
+		  */
+
+		static const unsigned PREDICT_GRAIN = 4096;
+
 	public:
 
 		/**
-		 *  @brief Método para leer los data con los que entrenar de un fichero
+		 *  @brief Método para leer los data con los que entrenar de un fichero.
+		 *  Los ficheros en formato binario de Dataset se proyectan en memoria sin copiarlos.
 		 *
 		 * @param data_file Ruta al fichero donde leer los data
 		 * @param comment_char Caracter utilizado para comentarios en el fichero de data
@@ -152,6 +260,16 @@ class Population_alg {
 
 		void load_data(const std::vector< std::vector<double> > & caracteristicas, const std::vector<double> & labels );
 
+		/**
+		  * @brief Cargar un conjunto de datos, con sus etiquetas. Los datos se comparten
+		  * con el conjunto dado, sin copiarlos.
+		  *
+		  * @param datos Conjunto de datos a cargar
+		  *
+		 */
+
+		void load_data(const Dataset & datos);
+
 		/**
 		  * @brief Obtener el numero de variables de los data
 		  *
@@ -185,6 +303,44 @@ class Population_alg {
 
 		void generate_population(const unsigned population_size, const unsigned profundidad_exp, const double prob_var, const bool sustituir_actual = false);
 
+		/**
+		  * @brief Generar una población nueva con la profundidad y la probabilidad de
+		  * variable con las que se inicializó el algoritmo, con el generador de la hebra actual
+		  *
+		  * @param population_size Tamaño de la poblacion a generar
+		  *
+		  */
+
+		void regenerate_population(const unsigned population_size);
+
+		/**
+		  * @brief Obtener el tamaño de la población
+		  *
+		  * @return Número de individuos de la población
+		  */
+
+		unsigned get_population_size() const;
+
+		/**
+		  * @brief Obtener copias de los mejores individuos de la población
+		  *
+		  * @param num_individuos Número de individuos a obtener
+		  *
+		  * @return Los mejores individuos, del mejor al peor
+		  */
+
+		std::vector<T> get_best_individuals(const unsigned num_individuos) const;
+
+		/**
+		  * @brief Recibir individuos de otra población, que sustituyen a los peores
+		  *
+		  * @param inmigrantes Individuos a insertar, evaluados con los mismos datos
+		  *
+		  * @pre inmigrantes.size < get_population_size
+		  */
+
+		void receive_migrants(const std::vector<T> & inmigrantes);
+
 
 
 		/**
@@ -279,6 +435,17 @@ class Population_alg {
 
 		std::vector<double> predict(const std::vector<std::vector<double> > & data) const;
 
+		/**
+		 *  @brief Predecir un conjunto de datos tras entrenar el algoritmo
+		 *
+		 * @param data Datos a predecir, que si estan proyectados se leen por ventanas y no
+		 * tienen por que caber en memoria
+		 *
+		 * @return Valores predichos para cada fila de data
+		 */
+
+		std::vector<double> predict(const Dataset & data) const;
+
 		/**
 		 *  @brief Ajustar el algoritmo con unos parameters dados
 		 *
@@ -288,6 +455,70 @@ class Population_alg {
 
 		virtual void fit(const Parameters & parameters) = 0;
 
+		/**
+		 *  @brief Copiar el algoritmo, con su población y sus datos
+		 *
+		 * @return Copia del algoritmo, del mismo tipo que este
+		 *
+		 */
+
+		virtual std::unique_ptr<Population_alg<T> > clone() const = 0;
+
+		/**
+		 *  @brief Destructor
+		 *
+		 */
+
+		virtual ~Population_alg() = default;
+
+		/**
+		 *  @brief Ajustar el algoritmo con unos datos y parameters dados. Los datos, que
+		 *  pueden ser una vista de otro conjunto, se comparten sin copiarlos
+		 *
+		 * @param data Datos con los que ajustar el algoritmo
+		 * @param parameters Parameters con los que fit el algoritmo
+		 *
+		 */
+
+		void fit(const Dataset & data, const Parameters & parameters);
+
+		/**
+		 *  @brief Ajustar la poblacion en modo estacionario: cada tarea, una por hebra, escoge dos padres
+		 * por torneo, los cruza, evalua los hijos con todos los datos y los inserta en
+		 * la poblacion, sin esperar al resto de una generacion. Cada hijo sustituye al
+		 * peor de un torneo inverso si no es peor que el, bloqueando solo ese individuo,
+		 * por lo que el mejor individuo nunca se pierde. No se usan ni racing ni surrogate.
+		 *
+		 * Se generan como mucho parameters.get_num_evaluations() hijos. Con una hebra el
+		 * resultado solo depende de la semilla; con varias depende ademas del orden en el
+		 * que terminan las evaluaciones.
+		 *
+		 * @param parameters Parametros de ajuste
+		 *
+		 */
+
+		void fit_steady_state(const Parameters & parameters);
+
+		/**
+		 *  @brief Ajustar la poblacion por generaciones solapadas: cada tarea, una por hebra,
+		 * toma la siguiente pareja de la siguiente generacion, escoge los padres por torneo
+		 * entre los individuos ya evaluados de la generacion anterior, los cruza y evalua los
+		 * hijos con todos los datos en cuanto los genera. La seleccion de una generacion
+		 * empieza cuando esta evaluada la fraccion parameters.get_pipeline_ready_fraction()
+		 * de la anterior (y al menos un torneo), asi el cruce de una generacion se solapa con
+		 * la evaluacion de la anterior. El primer individuo de cada generacion es el mejor
+		 * encontrado hasta el momento. No se usan ni racing ni surrogate.
+		 *
+		 * Se hacen tantas generaciones como en el ajuste por generaciones. Cada cruce tiene
+		 * su propia semilla, por lo que con una hebra el resultado solo depende de la semilla;
+		 * con varias depende ademas de los individuos evaluados al empezar cada seleccion.
+		 *
+		 * @param parameters Parameters con los que ajustar el algoritmo
+		 *
+		 */
+
+		void fit_pipelined(const Parameters & parameters);
+
 		/**
 		 *  @brief Ajustar el algoritmo con unos parameters dados utilizando validación simple
 		 *
@@ -300,8 +531,23 @@ class Population_alg {
 
 		std::pair<T, std::vector<std::vector<double> > >  fit_cv_files( std::pair<matriz<double>, std::vector<double> > & datos_train,  std::pair<matriz<double>, std::vector<double> > & datos_test, 
 		 														const Parameters & parameters);
+
+		/**
+		 *  @brief Ajustar el algoritmo con unos parameters dados utilizando validación simple
+		 *
+		 * @param datos_train Datos de train del cv, que se comparten sin copiarlos
+		 * @param datos_test  Datos de validacion del cv
+		 * @param parameters Parameters con los que fit el algoritmo
+		 *
+		 * @return Errores obtenido de los folds de validación cruzada
+		 */
+
+		std::pair<T, std::vector<std::vector<double> > >  fit_cv_files(const Dataset & datos_train, const Dataset & datos_test,
+		 														const Parameters & parameters);
 		/**
-		 *  @brief Ajustar el algoritmo con unos parameters dados utilizando validación cruzada
+		 *  @brief Ajustar el algoritmo con unos parameters dados utilizando validación cruzada.
+		 *  Los folds se ejecutan a la vez con un Fold_executor, cada uno sobre una copia del
+		 *  algoritmo y con su propia semilla, así que el resultado no depende del número de hebras
 		 *
 		 * @param numero_val_cruzada Número de segmentos en los que dividir el conjunto de data para aplicar validación cruzada
 		 * @param parameters Parameters con los que fit el algoritmo
@@ -21,25 +21,30 @@ void Population_alg<T> :: initialize(const unsigned long seed, const unsigned po
 
 template <class T>
 void Population_alg<T> :: load_data(const std::vector< std::vector<double> > & caracteristicas, const std::vector<double> & labels ) {
-	data_ = caracteristicas;
-	output_data_ = labels;
+	load_data(Dataset(caracteristicas, labels));
+}
+
+template <class T>
+void Population_alg<T> :: load_data(const Dataset & datos) {
+	data_ = datos;
+
+	// la muestra de la competicion y las filas del surrogate ya no corresponden a los datos
+	racing_ = Racing_evaluator();
+	surrogate_ = Surrogate_model();
 }
 
 template <class T>
 void Population_alg<T> :: read_data(const std::string data_file,
 							const char comment_char, const char delimiter){
-	// abrimos el fichero de lectura
-	auto resultado = preprocess::read_data<double>(data_file, comment_char, delimiter);
-
-	data_ = resultado.first;
-	output_data_ = resultado.second;
+	// los ficheros binarios se proyectan en memoria sin copiarlos
+	load_data(Dataset::load(data_file, comment_char, delimiter));
 
 }
 
 
 template <class T>
 int Population_alg<T> :: get_num_data() const {
-	return data_.size();
+	return data_.get_num_rows();
 }
 
 template <class T>
@@ -55,37 +60,65 @@ void Population_alg<T> :: generate_population(const unsigned population_size, co
 
 
 
+template <class T>
+void Population_alg<T> :: regenerate_population(const unsigned population_size) {
+	generate_population(population_size, expressions_depth_, probabilidad_variable_, true);
+}
+
+template <class T>
+unsigned Population_alg<T> :: get_population_size() const {
+	return population_.get_population_size();
+}
+
+template <class T>
+std::vector<T> Population_alg<T> :: get_best_individuals(const unsigned num_individuos) const {
+	const std::vector<int> indices = population_.get_best_indices(num_individuos);
+	std::vector<T> resultado;
+
+	resultado.reserve(indices.size());
+
+	for ( unsigned i = 0; i < indices.size(); i++) {
+		resultado.push_back(population_[indices[i]]);
+	}
+
+	return resultado;
+}
+
+template <class T>
+void Population_alg<T> :: receive_migrants(const std::vector<T> & inmigrantes) {
+	population_.replace_worst(inmigrantes);
+}
+
 template <class T>
 int Population_alg<T> :: get_num_variables() const {
-	return data_[0].size();
+	return data_.get_num_columns();
 }
 
 template <class T>
 std::vector<std::vector<double> > Population_alg<T> :: get_all_data() const {
-	return data_;
+	return data_.to_matrix();
 }
 
 template <class T>
 std::vector<double> Population_alg<T> :: get_data(const unsigned i) const {
-	return data_[i];
+	return data_.get_row_values(i);
 }
 
 template <class T>
 std::vector<double> Population_alg<T> :: get_all_output_data() const {
-	return output_data_;
+	return data_.get_labels();
 }
 
 
 template <class T>
 double Population_alg<T> :: get_output_data(const unsigned index) const {
-	return output_data_[index];
+	return data_.get_labels()[index];
 }
 
 template <class T>
 void Population_alg<T> :: initialize_empty() {
 	expressions_depth_ = 0;
-	data_.clear();
-	output_data_.clear();
+	data_ = Dataset();
 }
 
 
@@ -181,6 +214,104 @@ std::pair<bool, bool> Population_alg<T> :: apply_GP_mutations(T & son1, T & son2
 }
 
 
+template <class T>
+void Population_alg<T> :: evaluate_population(const Parameters & parameters) {
+
+	const aux::eval_function_t f_evaluacion = parameters.get_evaluation_functions();
+
+	if ( parameters.get_racing_sample_size() == 0 && !parameters.get_use_surrogate() ) {
+		population_.evaluate_population(data_, data_.get_labels(), f_evaluacion);
+	} else {
+		// tomamos la muestra solo cuando cambian los datos o la configuracion
+		if ( !racing_.same_configuration(parameters.get_racing_sample_size(),
+													parameters.get_racing_top_quantile(),
+													parameters.get_racing_confidence()) ) {
+			racing_ = Racing_evaluator(parameters.get_racing_sample_size(),
+												parameters.get_racing_top_quantile(),
+												parameters.get_racing_confidence());
+			racing_.prepare(data_, data_.get_labels());
+		}
+
+		std::vector<unsigned> pendientes = population_.get_unevaluated_individuals();
+		std::vector<unsigned> a_comprobar;
+
+		// caracteristicas de cada individuo para el surrogate, y si se evalua solo para comprobarlo
+		std::vector<Surrogate_model::Features> caracteristicas (population_.get_population_size());
+		std::vector<bool> comprobar (population_.get_population_size(), false);
+		double umbral_torneo = std::numeric_limits<double>::infinity();
+
+		if ( parameters.get_use_surrogate() ) {
+
+			if ( !surrogate_.is_prepared() ) {
+				surrogate_.prepare(data_, data_.get_labels());
+			}
+
+			std::vector<double> fitness_evaluados;
+
+			for ( unsigned i = 0; i < population_.get_population_size(); i++) {
+				if ( population_[i].is_evaluated() ) {
+					fitness_evaluados.push_back(population_[i].get_fitness());
+				}
+			}
+
+			umbral_torneo = Surrogate_model::tournament_threshold(fitness_evaluados, parameters.get_tournament_size());
+
+			Task_scheduler::global().parallel_for(0, pendientes.size(), 1, [&](const unsigned i) {
+				caracteristicas[pendientes[i]] = surrogate_.features(population_[pendientes[i]], f_evaluacion);
+			});
+
+			std::vector<unsigned> a_evaluar;
+
+			for ( unsigned i = 0; i < pendientes.size(); i++) {
+				const unsigned individuo = pendientes[i];
+
+				if ( !surrogate_.clearly_worse(caracteristicas[individuo], umbral_torneo) ) {
+					a_evaluar.push_back(individuo);
+				} else if ( Random::get_float() < parameters.get_surrogate_exploration_fraction() ) {
+					// exploramos una parte de los descartados para medir la precision del modelo,
+					// sin pasar por el racing para que su fitness sea siempre el real
+					a_comprobar.push_back(individuo);
+					comprobar[individuo] = true;
+				} else {
+					population_[individuo].set_estimated_fitness(surrogate_.predict(caracteristicas[individuo]));
+					surrogate_.record_skip();
+				}
+			}
+
+			pendientes = a_evaluar;
+		}
+
+		pendientes = population_.race_individuals(pendientes, racing_, f_evaluacion);
+
+		// los que se comprueban se evaluan siempre entero, en el orden de la poblacion
+		pendientes.insert(pendientes.end(), a_comprobar.begin(), a_comprobar.end());
+		std::sort(pendientes.begin(), pendientes.end());
+
+		population_.evaluate_individuals(pendientes, data_, data_.get_labels(), f_evaluacion);
+
+		if ( parameters.get_use_surrogate() ) {
+			// el modelo aprende de las evaluaciones reales
+			for ( unsigned i = 0; i < pendientes.size(); i++) {
+				const unsigned individuo = pendientes[i];
+
+				surrogate_.train(caracteristicas[individuo], population_[individuo].get_fitness());
+
+				if ( comprobar[individuo] ) {
+					surrogate_.record_check(population_[individuo].get_fitness() > umbral_torneo);
+				}
+			}
+
+			if ( parameters.get_show_evaluation() ) {
+				std::clog << "# surrogate skipped: " << surrogate_.get_num_skipped()
+							 << "\tprecision: " << surrogate_.precision() << std::endl;
+			}
+		}
+
+		population_.search_best_individual(data_, data_.get_labels(), f_evaluacion);
+	}
+
+}
+
 template <class T>
 double Population_alg<T> :: predict(const std::vector<double> & dato) const {
 	double resultado = population_.get_best_individual().evaluate_data(dato);
@@ -195,19 +326,392 @@ std::vector<double> Population_alg<T> :: predict(const std::vector<std::vector<d
 
 	resultado.resize(data.size());
 
-	#pragma omp parallel for
-	for ( unsigned i = 0; i < data.size(); i++) {
+	Task_scheduler::global().parallel_for(0, data.size(), PREDICT_GRAIN, [&](const unsigned i) {
 		resultado[i] = predict(data[i]);
+	});
+
+	return resultado;
+}
+
+
+template <class T>
+std::vector<double> Population_alg<T> :: predict(const Dataset & data) const {
+
+	std::vector<double> resultado (data.get_num_rows());
+
+	const T & mejor = population_[population_.get_best_individual_index()];
+	const unsigned filas_ventana = std::max(data.get_stream_rows(), 1u);
+
+	// unos datos proyectados se predicen por ventanas, leyendo la siguiente mientras tanto
+	for ( unsigned inicio = 0; inicio < data.get_num_rows(); inicio += filas_ventana) {
+		const unsigned fin = std::min(inicio + filas_ventana, data.get_num_rows());
+
+		data.prefetch_rows(fin, std::min(fin + filas_ventana, data.get_num_rows()));
+
+		Task_scheduler::global().parallel_for(inicio, fin, PREDICT_GRAIN, [&](const unsigned i) {
+			resultado[i] = mejor.evaluate_data(data.get_row(i), data.get_column_stride());
+		});
+
+		data.release_rows(inicio, fin);
 	}
 
 	return resultado;
 }
 
 
+template <class T>
+void Population_alg<T> :: fit(const Dataset & data, const Parameters & parameters) {
+	load_data(data);
+
+	fit(parameters);
+}
+
+template <class T>
+unsigned Population_alg<T> :: steady_state_tournament(const std::vector<std::atomic<double> > & fitness,
+																		const unsigned tam_torneo, const bool mejor) {
+	unsigned ganador = Random::get_int(fitness.size());
+	double fitness_ganador = fitness[ganador].load(std::memory_order_relaxed);
+
+	for ( unsigned i = 1; i < tam_torneo; i++) {
+		const unsigned participante = Random::get_int(fitness.size());
+		const double fitness_participante = fitness[participante].load(std::memory_order_relaxed);
+
+		// un NaN nunca gana a un fitness valido en el torneo de los mejores, y siempre en el de los peores
+		const bool participante_mejor = !std::isnan(fitness_participante) &&
+												  ( std::isnan(fitness_ganador) || fitness_participante < fitness_ganador );
+		const bool participante_peor = !std::isnan(fitness_ganador) &&
+												 ( std::isnan(fitness_participante) || fitness_participante > fitness_ganador );
+
+		if ( mejor ? participante_mejor : participante_peor ) {
+			ganador = participante;
+			fitness_ganador = fitness_participante;
+		}
+	}
+
+	return ganador;
+}
+
+template <class T>
+template <class Breed>
+void Population_alg<T> :: breed_pairs(const std::vector<std::pair<unsigned, unsigned> > & parejas,
+												  const Breed & cruzar) {
+
+	// cada bloque de parejas tiene su propia secuencia de aleatorios, derivada de una unica
+	// semilla, asi los hijos no dependen del numero de hebras
+	const unsigned long semilla = Random::get_int(std::numeric_limits<int>::max());
+	const unsigned num_bloques = (parejas.size() + BREED_BLOCK_SIZE - 1) / BREED_BLOCK_SIZE;
+
+	// la hebra actual tambien cruza bloques, conservamos su generador
+	const std::mt19937 generador = Random::get_generator();
+
+	Task_scheduler::global().parallel_for(0, num_bloques, 1, [&](const unsigned bloque) {
+		Random::set_seed(Fold_executor::fold_seed(semilla, bloque));
+
+		T son1, son2;
+		const unsigned fin = std::min<std::size_t>((bloque + 1) * BREED_BLOCK_SIZE, parejas.size());
+
+		for ( unsigned pareja = bloque * BREED_BLOCK_SIZE; pareja < fin; pareja++) {
+			const unsigned mom = parejas[pareja].first;
+			const unsigned parent = parejas[pareja].second;
+
+			const auto modificados = cruzar(pareja, population_[mom], population_[parent], son1, son2);
+
+			// guardamos el fitness de los padres antes de sustituirlos
+			const double fitness_madre = population_[mom].get_fitness();
+			const double fitness_padre = population_[parent].get_fitness();
+
+			if ( modificados.first ) {
+				population_[mom] = std::move(son1);
+				population_[mom].no_longer_evaluated();
+				population_[mom].set_parents_fitness(fitness_madre, fitness_padre);
+			}
+
+			if ( modificados.second ) {
+				population_[parent] = std::move(son2);
+				population_[parent].no_longer_evaluated();
+				population_[parent].set_parents_fitness(fitness_padre, fitness_madre);
+			}
+		}
+	});
+
+	Random::set_generator(generador);
+
+}
+
+template <class T>
+void Population_alg<T> :: fit_steady_state(const Parameters & parameters) {
+
+	const aux::eval_function_t f_evaluacion = parameters.get_evaluation_functions();
+	const unsigned tam = population_.get_population_size();
+	const unsigned tam_torneo = std::max(parameters.get_tournament_size(), 1);
+	const long max_hijos = parameters.get_num_evaluations();
+	const int num_generaciones = max_hijos / static_cast<double>(tam);
+
+	population_.evaluate_population(data_, data_.get_labels(), f_evaluacion);
+
+	// copia del fitness para los torneos, que se leen sin bloquear a los individuos
+	std::vector<std::atomic<double> > fitness (tam);
+	std::vector<std::mutex> cerrojos (tam);
+
+	for ( unsigned i = 0; i < tam; i++) {
+		fitness[i].store(population_[i].get_fitness());
+	}
+
+	std::atomic<long> hijos (0);
+	std::atomic<double> mejor_fitness (population_.get_best_individual().get_fitness());
+	std::mutex cerrojo_salida;
+
+	// una tarea por hebra, cada una con su secuencia de aleatorios derivada de una unica semilla
+	const unsigned long semilla = Random::get_int(std::numeric_limits<int>::max());
+	const std::mt19937 generador = Random::get_generator();
+	const unsigned num_tareas = tam > 1 ? Task_scheduler::global().get_num_threads() : 1;
+
+	Task_scheduler::global().parallel_for(0, num_tareas, 1, [&](const unsigned tarea) {
+		Random::set_seed(Fold_executor::fold_seed(semilla, tarea));
+
+		T madre, padre, son1, son2;
+		long primer_hijo;
+
+		// cada cruce reserva dos hijos del presupuesto, la tarea sigue mientras quede alguno
+		while ( (primer_hijo = hijos.fetch_add(2)) < max_hijos ) {
+			const unsigned i_madre = steady_state_tournament(fitness, tam_torneo, true);
+			const unsigned i_padre = steady_state_tournament(fitness, tam_torneo, true);
+
+			{
+				std::lock_guard<std::mutex> cerrojo (cerrojos[i_madre]);
+				madre = population_[i_madre];
+			}
+
+			{
+				std::lock_guard<std::mutex> cerrojo (cerrojos[i_padre]);
+				padre = population_[i_padre];
+			}
+
+			const auto modificados = breed(madre, padre, son1, son2, parameters,
+													 primer_hijo / tam, num_generaciones);
+
+			T * hijos_cruce[2] = {&son1, &son2};
+			const bool modificado[2] = {modificados.first, modificados.second && primer_hijo + 1 < max_hijos};
+
+			for ( unsigned h = 0; h < 2; h++) {
+				if ( modificado[h] ) {
+					T & hijo = *hijos_cruce[h];
+
+					hijo.no_longer_evaluated();
+					hijo.set_parents_fitness(h == 0 ? madre.get_fitness() : padre.get_fitness(),
+													 h == 0 ? padre.get_fitness() : madre.get_fitness());
+					hijo.evaluate_expression(data_, data_.get_labels(), f_evaluacion);
+
+					const double fitness_hijo = hijo.get_fitness();
+					const unsigned victima = steady_state_tournament(fitness, tam_torneo, false);
+
+					std::lock_guard<std::mutex> cerrojo (cerrojos[victima]);
+
+					// otra hebra puede haber sustituido a la victima desde el torneo
+					const double fitness_victima = fitness[victima].load();
+
+					if ( !std::isnan(fitness_hijo) && ( std::isnan(fitness_victima) || fitness_hijo <= fitness_victima ) ) {
+						population_[victima] = std::move(hijo);
+						fitness[victima].store(fitness_hijo);
+
+						double mejor = mejor_fitness.load();
+
+						while ( fitness_hijo < mejor && !mejor_fitness.compare_exchange_weak(mejor, fitness_hijo) ) {
+						}
+					}
+				}
+			}
+
+			// se muestra el mejor cada tantos hijos como individuos, como una generacion
+			if ( parameters.get_show_evaluation() && (primer_hijo + 2) / tam != primer_hijo / tam ) {
+				std::lock_guard<std::mutex> cerrojo (cerrojo_salida);
+				std::cout << (primer_hijo + 2) / tam - 1 << "\t" << mejor_fitness.load() << std::endl;
+			}
+		}
+	});
+
+	Random::set_generator(generador);
+
+	population_.search_best_individual();
+
+}
+
+template <class T>
+unsigned Population_alg<T> :: pipeline_tournament(const std::vector<T> & generacion,
+																  const std::vector<unsigned> & evaluados,
+																  const unsigned num_evaluados, const unsigned tam_torneo) {
+	unsigned ganador = evaluados[Random::get_int(num_evaluados)];
+
+	for ( unsigned i = 1; i < tam_torneo; i++) {
+		const unsigned participante = evaluados[Random::get_int(num_evaluados)];
+		const double fitness_participante = generacion[participante].get_fitness();
+		const double fitness_ganador = generacion[ganador].get_fitness();
+
+		// un NaN nunca gana a un fitness valido
+		if ( !std::isnan(fitness_participante) &&
+			  ( std::isnan(fitness_ganador) || fitness_participante < fitness_ganador ) ) {
+			ganador = participante;
+		}
+	}
+
+	return ganador;
+}
+
+template <class T>
+void Population_alg<T> :: fit_pipelined(const Parameters & parameters) {
+
+	const aux::eval_function_t f_evaluacion = parameters.get_evaluation_functions();
+	const unsigned tam = population_.get_population_size();
+	const unsigned tam_torneo = std::max(parameters.get_tournament_size(), 1);
+	const int num_generaciones = parameters.get_num_evaluations() / static_cast<double>(tam);
+
+	population_.evaluate_population(data_, data_.get_labels(), f_evaluacion);
+
+	if ( num_generaciones <= 0 || tam < 2 ) {
+		return;
+	}
+
+	const unsigned num_parejas = (tam + 1) / 2;
+	const long num_cruces = static_cast<long>(num_generaciones) * num_parejas;
+
+	// individuos evaluados de una generacion antes de empezar la seleccion de la siguiente
+	const unsigned umbral = std::min(std::max(static_cast<unsigned>(std::ceil(parameters.get_pipeline_ready_fraction() * tam)),
+															tam_torneo), tam);
+
+	// tres generaciones en vuelo: la que se selecciona, la que se genera, y la anterior a
+	// ambas, cuyo hueco se reutiliza cuando ya no la lee nadie
+	std::vector<std::vector<T> > generaciones (3, std::vector<T>(tam, T(0)));
+
+	// posiciones evaluadas de cada generacion en el orden en el que se evaluaron, y cuantas son
+	std::vector<std::vector<unsigned> > evaluados (3, std::vector<unsigned>(tam));
+	std::vector<std::mutex> cerrojos_evaluados (3);
+	std::vector<std::atomic<unsigned> > num_evaluados (num_generaciones + 1);
+
+	for ( unsigned i = 0; i < tam; i++) {
+		generaciones[0][i] = population_[i];
+		evaluados[0][i] = i;
+	}
+
+	for ( unsigned g = 0; g < num_evaluados.size(); g++) {
+		num_evaluados[g].store(g == 0 ? tam : 0);
+	}
+
+	// el mejor individuo encontrado, que ocupa el primer hueco de cada generacion
+	T mejor = population_.get_best_individual();
+	std::mutex cerrojo_mejor;
+	std::mutex cerrojo_salida;
+
+	std::atomic<long> siguiente (0);
+
+	// cada cruce tiene su secuencia de aleatorios, derivada de una unica semilla
+	const unsigned long semilla = Random::get_int(std::numeric_limits<int>::max());
+	const std::mt19937 generador = Random::get_generator();
+	const unsigned num_tareas = Task_scheduler::global().get_num_threads();
+
+	Task_scheduler::global().parallel_for(0, num_tareas, 1, [&](const unsigned) {
+		T son1, son2;
+		long cruce;
+
+		// los cruces se toman en orden, asi el primero sin terminar nunca tiene que esperar
+		while ( (cruce = siguiente++) < num_cruces ) {
+			const unsigned generacion = cruce / num_parejas + 1;
+			const unsigned pareja = cruce % num_parejas;
+			const std::vector<T> & anterior = generaciones[(generacion - 1) % 3];
+			std::vector<T> & actual = generaciones[generacion % 3];
+
+			// esperamos a que haya bastantes evaluados en la generacion anterior y a que la
+			// generacion cuyo hueco se reutiliza ya no sea seleccionable
+			while ( num_evaluados[generacion - 1].load(std::memory_order_acquire) < umbral ||
+					  ( generacion >= 2 && num_evaluados[generacion - 2].load(std::memory_order_acquire) < tam ) ) {
+				std::this_thread::yield();
+			}
+
+			Random::set_seed(Fold_executor::fold_seed(semilla, cruce));
+
+			const unsigned disponibles = num_evaluados[generacion - 1].load(std::memory_order_acquire);
+			const std::vector<unsigned> & candidatos = evaluados[(generacion - 1) % 3];
+			const T & madre = anterior[pipeline_tournament(anterior, candidatos, disponibles, tam_torneo)];
+			const T & padre = anterior[pipeline_tournament(anterior, candidatos, disponibles, tam_torneo)];
+
+			const auto modificados = breed(madre, padre, son1, son2, parameters, generacion - 1, num_generaciones);
+
+			T * hijos[2] = {&son1, &son2};
+			const bool modificado[2] = {modificados.first, modificados.second};
+
+			for ( unsigned h = 0; h < 2 && 2 * pareja + h < tam; h++) {
+				const unsigned hueco = 2 * pareja + h;
+
+				if ( hueco == 0 ) {
+					std::lock_guard<std::mutex> cerrojo (cerrojo_mejor);
+					actual[hueco] = mejor;
+				} else {
+					T & hijo = *hijos[h];
+
+					// un hijo sin cambios conserva el fitness de su padre
+					if ( modificado[h] ) {
+						hijo.no_longer_evaluated();
+						hijo.set_parents_fitness(h == 0 ? madre.get_fitness() : padre.get_fitness(),
+														 h == 0 ? padre.get_fitness() : madre.get_fitness());
+						hijo.evaluate_expression(data_, data_.get_labels(), f_evaluacion);
+
+						const double fitness_hijo = hijo.get_fitness();
+						std::lock_guard<std::mutex> cerrojo (cerrojo_mejor);
+
+						if ( !std::isnan(fitness_hijo) && ( std::isnan(mejor.get_fitness()) || fitness_hijo < mejor.get_fitness() ) ) {
+							mejor = hijo;
+						}
+					}
+
+					actual[hueco] = std::move(hijo);
+				}
+
+				// el hueco ya puede entrar en los torneos de la siguiente generacion
+				unsigned evaluados_generacion;
+
+				{
+					std::lock_guard<std::mutex> cerrojo (cerrojos_evaluados[generacion % 3]);
+					evaluados_generacion = num_evaluados[generacion].load(std::memory_order_relaxed);
+					evaluados[generacion % 3][evaluados_generacion] = hueco;
+					num_evaluados[generacion].store(evaluados_generacion + 1, std::memory_order_release);
+				}
+
+				if ( parameters.get_show_evaluation() && evaluados_generacion + 1 == tam ) {
+					std::lock_guard<std::mutex> cerrojo (cerrojo_salida);
+					std::lock_guard<std::mutex> cerrojo_fitness (cerrojo_mejor);
+					std::cout << generacion - 1 << "\t" << mejor.get_fitness() << std::endl;
+				}
+			}
+		}
+	});
+
+	Random::set_generator(generador);
+
+	std::vector<T> & ultima = generaciones[num_generaciones % 3];
+
+	for ( unsigned i = 0; i < tam; i++) {
+		population_[i] = std::move(ultima[i]);
+	}
+
+	// el mejor de la ultima generacion puede haberse encontrado despues de llenar su primer hueco
+	population_.search_best_individual();
+	apply_elitism(mejor);
+	population_.search_best_individual();
+
+}
+
 template <class T>
 std::pair<T, std::vector<std::vector<double> > > Population_alg<T> :: fit_cv_files( std::pair<matriz<double>, std::vector<double> > & datos_train,  std::pair<matriz<double>, std::vector<double> > &  datos_test, 
 														const Parameters & parameters){
 
+	return fit_cv_files(Dataset(datos_train.first, datos_train.second),
+							  Dataset(datos_test.first, datos_test.second), parameters);
+}
+
+template <class T>
+std::pair<T, std::vector<std::vector<double> > > Population_alg<T> :: fit_cv_files(const Dataset & datos_train,
+														const Dataset & datos_test,
+														const Parameters & parameters){
+
 	std::vector<std::vector<double >> errores;
 	errores.resize(parameters.get_num_evaluation_functions() + 1);
 
@@ -220,7 +724,7 @@ std::pair<T, std::vector<std::vector<double> > > Population_alg<T> :: fit_cv_fil
 
 	//auto train_datos_aleatorios = preprocess::random_data_reorder(datos_train.first, datos_train.second);
 	//load_data(train_datos_aleatorios.first, train_datos_aleatorios.second);
-	load_data(datos_train.first, datos_train.second);
+	load_data(datos_train);
 
 	// generamos una nueva población en cada iteración, para asegurarnos que cada fold es independiente
 	generate_population(population_.get_population_size(), expressions_depth_, probabilidad_variable_, true);
@@ -231,14 +735,19 @@ std::pair<T, std::vector<std::vector<double> > > Population_alg<T> :: fit_cv_fil
 	// predecimos test para mirar el error
 	//auto test_datos_aleatorios = preprocess::random_data_reorder(datos_test.first, datos_test.second);
 	//auto predicciones = predict(test_datos_aleatorios.first);
-	auto predicciones = predict(datos_test.first);
+	auto predicciones = predict(datos_test);
 
-	// rellenamos el error de la función de evaluación con la que entrenamos
-	errores[0][0] = parameters.get_evaluation_functions()(predicciones, datos_test.second);
+	// el error de la función de evaluación con la que entrenamos y todos los otros, en una sola pasada
+	std::vector<aux::eval_function_t> funciones (1, parameters.get_evaluation_functions());
 
-	// calculamos todos los otros errores
 	for (unsigned j = 0; j < parameters.get_num_evaluation_functions(); j++) {
-		errores[j + 1][0]= parameters.get_error_function(j)(predicciones, datos_test.second);
+		funciones.push_back(parameters.get_error_function(j));
+	}
+
+	const aux::Metrics metricas = aux::compute_metrics(predicciones, datos_test.get_labels(), funciones);
+
+	for (unsigned j = 0; j < errores.size(); j++) {
+		errores[j][0] = metricas.values[j];
 	}
 
 	mejor_expresion = get_best_individual();
@@ -251,12 +760,13 @@ template <class T>
 std::pair<T, std::vector<std::vector<double> > > Population_alg<T> :: perform_k_cross_validation(const unsigned numero_val_cruzada,
 				 									 const Parameters & parameters) {
 
-	const std::vector<std::vector<double> > datos_originales = data_;
-	const std::vector<double> etiquetas_originales = output_data_;
+	// reordenamos los indices, no los datos
+	const auto permutacion = preprocess::random_permutation(data_.get_num_rows());
 
-	auto resultado_datos_aleatorios = preprocess::random_data_reorder(data_, output_data_);
+	// cada fold tiene su propia secuencia de aleatorios, derivada de una unica semilla
+	const unsigned long semilla = Random::get_int(std::numeric_limits<int>::max());
 
-	const int NUM_DATOS_TEST_ITERACION = data_.size() / numero_val_cruzada;
+	const int NUM_DATOS_TEST_ITERACION = data_.get_num_rows() / numero_val_cruzada;
 
 	std::vector<std::vector<double >> errores;
 	errores.resize(parameters.get_num_evaluation_functions() + 1);
@@ -265,44 +775,67 @@ std::pair<T, std::vector<std::vector<double> > > Population_alg<T> :: perform_k_
 		errores[i].resize(numero_val_cruzada);
 	}
 
-	double error_mejor = std::numeric_limits<double>::infinity();
-	T mejor_expresion;
+	std::vector<T> mejores (numero_val_cruzada);
+
+	Fold_executor ejecutor (numero_val_cruzada);
+
+	// los folds son independientes, cada uno con su copia del algoritmo
+	ejecutor.run([&](const unsigned i) {
+		Random::set_seed(Fold_executor::fold_seed(semilla, i));
 
-	// para cada iteracion de la validación cruzada;
-	for ( unsigned i = 0; i < numero_val_cruzada; i++) {
 		// tenemos que hacer la separacion en train/test para esta iteracion
-		auto train_test_separado = preprocess::split_train_test<double>(resultado_datos_aleatorios.first,
-																				resultado_datos_aleatorios.second,
-																				1.0/numero_val_cruzada,
-																				NUM_DATOS_TEST_ITERACION * i);
+		auto train_test_separado = preprocess::split_indices(permutacion, 1.0/numero_val_cruzada,
+																			  NUM_DATOS_TEST_ITERACION * i);
+
+		// cada fold es una vista de los datos originales, solo se copian sus etiquetas
+		const Dataset datos_test = data_.view_rows(std::move(train_test_separado.second));
 
-		load_data(train_test_separado.first.first, train_test_separado.first.second);
+		auto fold = clone();
 
 		// generamos una nueva población en cada iteración, para asegurarnos que cada fold es independiente
-		generate_population(population_.get_population_size(), expressions_depth_, probabilidad_variable_, true);
+		fold->generate_population(population_.get_population_size(), expressions_depth_, probabilidad_variable_, true);
 
 		// ajustamos para estos nuevos valores
-		fit(parameters);
+		fold->fit(data_.view_rows(std::move(train_test_separado.first)), parameters);
 
 		// predecimos test para mirar el error
-		auto predicciones = predict(train_test_separado.second.first);
+		auto predicciones = fold->predict(datos_test);
 
-		// rellenamos el error de la función de evaluación con la que entrenamos
-		errores[0][i] = parameters.get_evaluation_functions()(predicciones, train_test_separado.second.second);
+		// el error de la función de evaluación con la que entrenamos y todos los otros, en una sola pasada
+		std::vector<aux::eval_function_t> funciones (1, parameters.get_evaluation_functions());
 
-		// calculamos todos los otros errores
 		for (unsigned j = 0; j < parameters.get_num_evaluation_functions(); j++) {
-			errores[j + 1][i] = parameters.get_error_function(j)(predicciones, train_test_separado.second.second);
+			funciones.push_back(parameters.get_error_function(j));
 		}
 
-		if (errores[0][i] < error_mejor) {
-			mejor_expresion = get_best_individual();
+		const aux::Metrics metricas = aux::compute_metrics(predicciones, datos_test.get_labels(), funciones);
+
+		for (unsigned j = 0; j < errores.size(); j++) {
+			errores[j][i] = metricas.values[j];
+		}
+
+		mejores[i] = fold->get_best_individual();
+	});
+
+	if ( parameters.get_show_evaluation() ) {
+		for ( unsigned i = 0; i < numero_val_cruzada; i++) {
+			std::clog << "# fold " << i << ": " << ejecutor.get_fold_times()[i] << " s" << std::endl;
 		}
 
+		std::clog << "# folds: " << ejecutor.get_concurrent_folds() << " concurrent, "
+					 << ejecutor.get_wall_time() << " s, speedup " << ejecutor.get_speedup() << std::endl;
 	}
 
-	// reestablecer data originales
-	load_data(datos_originales, etiquetas_originales);
+	// la mejor expresion es la del fold con menor error de test
+	double error_mejor = std::numeric_limits<double>::infinity();
+	T mejor_expresion;
+
+	for ( unsigned i = 0; i < numero_val_cruzada; i++) {
+		if (errores[0][i] < error_mejor) {
+			mejor_expresion = mejores[i];
+			error_mejor = errores[0][i];
+		}
+	}
 
 	return std::make_pair(mejor_expresion, errores);
 
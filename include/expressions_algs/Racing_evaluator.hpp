@@ -0,0 +1,170 @@
+/**
+  * \@file Racing_evaluator.hpp
+  * @brief Header file of the Racing_evaluator class
+  *
+  */
+
+#ifndef RACING_EVALUATOR_H_INCLUDED
+#define RACING_EVALUATOR_H_INCLUDED
+
+#include "expressions_algs/Expression.hpp"
+#include "expressions_algs/aux_expressions_alg.hpp"
+
+namespace expressions_algs {
+
+/**
+  *  @brief Racing_evaluator Class
+  *
+  *  An instance of type Racing_evaluator scores expressions on a small stratified
+  *  sample of the data, so only the promising offspring have to be evaluated
+  *  on the whole data set.
+  *
+  *
+  * @author Antonio David Villegas Yeguas
+  * @date Octubre 2026
+  */
+
+class Racing_evaluator {
+	private:
+
+		/**
+		  * @page repRacing_evaluator Representation of the Racing_evaluator class
+		  *
+		  * @section invRacing_evaluator Representation invariant
+		  *
+		  * sample_data_.size == sample_labels_.size
+		  *
+		  * @section faRacing_evaluator Abstraction function
+		  *
+		  * A valid object @e rep of class Racing_evaluator represents a sample of the data
+		  *
+		  * rep.sample_data_
+		  * rep.sample_labels_
+		  *
+		  * Sorted by label, so each batch of the sample, taking one row every
+		  * rep.num_batches_, is also stratified.
+		  *
+		  */
+
+		/**
+		  * @brief Number of rows of the sample
+		  */
+
+		unsigned sample_size_;
+
+		/**
+		  * @brief Quantile of the population fitness that an estimation has to reach
+		  */
+
+		double top_quantile_;
+
+		/**
+		  * @brief Number of standard errors of the confidence interval
+		  */
+
+		double confidence_;
+
+		/**
+		  * @brief Number of batches in which the sample is split to estimate the error variance
+		  */
+
+		unsigned num_batches_;
+
+		/**
+		  * @brief Rows of the sample, sorted by label
+		  */
+
+		std::vector<std::vector<double> > sample_data_;
+
+		/**
+		  * @brief Labels of the rows of the sample
+		  */
+
+		std::vector<double> sample_labels_;
+
+	public:
+
+		/**
+		  * @brief Constructor with four parameters.
+		  *
+		  * @param sample_size Number of rows of the sample. 0 disables racing.
+		  * @param top_quantile Quantile of the population fitness an estimation has to reach.
+		  * @param confidence Number of standard errors of the confidence interval.
+		  * @param num_batches Number of batches in which the sample is split.
+		  *
+		  */
+
+		Racing_evaluator(const unsigned sample_size = 0, const double top_quantile = 0.25,
+							  const double confidence = 2.0, const unsigned num_batches = 8);
+
+		/**
+		  * @brief Take the stratified sample of the data.
+		  *
+		  * @param data Data from where to take the sample.
+		  * @param labels Labels associated to data.
+		  *
+		  * @post If the data is not big enough to be worth racing, the evaluator is not active.
+		  */
+
+		void prepare(const Dataset & data,
+						 const std::vector<double> & labels);
+
+		/**
+		  * @brief Check if the evaluator has a sample to race the expressions.
+		  *
+		  * @return True if the evaluator is active.
+		  */
+
+		bool is_active() const;
+
+		/**
+		  * @brief Check if the evaluator was built with the given configuration.
+		  *
+		  * @param sample_size Number of rows of the sample.
+		  * @param top_quantile Quantile of the population fitness.
+		  * @param confidence Number of standard errors of the confidence interval.
+		  *
+		  * @return True if the configuration matches.
+		  */
+
+		bool same_configuration(const unsigned sample_size, const double top_quantile,
+										const double confidence) const;
+
+		/**
+		  * @brief Estimate the fitness of an expression on the sample.
+		  *
+		  * @param exp Expression to estimate.
+		  * @param evaluation_f Function used to evaluate the expression.
+		  *
+		  * @return Pair with the error on the sample and its standard error.
+		  */
+
+		std::pair<double, double> estimate(const Expression & exp,
+													  aux::eval_function_t evaluation_f) const;
+
+		/**
+		  * @brief Obtain the fitness of the top quantile of a set of fitness values.
+		  *
+		  * @param fitness Fitness values of the reference individuals.
+		  *
+		  * @return Fitness threshold to promote an expression.
+		  */
+
+		double threshold(const std::vector<double> & fitness) const;
+
+		/**
+		  * @brief Check if the confidence interval of an estimation overlaps the top quantile.
+		  *
+		  * @param estimation Pair with the estimated error and its standard error.
+		  * @param threshold Fitness threshold obtained with threshold().
+		  *
+		  * @return True if the expression has to be fully evaluated.
+		  */
+
+		bool promote(const std::pair<double, double> & estimation, const double threshold) const;
+
+};
+
+} // namespace expressions_algs
+
+#endif
@@ -0,0 +1,228 @@
+/**
+  * \@file Socket_channel.hpp
+  * @brief Header file of the Socket_channel class
+  *
+  */
+
+#ifndef SOCKET_CHANNEL_H_INCLUDED
+#define SOCKET_CHANNEL_H_INCLUDED
+
+#include <cstdint>
+#include <string>
+
+namespace expressions_algs {
+
+/**
+  *  @brief Socket_channel Class
+  *
+  *  An instance of type Socket_channel is a stream socket, either listening
+  *  for connections or connected to another process, that exchanges framed
+  *  messages. The address of a socket is "unix:<path>" for a Unix domain
+  *  socket or "tcp:<host>:<port>" for a TCP socket; port 0 listens on a port
+  *  chosen by the kernel, which get_address returns afterwards.
+  *
+  *  A message is a header with its type and the length of its payload,
+  *  followed by the payload. The header is native endian, so both ends must
+  *  run on machines of the same architecture.
+  *
+  *
+  * @author Antonio David Villegas Yeguas
+  * @date Octubre 2026
+  */
+
+class Socket_channel {
+	private:
+
+		/**
+		  * @page repSocket_channel Representation of the Socket_channel class
+		  *
+		  * @section invSocket_channel Representation invariant
+		  *
+		  * descriptor_ >= 0 if the channel is open and -1 otherwise, and listening_
+		  * implies that descriptor_ is a listening socket bound to address_
+		  *
+		  * @section faSocket_channel Abstraction function
+		  *
+		  * A valid object @e rep of class Socket_channel represents the socket
+		  *
+		  * rep.descriptor_
+		  *
+		  * bound or connected to rep.address_
+		  *
+		  */
+
+		/**
+		  * @brief File descriptor of the socket, -1 if it is closed
+		  */
+
+		int descriptor_;
+
+		/**
+		  * @brief Address where the socket listens or to which it is connected
+		  */
+
+		std::string address_;
+
+		/**
+		  * @brief True if the socket listens for connections
+		  */
+
+		bool listening_;
+
+		/**
+		  * @brief Make a channel from an already connected socket.
+		  *
+		  * @param descriptor File descriptor of the socket.
+		  * @param address Address of the socket.
+		  */
+
+		Socket_channel(const int descriptor, const std::string & address);
+
+		/**
+		  * @brief Write all the bytes of a buffer, retrying after partial writes and signals.
+		  *
+		  * @param data Bytes to write.
+		  * @param size Number of bytes.
+		  *
+		  * @return True if all the bytes were written.
+		  */
+
+		bool write_all(const char * data, std::size_t size);
+
+		/**
+		  * @brief Read a number of bytes, retrying after partial reads and signals.
+		  *
+		  * @param data Where the bytes are stored.
+		  * @param size Number of bytes.
+		  *
+		  * @return True if all the bytes were read, false if the connection was closed before.
+		  */
+
+		bool read_all(char * data, std::size_t size);
+
+	public:
+
+		/**
+		  * @brief Maximum length, in bytes, of the payload of a message
+		  */
+
+		static const std::uint64_t MAX_PAYLOAD = std::uint64_t(1) << 30;
+
+		/**
+		  * @brief Default constructor, closed channel.
+		  */
+
+		Socket_channel();
+
+		/**
+		  * @brief Move constructor.
+		  *
+		  * @param another Channel to move, left closed.
+		  */
+
+		Socket_channel(Socket_channel && another) noexcept;
+
+		/**
+		  * @brief Move assignment, closes the socket of this channel first.
+		  *
+		  * @param another Channel to move, left closed.
+		  *
+		  * @return Reference to this channel.
+		  */
+
+		Socket_channel & operator= (Socket_channel && another) noexcept;
+
+		Socket_channel(const Socket_channel & another) = delete;
+		Socket_channel & operator= (const Socket_channel & another) = delete;
+
+		/**
+		  * @brief Destructor, closes the socket.
+		  */
+
+		~Socket_channel();
+
+		/**
+		  * @brief Listen for connections on an address. A Unix domain socket file that
+		  * already exists is replaced, and it is removed when the channel is closed.
+		  *
+		  * @param address Address where to listen.
+		  * @param backlog Maximum number of pending connections.
+		  *
+		  * @return True if the socket is listening.
+		  */
+
+		bool listen(const std::string & address, const int backlog = 64);
+
+		/**
+		  * @brief Wait for a connection.
+		  *
+		  * @pre The channel is listening.
+		  *
+		  * @return Channel connected to the other process, closed if the connection failed.
+		  */
+
+		Socket_channel accept();
+
+		/**
+		  * @brief Connect to a listening socket, retrying while it does not exist yet.
+		  *
+		  * @param address Address of the listening socket.
+		  * @param attempts Maximum number of attempts.
+		  * @param wait_ms Milliseconds to wait between two attempts.
+		  *
+		  * @return True if the channel is connected.
+		  */
+
+		bool connect(const std::string & address, const unsigned attempts = 100,
+						 const unsigned wait_ms = 100);
+
+		/**
+		  * @brief Send a message.
+		  *
+		  * @param type Type of the message.
+		  * @param payload Content of the message.
+		  *
+		  * @return True if the whole message was sent.
+		  */
+
+		bool send(const std::uint32_t type, const std::string & payload);
+
+		/**
+		  * @brief Wait for a message.
+		  *
+		  * @param type Where the type of the message is stored.
+		  * @param payload Where the content of the message is stored.
+		  *
+		  * @return True if a whole message was received, false if the connection was closed
+		  * or the header is not valid.
+		  */
+
+		bool receive(std::uint32_t & type, std::string & payload);
+
+		/**
+		  * @brief Check if the socket is open.
+		  *
+		  * @return True if the channel is listening or connected.
+		  */
+
+		bool is_open() const;
+
+		/**
+		  * @brief Get the address of the socket, with the real port if it listens on port 0.
+		  *
+		  * @return Address of the socket.
+		  */
+
+		const std::string & get_address() const;
+
+		/**
+		  * @brief Close the socket. Does nothing if it is already closed.
+		  */
+
+		void close();
+
+};
+
+} // namespace expressions_algs
+
+#endif
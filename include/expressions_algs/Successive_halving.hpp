@@ -0,0 +1,188 @@
+/**
+  * \@file Successive_halving.hpp
+  * @brief Header file of the Successive_halving class
+  *
+  */
+
+#ifndef SUCCESSIVE_HALVING_H_INCLUDED
+#define SUCCESSIVE_HALVING_H_INCLUDED
+
+#include "expressions_algs/Population_alg.hpp"
+
+#include <limits>
+#include <numeric>
+
+namespace expressions_algs {
+
+/**
+  *  @brief Successive_halving Class
+  *
+  *  An instance of type Successive_halving searches the best Parameters for an
+  *  algorithm among a set of candidates with successive halving. Every
+  *  candidate starts from a copy of the same algorithm with a small budget of
+  *  evaluations; after each rung the candidates are ranked by their error on
+  *  a validation dataset, the best 1/eta of them are kept and their budget is
+  *  multiplied by eta. A promoted candidate keeps training its own population
+  *  (and its own random generator) instead of starting again, and the
+  *  candidates of a rung are trained concurrently with a Fold_executor.
+  *
+  * @tparam T Type of the individuals of the algorithm
+  *
+  * @author Antonio David Villegas Yeguas
+  * @date Octubre 2026
+  */
+
+template <class T>
+class Successive_halving {
+	private:
+
+		/**
+		  * @page repSuccessive_halving Representation of the Successive_halving class
+		  *
+		  * @section invSuccessive_halving Representation invariant
+		  *
+		  * candidates_.size == scores_.size == rungs_.size == evaluations_.size, eta_ >= 2
+		  * and min_evaluations_ >= 1
+		  *
+		  * @section faSuccessive_halving Abstraction function
+		  *
+		  * A valid object @e rep of class Successive_halving represents a search where the
+		  * candidate i, with parameters rep.candidates_[i], reached the rung rep.rungs_[i]
+		  * after rep.evaluations_[i] evaluations, with a validation error
+		  *
+		  * rep.scores_[i]
+		  *
+		  */
+
+		/**
+		  * @brief Parameters of each candidate, the number of evaluations is ignored
+		  */
+
+		std::vector<Parameters> candidates_;
+
+		/**
+		  * @brief Evaluations of every candidate in the first rung
+		  */
+
+		int min_evaluations_;
+
+		/**
+		  * @brief Evaluations of the candidates of the last rung
+		  */
+
+		int max_evaluations_;
+
+		/**
+		  * @brief Reduction factor: 1/eta of the candidates are promoted, with eta times the budget
+		  */
+
+		unsigned eta_;
+
+		/**
+		  * @brief Validation error of each candidate in the last rung it reached
+		  */
+
+		std::vector<double> scores_;
+
+		/**
+		  * @brief Last rung reached by each candidate
+		  */
+
+		std::vector<unsigned> rungs_;
+
+		/**
+		  * @brief Evaluations spent on each candidate
+		  */
+
+		std::vector<int> evaluations_;
+
+		/**
+		  * @brief Index of the best candidate of the last search
+		  */
+
+		unsigned best_;
+
+		/**
+		  * @brief Algorithm trained with the best candidate
+		  */
+
+		std::unique_ptr<Population_alg<T> > best_algorithm_;
+
+	public:
+
+		/**
+		  * @brief Constructor with four parameters.
+		  *
+		  * @param candidates Parameters of each candidate.
+		  * @param min_evaluations Evaluations of every candidate in the first rung.
+		  * @param max_evaluations Maximum evaluations of a candidate.
+		  * @param eta Reduction factor between rungs.
+		  */
+
+		Successive_halving(const std::vector<Parameters> & candidates, const int min_evaluations,
+								 const int max_evaluations, const unsigned eta = 3);
+
+		/**
+		  * @brief Search the best candidate.
+		  *
+		  * @param algorithm Algorithm with the training data and the initial population, copied
+		  * for every candidate.
+		  * @param validation Data used to rank the candidates, with the evaluation function of
+		  * each candidate.
+		  * @param seed Seed of the random generators of the candidates.
+		  *
+		  * @return Index of the best candidate.
+		  */
+
+		unsigned search(const Population_alg<T> & algorithm, const Dataset & validation,
+							 const unsigned long seed);
+
+		/**
+		  * @brief Get the index of the best candidate of the last search.
+		  *
+		  * @return Index of the best candidate.
+		  */
+
+		unsigned get_best_candidate() const;
+
+		/**
+		  * @brief Get the algorithm trained with the best candidate in the last search.
+		  *
+		  * @pre search has been called
+		  *
+		  * @return Algorithm of the best candidate.
+		  */
+
+		const Population_alg<T> & get_best_algorithm() const;
+
+		/**
+		  * @brief Get the validation error of each candidate in the last rung it reached.
+		  *
+		  * @return Validation error of each candidate.
+		  */
+
+		const std::vector<double> & get_scores() const;
+
+		/**
+		  * @brief Get the last rung reached by each candidate.
+		  *
+		  * @return Rung of each candidate, 0 for the first one.
+		  */
+
+		const std::vector<unsigned> & get_rungs() const;
+
+		/**
+		  * @brief Get the evaluations spent on each candidate.
+		  *
+		  * @return Evaluations of each candidate.
+		  */
+
+		const std::vector<int> & get_evaluations() const;
+
+};
+
+} // namespace expressions_algs
+
+#include "expressions_algs/Successive_halving.tpp"
+
+#endif
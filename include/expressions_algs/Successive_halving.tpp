@@ -0,0 +1,113 @@
+
+namespace expressions_algs {
+
+template <class T>
+Successive_halving<T> :: Successive_halving(const std::vector<Parameters> & candidates, const int min_evaluations,
+														  const int max_evaluations, const unsigned eta)
+	:candidates_(candidates), min_evaluations_(std::max(min_evaluations, 1)),
+	 max_evaluations_(std::max(max_evaluations, std::max(min_evaluations, 1))), eta_(std::max(eta, 2u)),
+	 scores_(candidates.size(), std::numeric_limits<double>::infinity()), rungs_(candidates.size(), 0),
+	 evaluations_(candidates.size(), 0), best_(0)
+{
+
+}
+
+template <class T>
+unsigned Successive_halving<T> :: search(const Population_alg<T> & algorithm, const Dataset & validation,
+													  const unsigned long seed) {
+
+	const unsigned num_candidatos = candidates_.size();
+
+	// cada candidato conserva su algoritmo y su generador entre peldaños, para continuar donde lo dejo
+	std::vector<std::unique_ptr<Population_alg<T> > > algoritmos (num_candidatos);
+	std::vector<std::mt19937> generadores (num_candidatos);
+
+	for ( unsigned i = 0; i < num_candidatos; i++) {
+		algoritmos[i] = algorithm.clone();
+		generadores[i].seed(Fold_executor::fold_seed(seed, i));
+	}
+
+	std::fill(scores_.begin(), scores_.end(), std::numeric_limits<double>::infinity());
+	std::fill(rungs_.begin(), rungs_.end(), 0);
+	std::fill(evaluations_.begin(), evaluations_.end(), 0);
+
+	std::vector<unsigned> supervivientes (num_candidatos);
+	std::iota(supervivientes.begin(), supervivientes.end(), 0);
+
+	long presupuesto = min_evaluations_;
+	unsigned peldanio = 0;
+	bool terminado = num_candidatos == 0;
+
+	while ( !terminado ) {
+		const int presupuesto_peldanio = std::min(presupuesto, static_cast<long>(max_evaluations_));
+
+		Fold_executor ejecutor (supervivientes.size());
+
+		// los supervivientes de un peldaño son independientes, se ajustan a la vez
+		ejecutor.run([&](const unsigned s) {
+			const unsigned c = supervivientes[s];
+
+			Random::set_generator(generadores[c]);
+
+			// solo se gasta lo que le falta al candidato para llegar al presupuesto del peldaño
+			Parameters parametros = candidates_[c];
+			parametros.set_num_evaluations(presupuesto_peldanio - evaluations_[c]);
+
+			algoritmos[c]->fit(parametros);
+
+			generadores[c] = Random::get_generator();
+			evaluations_[c] = presupuesto_peldanio;
+			rungs_[c] = peldanio;
+
+			scores_[c] = parametros.get_evaluation_functions()(algoritmos[c]->predict(validation),
+																				 validation.get_labels());
+		});
+
+		// a igual error se queda el candidato con menor indice, el resultado no depende del reparto
+		std::stable_sort(supervivientes.begin(), supervivientes.end(), [this](const unsigned a, const unsigned b) {
+			return scores_[a] < scores_[b];
+		});
+
+		terminado = supervivientes.size() == 1 || presupuesto_peldanio >= max_evaluations_;
+
+		if ( !terminado ) {
+			supervivientes.resize(std::max((supervivientes.size() + eta_ - 1) / eta_, static_cast<std::size_t>(1)));
+			presupuesto *= eta_;
+			peldanio++;
+		}
+	}
+
+	if ( num_candidatos > 0 ) {
+		best_ = supervivientes.front();
+		best_algorithm_ = std::move(algoritmos[best_]);
+	}
+
+	return best_;
+}
+
+template <class T>
+unsigned Successive_halving<T> :: get_best_candidate() const {
+	return best_;
+}
+
+template <class T>
+const Population_alg<T> & Successive_halving<T> :: get_best_algorithm() const {
+	return *best_algorithm_;
+}
+
+template <class T>
+const std::vector<double> & Successive_halving<T> :: get_scores() const {
+	return scores_;
+}
+
+template <class T>
+const std::vector<unsigned> & Successive_halving<T> :: get_rungs() const {
+	return rungs_;
+}
+
+template <class T>
+const std::vector<int> & Successive_halving<T> :: get_evaluations() const {
+	return evaluations_;
+}
+
+} // namespace expressions_algs
@@ -0,0 +1,306 @@
+/**
+  * \@file Surrogate_model.hpp
+  * @brief Header file of the Surrogate_model class
+  *
+  */
+
+#ifndef SURROGATE_MODEL_H_INCLUDED
+#define SURROGATE_MODEL_H_INCLUDED
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+
+#include "expressions_algs/Expression.hpp"
+#include "expressions_algs/aux_expressions_alg.hpp"
+
+namespace expressions_algs {
+
+/**
+  *  @brief Surrogate_model Class
+  *
+  *  An instance of type Surrogate_model predicts the fitness of an offspring
+  *  from cheap features (tree length, depth, parents fitness and its output on a
+  *  few fixed probe rows), so the offspring that are clearly worse than the
+  *  tournament threshold do not have to be evaluated. The model is a linear
+  *  regression over log-scaled features, trained online with recursive least
+  *  squares from the real evaluations.
+  *
+  *
+  * @author Antonio David Villegas Yeguas
+  * @date Octubre 2026
+  */
+
+class Surrogate_model {
+	public:
+
+		/**
+		  * @brief Number of fixed probe rows used to obtain the phenotype of an expression
+		  */
+
+		static const unsigned NUM_PROBE_ROWS = 32;
+
+		/**
+		  * @brief Number of features of the linear model, including the bias
+		  */
+
+		static const unsigned NUM_FEATURES = 6;
+
+		/**
+		  * @brief Features of an expression used by the model
+		  */
+
+		struct Features {
+			/**
+			  * @brief Log-scaled features of the expression
+			  */
+			std::array<double, NUM_FEATURES> values;
+
+			/**
+			  * @brief Hash of the outputs of the expression in the probe rows
+			  */
+			std::uint64_t phenotype;
+		};
+
+	private:
+
+		/**
+		  * @page repSurrogate_model Representation of the Surrogate_model class
+		  *
+		  * @section faSurrogate_model Abstraction function
+		  *
+		  * A valid object @e rep of class Surrogate_model represents a linear model
+		  *
+		  * rep.weights_
+		  *
+		  * Trained with recursive least squares, with inverse correlation matrix
+		  *
+		  * rep.covariance_
+		  *
+		  * And the fitness already seen for each phenotype on the probe rows
+		  *
+		  * rep.phenotypes_
+		  *
+		  */
+
+		/**
+		  * @brief Fixed probe rows
+		  */
+
+		std::vector<std::vector<double> > probe_data_;
+
+		/**
+		  * @brief Labels of the probe rows
+		  */
+
+		std::vector<double> probe_labels_;
+
+		/**
+		  * @brief Weights of the linear model
+		  */
+
+		std::array<double, NUM_FEATURES> weights_;
+
+		/**
+		  * @brief Inverse correlation matrix of the recursive least squares
+		  */
+
+		std::array<std::array<double, NUM_FEATURES>, NUM_FEATURES> covariance_;
+
+		/**
+		  * @brief Running variance of the residuals of the model, in log scale
+		  */
+
+		double residual_variance_;
+
+		/**
+		  * @brief Number of standard deviations of the residuals to consider a prediction clearly worse
+		  */
+
+		double confidence_;
+
+		/**
+		  * @brief Number of training samples needed before skipping any evaluation
+		  */
+
+		unsigned warmup_;
+
+		/**
+		  * @brief Number of training samples seen
+		  */
+
+		unsigned long num_trained_;
+
+		/**
+		  * @brief Fitness seen for each phenotype
+		  */
+
+		std::unordered_map<std::uint64_t, double> phenotypes_;
+
+		/**
+		  * @brief Number of offspring predicted as poor and evaluated anyway
+		  */
+
+		unsigned long num_checked_;
+
+		/**
+		  * @brief Number of offspring predicted as poor that were really poor
+		  */
+
+		unsigned long num_confirmed_;
+
+		/**
+		  * @brief Number of skipped evaluations
+		  */
+
+		unsigned long num_skipped_;
+
+		/**
+		  * @brief Scale a value to the log space of the model
+		  *
+		  * @param value Value to scale
+		  *
+		  * @return sign(value) * log(1 + |value|), bounded if value is not finite
+		  */
+
+		static double scale(const double value);
+
+		/**
+		  * @brief Inverse of scale
+		  *
+		  * @param value Value in log space
+		  *
+		  * @return Value in the original space
+		  */
+
+		static double unscale(const double value);
+
+		/**
+		  * @brief Predict in the log space of the model
+		  *
+		  * @param features Features of the expression
+		  *
+		  * @return Predicted fitness, in log space
+		  */
+
+		double predict_scaled(const Features & features) const;
+
+	public:
+
+		/**
+		  * @brief Constructor with two parameters.
+		  *
+		  * @param confidence Number of standard deviations of the residuals to consider a prediction clearly worse.
+		  * @param warmup Number of training samples needed before skipping any evaluation.
+		  *
+		  */
+
+		Surrogate_model(const double confidence = 2.0, const unsigned warmup = 200);
+
+		/**
+		  * @brief Take the fixed probe rows from the data and reset the model.
+		  *
+		  * @param data Data from where to take the probe rows.
+		  * @param labels Labels associated to data.
+		  */
+
+		void prepare(const Dataset & data,
+						 const std::vector<double> & labels);
+
+		/**
+		  * @brief Check if the model has the probe rows.
+		  *
+		  * @return True if the model is prepared.
+		  */
+
+		bool is_prepared() const;
+
+		/**
+		  * @brief Obtain the features of an expression.
+		  *
+		  * @param exp Expression to obtain its features.
+		  * @param evaluation_f Function used to evaluate the expression on the probe rows.
+		  *
+		  * @return Features of the expression.
+		  */
+
+		Features features(const Expression & exp, aux::eval_function_t evaluation_f) const;
+
+		/**
+		  * @brief Predict the fitness of an expression.
+		  *
+		  * @param features Features of the expression.
+		  *
+		  * @return Predicted fitness.
+		  */
+
+		double predict(const Features & features) const;
+
+		/**
+		  * @brief Check if an expression is predicted clearly worse than a threshold.
+		  *
+		  * @param features Features of the expression.
+		  * @param threshold Fitness threshold.
+		  *
+		  * @return True if the model is trained and the prediction, minus its margin, is worse than threshold.
+		  */
+
+		bool clearly_worse(const Features & features, const double threshold) const;
+
+		/**
+		  * @brief Train the model with a real evaluation.
+		  *
+		  * @param features Features of the evaluated expression.
+		  * @param fitness Real fitness of the expression.
+		  */
+
+		void train(const Features & features, const double fitness);
+
+		/**
+		  * @brief Record the result of an offspring predicted as poor but evaluated anyway.
+		  *
+		  * @param really_worse True if the real fitness is worse than the threshold.
+		  */
+
+		void record_check(const bool really_worse);
+
+		/**
+		  * @brief Record a skipped evaluation.
+		  */
+
+		void record_skip();
+
+		/**
+		  * @brief Get the precision of the poor predictions checked so far.
+		  *
+		  * @return Fraction of the offspring predicted as poor that were really poor, NaN if none was checked.
+		  */
+
+		double precision() const;
+
+		/**
+		  * @brief Get the number of skipped evaluations.
+		  *
+		  * @return Number of skipped evaluations.
+		  */
+
+		unsigned long get_num_skipped() const;
+
+		/**
+		  * @brief Obtain the fitness an individual needs to win, on average, at least one
+		  * tournament of the given size.
+		  *
+		  * @param fitness Fitness values of the population.
+		  * @param tournament_size Size of the tournament.
+		  *
+		  * @return Fitness threshold of the tournament.
+		  */
+
+		static double tournament_threshold(const std::vector<double> & fitness,
+													  const unsigned tournament_size);
+
+};
+
+} // namespace expressions_algs
+
+#endif
@@ -0,0 +1,430 @@
+/**
+  * \@file Task_scheduler.hpp
+  * @brief Header file of the Task_scheduler and Task_group classes
+  *
+  */
+
+#ifndef TASK_SCHEDULER_H_INCLUDED
+#define TASK_SCHEDULER_H_INCLUDED
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "expressions_algs/aux_expressions_alg.hpp"
+
+namespace expressions_algs {
+
+class Task_group;
+
+/**
+  *  @brief Task_scheduler Class
+  *
+  *  An instance of type Task_scheduler runs tasks on a fixed pool of threads
+  *  with work stealing. Each thread of the pool has its own deque of tasks:
+  *  it takes the newest task of its deque and, when it runs out, steals the
+  *  oldest task of another deque. The threads outside the pool share one more
+  *  deque. A thread that waits for a Task_group runs the pending tasks of that
+  *  group instead of blocking, so a task can open nested parallel loops and the
+  *  scheduler never uses more threads than the size of the pool, the calling
+  *  thread included.
+  *
+  *  A dedicated scheduler has a pool of its own threads, pinned to a set of
+  *  cores. The threads outside its pool only wait for its tasks, without
+  *  running them, so all the work of its tasks, nested parallel loops
+  *  included, stays on its threads and on its cores.
+  *
+  *  The library runs all its parallel work in the global scheduler, whose
+  *  size is set with set_global_threads (by default the OpenMP thread count,
+  *  or one thread if the library is built without OpenMP). Inside the tasks
+  *  of a dedicated scheduler the library uses that scheduler instead.
+  *
+  *
+  * @author Antonio David Villegas Yeguas
+  * @date Octubre 2026
+  */
+
+class Task_scheduler {
+	private:
+
+		/**
+		  * @page repTask_scheduler Representation of the Task_scheduler class
+		  *
+		  * @section invTask_scheduler Representation invariant
+		  *
+		  * num_threads_ >= 1, threads_.size == num_threads_ if dedicated_ and num_threads_ - 1
+		  * otherwise, queues_.size == threads_.size + 1 and num_queued_ is the number of tasks
+		  * in all the queues
+		  *
+		  * @section faTask_scheduler Abstraction function
+		  *
+		  * A valid object @e rep of class Task_scheduler represents a pool of rep.num_threads_
+		  * threads, the thread that waits for the tasks included if not rep.dedicated_, where
+		  * the thread i of the pool runs the tasks of
+		  *
+		  * rep.queues_[i + 1]
+		  *
+		  * and the threads outside the pool push their tasks to rep.queues_[0]
+		  *
+		  */
+
+		/**
+		  * @brief Task pending to run and the group that waits for it
+		  */
+
+		struct Task {
+			std::function<void()> function;
+			Task_group * group;
+		};
+
+		/**
+		  * @brief Deque of tasks of a thread with its lock
+		  */
+
+		struct Task_queue {
+			std::mutex lock;
+			std::deque<Task> tasks;
+		};
+
+		/**
+		  * @brief Number of threads, including the thread that waits for the tasks
+		  */
+
+		unsigned num_threads_;
+
+		/**
+		  * @brief True if all the threads belong to the pool and the threads outside only wait
+		  */
+
+		bool dedicated_;
+
+		/**
+		  * @brief Deque of each thread of the pool, the first one for the threads outside the pool
+		  */
+
+		std::vector<std::unique_ptr<Task_queue> > queues_;
+
+		/**
+		  * @brief Threads of the pool
+		  */
+
+		std::vector<std::thread> threads_;
+
+		/**
+		  * @brief Number of tasks in all the deques
+		  */
+
+		std::atomic<unsigned> num_queued_;
+
+		/**
+		  * @brief Number of threads of the pool sleeping without tasks
+		  */
+
+		std::atomic<unsigned> num_sleeping_;
+
+		/**
+		  * @brief True when the pool must finish
+		  */
+
+		std::atomic<bool> stop_;
+
+		/**
+		  * @brief Lock of the sleeping threads
+		  */
+
+		std::mutex sleep_lock_;
+
+		/**
+		  * @brief Condition to wake up the sleeping threads
+		  */
+
+		std::condition_variable wake_up_;
+
+		/**
+		  * @brief Condition to wake up the threads outside a dedicated pool when a task finishes
+		  */
+
+		std::condition_variable task_finished_;
+
+		/**
+		  * @brief Deque of the calling thread.
+		  *
+		  * @return Index of the deque of the thread if it belongs to the pool, 0 otherwise.
+		  */
+
+		unsigned current_queue() const;
+
+		/**
+		  * @brief Add a task to the deque of the calling thread and wake up a sleeping thread.
+		  *
+		  * @param task Task to add.
+		  */
+
+		void push(Task && task);
+
+		/**
+		  * @brief Run a pending task, the newest one of a deque or the oldest one of another.
+		  *
+		  * @param queue Deque of the calling thread.
+		  * @param group If it is not null, only a task of this group or of a group opened
+		  * inside its tasks is run.
+		  *
+		  * @return True if a task was run.
+		  */
+
+		bool run_one(const unsigned queue, const Task_group * group = nullptr);
+
+		/**
+		  * @brief Loop of a thread of the pool, runs tasks until the pool finishes.
+		  *
+		  * @param queue Deque of the thread.
+		  */
+
+		void worker_loop(const unsigned queue);
+
+		/**
+		  * @brief Split a range in chunks.
+		  *
+		  * @param size Number of iterations.
+		  * @param grain Minimum number of iterations of a chunk.
+		  *
+		  * @return Number of chunks, at least one and at most TASKS_PER_THREAD per thread.
+		  */
+
+		unsigned num_chunks(const unsigned size, const unsigned grain) const;
+
+		friend class Task_group;
+
+	public:
+
+		/**
+		  * @brief Maximum number of chunks per thread of a parallel loop
+		  */
+
+		static const unsigned TASKS_PER_THREAD = 4;
+
+		/**
+		  * @brief Constructor with one parameter, starts the pool.
+		  *
+		  * @param num_threads Number of threads, including the thread that waits for the tasks.
+		  */
+
+		explicit Task_scheduler(const unsigned num_threads);
+
+		/**
+		  * @brief Constructor with two parameters, starts a dedicated pool.
+		  *
+		  * @param num_threads Number of threads of the pool.
+		  * @param cores Cores where the threads of the pool run (see reserve_cores), if it is
+		  * empty or the system does not allow it they are not pinned.
+		  */
+
+		Task_scheduler(const unsigned num_threads, const std::vector<unsigned> & cores);
+
+		Task_scheduler(const Task_scheduler & another) = delete;
+		Task_scheduler & operator= (const Task_scheduler & another) = delete;
+
+		/**
+		  * @brief Destructor, runs the pending tasks and stops the pool.
+		  */
+
+		~Task_scheduler();
+
+		/**
+		  * @brief Get the number of threads.
+		  *
+		  * @return Number of threads, including the thread that waits for the tasks.
+		  */
+
+		unsigned get_num_threads() const;
+
+		/**
+		  * @brief Run a loop in parallel. The range is split in chunks of consecutive
+		  * iterations; when there is a single chunk the loop runs in the calling thread.
+		  *
+		  * @param first First iteration.
+		  * @param last Iteration after the last one.
+		  * @param grain Minimum number of iterations of a chunk.
+		  * @param body Function called with each iteration, from several threads at the same time.
+		  */
+
+		template <class Body>
+		void parallel_for(const unsigned first, const unsigned last, const unsigned grain, const Body & body);
+
+		/**
+		  * @brief Reduce a range in parallel. Each chunk reduces its iterations from the
+		  * identity and the partial results are combined in the order of the chunks, so
+		  * the result only depends on the number of threads if combine is not associative.
+		  *
+		  * @param first First iteration.
+		  * @param last Iteration after the last one.
+		  * @param grain Minimum number of iterations of a chunk.
+		  * @param identity Initial value of each chunk.
+		  * @param body Function called with each iteration and the partial result of its chunk.
+		  * @param combine Function that adds a partial result to another one.
+		  *
+		  * @return Combination of all the partial results.
+		  */
+
+		template <class V, class Body, class Combine>
+		V parallel_reduce(const unsigned first, const unsigned last, const unsigned grain, const V & identity,
+								const Body & body, const Combine & combine);
+
+		/**
+		  * @brief Check if the scheduler has a dedicated pool.
+		  *
+		  * @return True if the threads outside the pool do not run its tasks.
+		  */
+
+		bool is_dedicated() const;
+
+		/**
+		  * @brief Get the scheduler of the library, created the first time it is used.
+		  * From a thread of a dedicated pool it is the scheduler of that pool.
+		  *
+		  * @return Global scheduler.
+		  */
+
+		static Task_scheduler & global();
+
+		/**
+		  * @brief Set the number of threads of the global scheduler.
+		  *
+		  * @param num_threads Number of threads, at least one.
+		  *
+		  * @pre No task of the global scheduler is running or pending.
+		  */
+
+		static void set_global_threads(const unsigned num_threads);
+
+		/**
+		  * @brief Get the number of threads of the global scheduler when it is not set.
+		  *
+		  * @return OpenMP thread count, or 1 without OpenMP.
+		  */
+
+		static unsigned default_threads();
+
+		/**
+		  * @brief Reserve cores of the process for a dedicated pool. The cores are given
+		  * in turns, so pools created at the same time get different cores while there
+		  * are enough of them.
+		  *
+		  * @param num_cores Number of cores.
+		  *
+		  * @return Cores reserved, empty if the system does not allow pinning threads.
+		  */
+
+		static std::vector<unsigned> reserve_cores(const unsigned num_cores);
+
+};
+
+/**
+  *  @brief Task_group Class
+  *
+  *  An instance of type Task_group is a set of tasks of a Task_scheduler that
+  *  run concurrently and are waited for together. While it waits, the calling
+  *  thread only runs pending tasks of this group or of the groups opened inside
+  *  them, so a task that waits never runs unrelated work on top of its stack.
+  *  A thread outside a dedicated pool sleeps instead.
+  *
+  *
+  * @author Antonio David Villegas Yeguas
+  * @date Octubre 2026
+  */
+
+class Task_group {
+	private:
+
+		/**
+		  * @page repTask_group Representation of the Task_group class
+		  *
+		  * @section invTask_group Representation invariant
+		  *
+		  * pending_ is the number of tasks of the group not finished yet and parent_ is
+		  * null or a group with a task not finished yet
+		  *
+		  * @section faTask_group Abstraction function
+		  *
+		  * A valid object @e rep of class Task_group represents rep.pending_ tasks running in
+		  *
+		  * rep.scheduler_
+		  *
+		  */
+
+		/**
+		  * @brief Scheduler that runs the tasks
+		  */
+
+		Task_scheduler & scheduler_;
+
+		/**
+		  * @brief Group of the task that opened this group, null outside of a task
+		  */
+
+		const Task_group * parent_;
+
+		/**
+		  * @brief Number of tasks not finished yet
+		  */
+
+		std::atomic<unsigned> pending_;
+
+		/**
+		  * @brief Check if the group was opened, directly or not, inside a task of another group.
+		  *
+		  * @param ancestor Group to look for.
+		  *
+		  * @return True if ancestor is this group or one of its parents.
+		  */
+
+		bool descends_from(const Task_group & ancestor) const;
+
+		friend class Task_scheduler;
+
+	public:
+
+		/**
+		  * @brief Constructor with one parameter.
+		  *
+		  * @param scheduler Scheduler that runs the tasks.
+		  */
+
+		explicit Task_group(Task_scheduler & scheduler = Task_scheduler::global());
+
+		Task_group(const Task_group & another) = delete;
+		Task_group & operator= (const Task_group & another) = delete;
+
+		/**
+		  * @brief Destructor, waits for the pending tasks.
+		  */
+
+		~Task_group();
+
+		/**
+		  * @brief Add a task to the group. It may start before run returns.
+		  *
+		  * @param task Function to run, it must not throw.
+		  */
+
+		void run(std::function<void()> task);
+
+		/**
+		  * @brief Wait for all the tasks of the group, running its pending tasks meanwhile.
+		  * The random generator of the calling thread is the same after the wait.
+		  */
+
+		void wait();
+
+};
+
+} // namespace expressions_algs
+
+#include "expressions_algs/Task_scheduler.tpp"
+
+#endif
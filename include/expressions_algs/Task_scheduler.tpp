@@ -0,0 +1,68 @@
+
+namespace expressions_algs {
+
+template <class Body>
+void Task_scheduler :: parallel_for(const unsigned first, const unsigned last, const unsigned grain,
+												const Body & body) {
+
+	if ( last <= first ) {
+		return ;
+	}
+
+	const unsigned tam = last - first;
+	const unsigned trozos = num_chunks(tam, grain);
+
+	// con un solo trozo no merece la pena crear tareas, salvo desde fuera de un pool dedicado
+	if ( trozos == 1 && ( !dedicated_ || current_queue() != 0 ) ) {
+		for ( unsigned i = first; i < last; i++) {
+			body(i);
+		}
+	} else {
+		Task_group grupo (*this);
+
+		for ( unsigned trozo = 0; trozo < trozos; trozo++) {
+			const unsigned inicio = first + static_cast<unsigned long>(tam) * trozo / trozos;
+			const unsigned fin = first + static_cast<unsigned long>(tam) * (trozo + 1) / trozos;
+
+			grupo.run([&body, inicio, fin]() {
+				for ( unsigned i = inicio; i < fin; i++) {
+					body(i);
+				}
+			});
+		}
+
+		grupo.wait();
+	}
+
+}
+
+template <class V, class Body, class Combine>
+V Task_scheduler :: parallel_reduce(const unsigned first, const unsigned last, const unsigned grain,
+												const V & identity, const Body & body, const Combine & combine) {
+
+	const unsigned tam = last > first ? last - first : 0;
+	const unsigned trozos = num_chunks(tam, grain);
+
+	// cada trozo acumula en su propio resultado parcial
+	std::vector<V> parciales (trozos, identity);
+
+	parallel_for(0, trozos, 1, [&](const unsigned trozo) {
+		const unsigned inicio = first + static_cast<unsigned long>(tam) * trozo / trozos;
+		const unsigned fin = first + static_cast<unsigned long>(tam) * (trozo + 1) / trozos;
+
+		for ( unsigned i = inicio; i < fin; i++) {
+			body(i, parciales[trozo]);
+		}
+	});
+
+	// los parciales se combinan siempre en el mismo orden
+	V resultado = identity;
+
+	for ( unsigned trozo = 0; trozo < trozos; trozo++) {
+		combine(resultado, parciales[trozo]);
+	}
+
+	return resultado;
+}
+
+} // namespace expressions_algs
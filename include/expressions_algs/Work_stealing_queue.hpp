@@ -0,0 +1,100 @@
+/**
+  * \@file Work_stealing_queue.hpp
+  * @brief Header file of the Work_stealing_queue class
+  *
+  */
+
+#ifndef WORK_STEALING_QUEUE_H_INCLUDED
+#define WORK_STEALING_QUEUE_H_INCLUDED
+
+#include <deque>
+#include <mutex>
+
+#include "expressions_algs/aux_expressions_alg.hpp"
+
+namespace expressions_algs {
+
+/**
+  *  @brief Work_stealing_queue Class
+  *
+  *  An instance of type Work_stealing_queue hands out a set of tasks with an
+  *  estimated cost between several workers. The tasks are sorted by cost and
+  *  dealt longest-first to one deque per worker; each worker takes its own
+  *  tasks from the front (the most expensive first) and, when it runs out,
+  *  steals from the back of the other deques (the cheapest first).
+  *
+  *
+  * @author Antonio David Villegas Yeguas
+  * @date Octubre 2026
+  */
+
+class Work_stealing_queue {
+	private:
+
+		/**
+		  * @page repWork_stealing_queue Representation of the Work_stealing_queue class
+		  *
+		  * @section invWork_stealing_queue Representation invariant
+		  *
+		  * deques_.size == locks_.size >= 1. Each deque is sorted by decreasing cost
+		  *
+		  * @section faWork_stealing_queue Abstraction function
+		  *
+		  * A valid object @e rep of class Work_stealing_queue represents the pending tasks
+		  * of each worker
+		  *
+		  * rep.deques_[worker]
+		  *
+		  */
+
+		/**
+		  * @brief Pending tasks of each worker, sorted by decreasing cost
+		  */
+
+		std::vector<std::deque<unsigned> > deques_;
+
+		/**
+		  * @brief Lock of each deque
+		  */
+
+		std::vector<std::mutex> locks_;
+
+	public:
+
+		/**
+		  * @brief Constructor with three parameters.
+		  *
+		  * @param tasks Identifiers of the tasks.
+		  * @param costs Estimated cost of each task, costs[i] is the cost of tasks[i].
+		  * @param num_workers Number of workers.
+		  *
+		  * @pre tasks.size == costs.size
+		  */
+
+		Work_stealing_queue(const std::vector<unsigned> & tasks, const std::vector<double> & costs,
+								  const unsigned num_workers);
+
+		/**
+		  * @brief Get the next task of a worker, stealing it from another worker if needed.
+		  *
+		  * @param worker Index of the worker, in [0, num_workers).
+		  * @param task Where the task is stored.
+		  *
+		  * @return True if there was a task, false if all the tasks have been handed out.
+		  */
+
+		bool next(const unsigned worker, unsigned & task);
+
+		/**
+		  * @brief Get the number of workers.
+		  *
+		  * @return Number of workers.
+		  */
+
+		unsigned get_num_workers() const;
+
+};
+
+} // namespace expressions_algs
+
+#endif
@@ -92,6 +92,353 @@ double root_cuadratic_mean_error(const std::vector<double> & predicted_values,
 double mean_absolute_error(const std::vector<double> & predicted_values,
 									const std::vector<double> & real_values);
 
+/**
+ * @brief Kinds of evaluation functions whose value can be accumulated row by row
+ *
+ */
+
+enum class MetricReduction {NONE, MEAN_SQUARED, ROOT_MEAN_SQUARED, MEAN_ABSOLUTE};
+
+/**
+ * @brief Obtain how an evaluation function can be accumulated row by row
+ *
+ * @param evaluation_f Evaluation function.
+ *
+ * @return Reduction of the function, NONE if it is not one of the known decomposable metrics.
+ *
+ */
+
+MetricReduction get_metric_reduction(eval_function_t evaluation_f);
+
+/**
+ * @brief Cuadratic mean error as a reduction known at compile time. A metric has a state
+ * that starts at init, accumulate adds a row to it, combine joins the states of two
+ * disjoint sets of rows and finalize obtains the value of the metric from the state of
+ * all the rows. Being inline, the reduction is inlined into the evaluation loops.
+ *
+ */
+
+struct Mean_squared_error {
+	typedef double state_t;
+
+	static constexpr MetricReduction reduction = MetricReduction::MEAN_SQUARED;
+
+	static state_t init() {
+		return 0.0;
+	}
+
+	static state_t accumulate(const state_t state, const double predicted_value, const double real_value) {
+		const double diferencia = predicted_value - real_value;
+
+		return state + diferencia * diferencia;
+	}
+
+	static state_t combine(const state_t first, const state_t second) {
+		return first + second;
+	}
+
+	static double finalize(const state_t state, const unsigned num_rows) {
+		return state / static_cast<double>(num_rows);
+	}
+};
+
+/**
+ * @brief Root of the cuadratic mean error as a reduction known at compile time
+ *
+ */
+
+struct Root_mean_squared_error : public Mean_squared_error {
+	static constexpr MetricReduction reduction = MetricReduction::ROOT_MEAN_SQUARED;
+
+	static double finalize(const state_t state, const unsigned num_rows) {
+		return std::sqrt(Mean_squared_error::finalize(state, num_rows));
+	}
+};
+
+/**
+ * @brief Mean absolute error as a reduction known at compile time
+ *
+ */
+
+struct Mean_absolute_error {
+	typedef double state_t;
+
+	static constexpr MetricReduction reduction = MetricReduction::MEAN_ABSOLUTE;
+
+	static state_t init() {
+		return 0.0;
+	}
+
+	static state_t accumulate(const state_t state, const double predicted_value, const double real_value) {
+		return state + std::abs(predicted_value - real_value);
+	}
+
+	static state_t combine(const state_t first, const state_t second) {
+		return first + second;
+	}
+
+	static double finalize(const state_t state, const unsigned num_rows) {
+		return state / static_cast<double>(num_rows);
+	}
+};
+
+/**
+ * @brief Adapter of an evaluation function given by a pointer to the interface of the
+ * reductions. The known decomposable functions are reduced row by row choosing the
+ * reduction at run time; any other function can only be called with all the predictions.
+ *
+ */
+
+class Runtime_metric {
+	private:
+
+		/**
+		  * @brief Evaluation function
+		  */
+
+		eval_function_t function_;
+
+		/**
+		  * @brief How function_ is accumulated row by row
+		  */
+
+		MetricReduction reduction_;
+
+	public:
+
+		typedef double state_t;
+
+		/**
+		  * @brief Constructor with one parameter.
+		  *
+		  * @param evaluation_f Evaluation function.
+		  */
+
+		explicit Runtime_metric(eval_function_t evaluation_f)
+			:function_(evaluation_f), reduction_(get_metric_reduction(evaluation_f)) {}
+
+		/**
+		  * @brief Check if the function can be reduced row by row.
+		  *
+		  * @return True if it is one of the known decomposable metrics.
+		  */
+
+		bool is_decomposable() const {
+			return reduction_ != MetricReduction::NONE;
+		}
+
+		/**
+		  * @brief Get how the function is accumulated row by row.
+		  *
+		  * @return Reduction of the function.
+		  */
+
+		MetricReduction get_reduction() const {
+			return reduction_;
+		}
+
+		state_t init() const {
+			return 0.0;
+		}
+
+		/**
+		  * @pre is_decomposable()
+		  */
+
+		state_t accumulate(const state_t state, const double predicted_value, const double real_value) const {
+			return reduction_ == MetricReduction::MEAN_ABSOLUTE ?
+					 Mean_absolute_error::accumulate(state, predicted_value, real_value) :
+					 Mean_squared_error::accumulate(state, predicted_value, real_value);
+		}
+
+		state_t combine(const state_t first, const state_t second) const {
+			return first + second;
+		}
+
+		/**
+		  * @pre is_decomposable()
+		  */
+
+		double finalize(const state_t state, const unsigned num_rows) const {
+			return reduction_ == MetricReduction::ROOT_MEAN_SQUARED ?
+					 Root_mean_squared_error::finalize(state, num_rows) :
+					 Mean_squared_error::finalize(state, num_rows);
+		}
+
+		/**
+		  * @brief Call the function with all the predictions.
+		  *
+		  * @param predicted_values Predicted values.
+		  * @param real_values Real values.
+		  *
+		  * @return Value of the function.
+		  */
+
+		double operator()(const std::vector<double> & predicted_values,
+								const std::vector<double> & real_values) const {
+			return function_(predicted_values, real_values);
+		}
+};
+
+/**
+ * @brief Reduce a set of predictions with a metric, in a single loop where the metric
+ * is inlined.
+ *
+ * @param metric Metric with init, accumulate and finalize.
+ * @param predicted_values Predicted values.
+ * @param real_values Real values.
+ *
+ * @return Value of the metric between predicted_values and real_values
+ *
+ */
+
+template <class Metric>
+inline double reduce_metric(const Metric & metric, const std::vector<double> & predicted_values,
+									 const std::vector<double> & real_values) {
+	typename Metric::state_t estado = metric.init();
+
+	for ( unsigned i = 0; i < real_values.size(); i++ ) {
+		estado = metric.accumulate(estado, predicted_values[i], real_values[i]);
+	}
+
+	return metric.finalize(estado, real_values.size());
+}
+
+/**
+ * @brief Reduce a set of predictions with an evaluation function given by a pointer,
+ * row by row if it is decomposable and calling it otherwise.
+ *
+ * @param metric Adapter of the evaluation function.
+ * @param predicted_values Predicted values.
+ * @param real_values Real values.
+ *
+ * @return Value of the evaluation function between predicted_values and real_values
+ *
+ */
+
+inline double reduce_metric(const Runtime_metric & metric, const std::vector<double> & predicted_values,
+									 const std::vector<double> & real_values) {
+	return metric.is_decomposable() ? reduce_metric<Runtime_metric>(metric, predicted_values, real_values) :
+												 metric(predicted_values, real_values);
+}
+
+/**
+ * @brief Call a function with the reduction known at compile time of a decomposable metric,
+ * so the function is instantiated, and inlined, for each reduction.
+ *
+ * @param reduction Reduction of the metric.
+ * @param function Generic function called with a Mean_squared_error, Root_mean_squared_error
+ * or Mean_absolute_error.
+ *
+ * @pre reduction != MetricReduction::NONE
+ *
+ */
+
+template <class Function>
+inline void dispatch_metric(const MetricReduction reduction, Function && function) {
+	switch ( reduction ) {
+		case MetricReduction::ROOT_MEAN_SQUARED:
+			function(Root_mean_squared_error());
+			break;
+		case MetricReduction::MEAN_ABSOLUTE:
+			function(Mean_absolute_error());
+			break;
+		default:
+			function(Mean_squared_error());
+	}
+}
+
+/**
+ * @brief Errors of a set of predictions, all computed from the same predictions
+ *
+ */
+
+struct Metrics {
+
+	/**
+	 * @brief Cuadratic mean error
+	 */
+
+	double mse = 0.0;
+
+	/**
+	 * @brief Root of the cuadratic mean error
+	 */
+
+	double rmse = 0.0;
+
+	/**
+	 * @brief Mean absolute error
+	 */
+
+	double mae = 0.0;
+
+	/**
+	 * @brief Value of each evaluation function asked to compute_metrics, in the same order
+	 */
+
+	std::vector<double> values;
+
+};
+
+/**
+ * @brief Compute the cuadratic mean error, its root and the mean absolute error in a single
+ * pass over the predictions, plus the value of some evaluation functions. The known
+ * decomposable functions are taken from that pass instead of being called.
+ *
+ * @param predicted_values Predicted values.
+ * @param real_values Real values.
+ * @param functions Evaluation functions whose values are stored in Metrics::values.
+ *
+ * @return Errors between predicted_values and real_values.
+ *
+ */
+
+Metrics compute_metrics(const std::vector<double> & predicted_values, const std::vector<double> & real_values,
+								const std::vector<eval_function_t> & functions = {});
+
+/**
+ * @brief Obtain the value of a given quantile of a set of values, ignoring NaN values
+ *
+ * @param values Values from where to obtain the quantile.
+ * @param quantile Quantile to obtain, in [0, 1].
+ *
+ * @return Value in the quantile, infinity if there are no values.
+ *
+ */
+
+double quantile(std::vector<double> values, const double quantile);
+
+/**
+ * @brief Write the bytes of a trivially copyable value in a binary stream, in native endianness
+ *
+ * @param os Stream where the value is written.
+ * @param value Value to write.
+ *
+ */
+
+template <class V>
+inline void write_binary(std::ostream & os, const V & value) {
+	static_assert(std::is_trivially_copyable<V>::value, "only trivially copyable values");
+	os.write(reinterpret_cast<const char *>(&value), sizeof(V));
+}
+
+/**
+ * @brief Read the bytes of a trivially copyable value written with write_binary
+ *
+ * @param is Stream from where the value is read.
+ * @param value Where the value is stored.
+ *
+ * @return True if all the bytes of the value were read.
+ *
+ */
+
+template <class V>
+inline bool read_binary(std::istream & is, V & value) {
+	static_assert(std::is_trivially_copyable<V>::value, "only trivially copyable values");
+	return static_cast<bool>(is.read(reinterpret_cast<char *>(&value), sizeof(V)));
+}
+
 
 }
 
@@ -8,6 +8,9 @@
 #define PREPROCESS_H_INCLUDED
 
 #include "expressions_algs/aux_expressions_alg.hpp"
+#include "expressions_algs/Dataset.hpp"
+
+#include <numeric>
 
 
 template <class T>
@@ -33,10 +36,151 @@ namespace expressions_algs :: preprocess {
 
 template <class T>
 std::pair<std::pair<matriz<T>, std::vector<T> >, std::pair<matriz<T>, std::vector<T> > >
-	split_train_test(matriz<T> data, std::vector<T> labels,
+	split_train_test(const matriz<T> & data, const std::vector<T> & labels,
 							 const double PORCENTAJE_TEST = 0.2, const int COMIENZO = -1);
 
 
+/**
+  * @brief Vista de un subconjunto de filas de unos data y sus labels, sin copiarlas
+  *
+  * Una vista guarda referencias a los data originales y los indices de sus filas,
+  * en el orden en el que se recorren. Los data originales han de existir mientras se
+  * use la vista.
+  *
+  * @tparam T type de los data
+  */
+
+template <class T>
+class Data_view {
+	private:
+
+		/**
+		  * @brief Datos originales
+		  */
+
+		const matriz<T> * data_;
+
+		/**
+		  * @brief Etiquetas de los data originales
+		  */
+
+		const std::vector<T> * labels_;
+
+		/**
+		  * @brief Indice en los data originales de cada fila de la vista
+		  */
+
+		std::vector<std::uint32_t> indices_;
+
+	public:
+
+		/**
+		  * @brief Constructor con tres parámetros
+		  *
+		  * @param data Datos originales
+		  * @param labels Etiquetas de los data originales
+		  * @param indices Indice en data de cada fila de la vista
+		  */
+
+		Data_view(const matriz<T> & data, const std::vector<T> & labels, std::vector<std::uint32_t> indices);
+
+		/**
+		  * @brief Obtener el número de filas de la vista
+		  *
+		  * @return Número de filas
+		  */
+
+		unsigned size() const;
+
+		/**
+		  * @brief Obtener una fila de la vista
+		  *
+		  * @param i Posición de la fila en la vista
+		  *
+		  * @return Fila de los data originales
+		  */
+
+		const std::vector<T> & get_row(const unsigned i) const;
+
+		/**
+		  * @brief Obtener la etiqueta de una fila de la vista
+		  *
+		  * @param i Posición de la fila en la vista
+		  *
+		  * @return Etiqueta de la fila
+		  */
+
+		const T & get_label(const unsigned i) const;
+
+		/**
+		  * @brief Obtener los indices de las filas de la vista
+		  *
+		  * @return Indice en los data originales de cada fila
+		  */
+
+		const std::vector<std::uint32_t> & get_indices() const;
+
+		/**
+		  * @brief Copiar las filas de la vista
+		  *
+		  * @return Pareja de data y labels de la vista
+		  */
+
+		std::pair<matriz<T>, std::vector<T> > materialize() const;
+
+};
+
+
+/**
+  * @brief Obtener una permutación aleatoria de los indices [0, num_elementos) con
+  * el algoritmo de Fisher-Yates, en O(num_elementos)
+  *
+  * @param num_elementos Número de indices
+  *
+  * @return Indices permutados
+  */
+
+std::vector<std::uint32_t> random_permutation(const std::uint32_t num_elementos);
+
+
+/**
+  * @brief Separar una permutación de indices en entrenamiento y test, en O(n).
+  * Los indices de test son un tramo consecutivo de la permutación y los de
+  * entrenamiento el resto, conservando su orden
+  *
+  * @param permutacion Indices a separar
+  * @param PORCENTAJE_TEST Porcentaje de indices que formaran parte del conjunto de test
+  * @param COMIENZO Posición de la permutación donde empieza el tramo de test. Si vale -1
+  *  empieza en la primera posición, de forma que con una permutación aleatoria el test es aleatorio
+  *
+  * @return Pareja de indices de entrenamiento y test
+  */
+
+std::pair<std::vector<std::uint32_t>, std::vector<std::uint32_t> >
+	split_indices(const std::vector<std::uint32_t> & permutacion,
+					  const double PORCENTAJE_TEST = 0.2, const int COMIENZO = -1);
+
+
+/**
+  * @brief Separar unos data en vistas de entrenamiento y test, sin copiar ninguna fila
+  *
+  * @tparam T type de los data a separar
+  * @param data Características a separar
+  * @param labels Etiquetas de los data a separar
+  * @param permutacion Orden en el que se toman las filas de data
+  * @param PORCENTAJE_TEST Porcentaje de data que formaran parte del conjunto de test
+  * @param COMIENZO Posición de la permutación donde empieza el tramo de test, como en split_indices
+  *
+  * @return Pareja de vistas de entrenamiento y test
+  */
+
+template <class T>
+std::pair<Data_view<T>, Data_view<T> >
+	split_train_test_view(const matriz<T> & data, const std::vector<T> & labels,
+								 const std::vector<std::uint32_t> & permutacion,
+								 const double PORCENTAJE_TEST = 0.2, const int COMIENZO = -1);
+
+
 /**
   * @brief Leer data de entrada para el algoritmo
   *
@@ -49,6 +193,9 @@ std::pair<std::pair<matriz<T>, std::vector<T> >, std::pair<matriz<T>, std::vecto
   *
   * @pre Los data a leer vienen dados separados por delimiter. Cada dato es una linea.
   *
+  * Si T es double y todas las lineas tienen el mismo numero de campos, el fichero
+  * se lee en paralelo con Dataset::read_file. Si no, se lee linea a linea.
+  *
   * @return Pareja de data y labels leidas
   *
   */
@@ -84,7 +231,7 @@ void write_data(const std::string & salida, const matriz<T> & data, const std::v
   */
 
 template <class T>
-std::pair<matriz<T>, std::vector<T> > random_data_reorder (matriz<T> data, std::vector<T> labels);
+std::pair<matriz<T>, std::vector<T> > random_data_reorder (const matriz<T> & data, const std::vector<T> & labels);
 
 
 }
@@ -4,6 +4,16 @@ namespace expressions_algs :: preprocess {
 template <class T>
 std::pair<matriz<T>, std::vector<T> > read_data(const std::string & data_file,
 												const char comment_char, const char delimiter){
+
+	if constexpr ( std::is_same<T, double>::value ) {
+		Dataset leidos;
+
+		// lectura rapida, con el fichero proyectado en memoria y en paralelo
+		if ( Dataset::read_file(data_file, comment_char, delimiter, leidos) ) {
+			return std::make_pair(leidos.to_matrix(), leidos.get_labels());
+		}
+	}
+
 	// abrimos el fichero de lectura
 	std::ifstream file(data_file);
 
@@ -85,40 +95,106 @@ std::pair<matriz<T>, std::vector<T> > read_data(const std::string & data_file,
 
 template <class T>
 std::pair<std::pair<matriz<T>, std::vector<T> >, std::pair<matriz<T>, std::vector<T> > >
-	split_train_test(matriz<T> data, std::vector<T> labels,
+	split_train_test(const matriz<T> & data, const std::vector<T> & labels,
 							 const double PORCENTAJE_TEST, const int COMIENZO) {
 
+	std::vector<std::uint32_t> permutacion;
 
-	matriz<T> datos_test;
-	std::vector<T> etiquetas_test;
+	// sin comienzo el test es aleatorio, si no es el tramo que empieza en COMIENZO
+	if ( COMIENZO == -1 ) {
+		permutacion = random_permutation(data.size());
+	} else {
+		permutacion.resize(data.size());
+		std::iota(permutacion.begin(), permutacion.end(), 0);
+	}
 
-	const unsigned NUM_DATOS_TEST = data.size() * PORCENTAJE_TEST;
+	auto vistas = split_train_test_view(data, labels, permutacion, PORCENTAJE_TEST, COMIENZO);
 
-	datos_test.resize(NUM_DATOS_TEST);
-	etiquetas_test.resize(NUM_DATOS_TEST);
+	return std::make_pair(vistas.first.materialize(), vistas.second.materialize());
 
-	bool aleatorio = COMIENZO == -1;
-	int index = COMIENZO;
+}
 
-	for ( unsigned i = 0; i < NUM_DATOS_TEST; i++) {
+inline std::vector<std::uint32_t> random_permutation(const std::uint32_t num_elementos) {
+	std::vector<std::uint32_t> permutacion (num_elementos);
 
-		if (aleatorio ) {
-			index = Random::get_int(0, data.size());
-		}
+	std::iota(permutacion.begin(), permutacion.end(), 0);
+
+	// Fisher-Yates: cada posicion se intercambia con una de las anteriores o consigo misma
+	for ( std::uint32_t i = num_elementos; i > 1; i--) {
+		const std::uint32_t escogido = Random::get_int(i);
+
+		std::swap(permutacion[i - 1], permutacion[escogido]);
+	}
+
+	return permutacion;
+}
+
+inline std::pair<std::vector<std::uint32_t>, std::vector<std::uint32_t> >
+	split_indices(const std::vector<std::uint32_t> & permutacion,
+					  const double PORCENTAJE_TEST, const int COMIENZO) {
+
+	const std::size_t NUM_DATOS_TEST = permutacion.size() * PORCENTAJE_TEST;
+	const std::size_t inicio = std::min<std::size_t>(std::max(COMIENZO, 0), permutacion.size() - NUM_DATOS_TEST);
+
+	std::vector<std::uint32_t> entrenamiento;
+	std::vector<std::uint32_t> test (permutacion.begin() + inicio, permutacion.begin() + inicio + NUM_DATOS_TEST);
+
+	entrenamiento.reserve(permutacion.size() - NUM_DATOS_TEST);
+	entrenamiento.insert(entrenamiento.end(), permutacion.begin(), permutacion.begin() + inicio);
+	entrenamiento.insert(entrenamiento.end(), permutacion.begin() + inicio + NUM_DATOS_TEST, permutacion.end());
+
+	return std::make_pair(entrenamiento, test);
+}
+
+template <class T>
+Data_view<T> :: Data_view(const matriz<T> & data, const std::vector<T> & labels,
+								  std::vector<std::uint32_t> indices)
+	:data_(&data), labels_(&labels), indices_(std::move(indices))
+{}
 
-		datos_test[i] = data[index];
-		etiquetas_test[i] = labels[index];
+template <class T>
+unsigned Data_view<T> :: size() const {
+	return indices_.size();
+}
 
-		auto it_datos = data.begin() + index;
-		auto it_etiquetas = labels.begin() + index;
+template <class T>
+const std::vector<T> & Data_view<T> :: get_row(const unsigned i) const {
+	return (*data_)[indices_[i]];
+}
 
-		data.erase(it_datos);
-		labels.erase(it_etiquetas);
+template <class T>
+const T & Data_view<T> :: get_label(const unsigned i) const {
+	return (*labels_)[indices_[i]];
+}
+
+template <class T>
+const std::vector<std::uint32_t> & Data_view<T> :: get_indices() const {
+	return indices_;
+}
+
+template <class T>
+std::pair<matriz<T>, std::vector<T> > Data_view<T> :: materialize() const {
+	matriz<T> data (indices_.size());
+	std::vector<T> labels (indices_.size());
 
+	for ( unsigned i = 0; i < indices_.size(); i++) {
+		data[i] = get_row(i);
+		labels[i] = get_label(i);
 	}
 
-	return std::make_pair(std::make_pair(data, labels), std::make_pair(datos_test, etiquetas_test));
+	return std::make_pair(data, labels);
+}
+
+template <class T>
+std::pair<Data_view<T>, Data_view<T> >
+	split_train_test_view(const matriz<T> & data, const std::vector<T> & labels,
+								 const std::vector<std::uint32_t> & permutacion,
+								 const double PORCENTAJE_TEST, const int COMIENZO) {
 
+	auto indices = split_indices(permutacion, PORCENTAJE_TEST, COMIENZO);
+
+	return std::make_pair(Data_view<T>(data, labels, std::move(indices.first)),
+								 Data_view<T>(data, labels, std::move(indices.second)));
 }
 
 template <class T>
@@ -138,31 +214,13 @@ void write_data(const std::string & salida, const matriz<T> & data, const std::v
 
 
 template <class T>
-std::pair<matriz<T>, std::vector<T> > random_data_reorder (matriz<T> data,
-	 																				  std::vector<T> labels) {
-	matriz<T> datos_reordenados;
-	std::vector<T> etiquetas_reordenados;
-
-	datos_reordenados.resize(data.size());
-	etiquetas_reordenados.resize(labels.size());
-
-	const unsigned num_elementos = data.size();
+std::pair<matriz<T>, std::vector<T> > random_data_reorder (const matriz<T> & data,
+	 																				  const std::vector<T> & labels) {
 
-	for ( unsigned i = 0; i < num_elementos; i++) {
-		int index = Random::get_int(0, data.size());
-
-		datos_reordenados[i] = data[index];
-		etiquetas_reordenados[i] = labels[index];
-
-		auto it_datos = data.begin() + index;
-		auto it_etiquetas = labels.begin() + index;
-
-		data.erase(it_datos);
-		labels.erase(it_etiquetas);
-
-	}
+	// una unica copia de cada fila, en el orden de una permutacion aleatoria
+	Data_view<T> reordenados (data, labels, random_permutation(data.size()));
 
-	return std::make_pair(datos_reordenados, etiquetas_reordenados);
+	return reordenados.materialize();
 
 }
 
@@ -24,6 +24,15 @@ float Random :: get_float(const float HIGH){
 }
 
 
+void Random :: fill_float(std::vector<double> & valores, const float LOW, const float HIGH){
+	// una sola distribucion para todo el vector, con los mismos valores que get_float
+	std::uniform_real_distribution<> dis(LOW, HIGH);
+
+	for (unsigned i = 0; i < valores.size(); i++){
+		valores[i] = static_cast<float>(dis(generator_));
+	}
+}
+
 int Random :: get_int(const int LOW, const int HIGH){
 	std::uniform_int_distribution<> dis(LOW, HIGH - 1);
 	return dis(generator_);
@@ -38,4 +47,8 @@ std::mt19937 Random :: get_generator() {
 }
 
 
-std::mt19937 Random :: generator_;
+void Random :: set_generator(const std::mt19937 & generador) {
+	generator_ = generador;
+}
+
+thread_local std::mt19937 Random :: generator_;
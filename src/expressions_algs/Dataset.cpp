@@ -0,0 +1,845 @@
+#include "expressions_algs/Dataset.hpp"
+#include "expressions_algs/aux_expressions_alg.hpp"
+#include "expressions_algs/Task_scheduler.hpp"
+
+#include <charconv>
+#include <limits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace expressions_algs {
+
+namespace {
+
+/**
+  * @brief Parte de un fichero proyectado formada por lineas enteras
+  */
+
+struct Fragmento {
+	const char * inicio;
+	const char * fin;
+	unsigned num_filas = 0;
+	unsigned num_campos = 0;
+	bool irregular = false;
+};
+
+// tamaño minimo de un fragmento, con menos no compensa repartir el fichero
+const std::size_t TAM_MIN_FRAGMENTO = 1 << 16;
+
+// bytes de texto que se leen antes de liberar sus paginas, cuando se convierte sin cargar el fichero
+const std::size_t TAM_LIBERAR = 1 << 22;
+
+// filas minimas que copia cada tarea, con menos no compensa repartirlas
+const unsigned FILAS_MIN_TAREA = 10000;
+
+// final de la linea que comienza en inicio, sin incluir el salto de linea
+inline const char * fin_linea(const char * inicio, const char * fin) {
+	const char * salto = static_cast<const char *>(std::memchr(inicio, '\n', fin - inicio));
+
+	return salto == nullptr ? fin : salto;
+}
+
+// igual que el lector por lineas: se ignoran las lineas vacias, los comentarios y las que empiezan por un blanco
+inline bool es_linea_datos(const char * inicio, const char * fin, const char comment_char) {
+	return inicio < fin && *inicio != comment_char && *inicio != ' ' && *inicio != '\t';
+}
+
+// convierte un campo como lo haria strtod, que ignora los espacios iniciales y acepta el signo +
+double leer_campo(const char * inicio, const char * fin) {
+	const char * primero = inicio;
+
+	while ( primero < fin && std::isspace(static_cast<unsigned char>(*primero)) ) {
+		primero++;
+	}
+
+	if ( primero + 1 < fin && *primero == '+' && primero[1] != '-' ) {
+		primero++;
+	}
+
+	double valor = 0.0;
+	const std::from_chars_result leido = std::from_chars(primero, fin, valor);
+
+	// desbordamientos y hexadecimales se dejan a strtod para mantener sus resultados
+	if ( leido.ec == std::errc::result_out_of_range ||
+		  ( leido.ec == std::errc() && leido.ptr < fin && (*leido.ptr == 'x' || *leido.ptr == 'X') ) ) {
+		valor = std::strtod(std::string(inicio, fin).c_str(), nullptr);
+	} else if ( leido.ec != std::errc() ) {
+		valor = 0.0;
+	}
+
+	return valor;
+}
+
+// proyecta un fichero entero para leerlo; un fichero vacio no se puede proyectar y queda sin datos
+bool proyectar_fichero(const std::string & fichero, const char * & datos, std::size_t & tam) {
+	const int descriptor = open(fichero.c_str(), O_RDONLY);
+
+	if ( descriptor == -1 ) {
+		return false;
+	}
+
+	struct stat info;
+
+	if ( fstat(descriptor, &info) == -1 ) {
+		close(descriptor);
+		return false;
+	}
+
+	tam = info.st_size;
+	datos = nullptr;
+
+	void * proyeccion = tam == 0 ? nullptr : mmap(nullptr, tam, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	close(descriptor);
+
+	if ( proyeccion == MAP_FAILED ) {
+		return false;
+	}
+
+	if ( tam > 0 ) {
+		madvise(proyeccion, tam, MADV_SEQUENTIAL);
+		datos = static_cast<const char *>(proyeccion);
+	}
+
+	return true;
+}
+
+// libera las paginas ya leidas de una proyeccion, desde la que contiene inicio hasta la anterior a fin
+void liberar_paginas(const char * inicio, const char * fin) {
+	static const std::uintptr_t tam_pagina = sysconf(_SC_PAGESIZE);
+
+	const std::uintptr_t primera = (reinterpret_cast<std::uintptr_t>(inicio) / tam_pagina) * tam_pagina;
+	const std::uintptr_t ultima = (reinterpret_cast<std::uintptr_t>(fin) / tam_pagina) * tam_pagina;
+
+	if ( primera < ultima ) {
+		madvise(reinterpret_cast<void *>(primera), ultima - primera, MADV_DONTNEED);
+	}
+}
+
+// divide el texto en un fragmento por hebra, cada uno empieza justo despues de un salto de linea,
+// y cuenta en paralelo las filas y los campos de cada fragmento, liberando lo ya contado si se pide
+std::vector<Fragmento> contar_fragmentos(const char * comienzo, const char * final,
+													  const char comment_char, const char delimiter,
+													  const bool liberar) {
+	const std::size_t tam = final - comienzo;
+	unsigned num_fragmentos = Task_scheduler::global().get_num_threads();
+
+	num_fragmentos = std::max(std::min<std::size_t>(num_fragmentos, tam / TAM_MIN_FRAGMENTO), std::size_t(1));
+
+	std::vector<Fragmento> fragmentos (num_fragmentos);
+
+	for ( unsigned f = 0; f < num_fragmentos; f++) {
+		const char * inicio = f == 0 ? comienzo : fragmentos[f - 1].fin;
+		const char * fin = final;
+
+		if ( f + 1 < num_fragmentos ) {
+			fin = std::max(inicio, comienzo + (tam * (f + 1)) / num_fragmentos);
+			fin = fin < final ? fin_linea(fin, final) : final;
+			fin = fin < final ? fin + 1 : final;
+		}
+
+		fragmentos[f].inicio = inicio;
+		fragmentos[f].fin = fin;
+	}
+
+	Task_scheduler::global().parallel_for(0, num_fragmentos, 1, [&](const unsigned f) {
+		Fragmento & fragmento = fragmentos[f];
+		const char * linea = fragmento.inicio;
+		const char * liberada = fragmento.inicio;
+
+		while ( linea < fragmento.fin ) {
+			const char * fin = fin_linea(linea, fragmento.fin);
+
+			if ( liberar && static_cast<std::size_t>(fin - liberada) >= TAM_LIBERAR ) {
+				liberar_paginas(liberada, linea);
+				liberada = linea;
+			}
+
+			if ( es_linea_datos(linea, fin, comment_char) ) {
+				const unsigned campos = std::count(linea, fin, delimiter) + 1;
+
+				if ( fragmento.num_filas == 0 ) {
+					fragmento.num_campos = campos;
+				} else if ( campos != fragmento.num_campos ) {
+					fragmento.irregular = true;
+				}
+
+				fragmento.num_filas++;
+			}
+
+			linea = fin + 1;
+		}
+	});
+
+	return fragmentos;
+}
+
+// convierte una linea de datos: las variables, separadas paso valores, y la etiqueta, el ultimo campo
+inline void leer_fila(const char * linea, const char * fin, const char delimiter, const unsigned num_columnas,
+							 double * valores, const std::size_t paso, double & etiqueta) {
+	const char * campo = linea;
+
+	for ( unsigned j = 0; j < num_columnas; j++) {
+		const char * fin_campo = std::find(campo, fin, delimiter);
+
+		valores[j * paso] = leer_campo(campo, fin_campo);
+		campo = fin_campo + 1;
+	}
+
+	etiqueta = leer_campo(campo, fin);
+}
+
+/**
+  * @brief Cabecera de un fichero binario de datos
+  */
+
+struct Cabecera_binaria {
+	char magic[8];
+	std::uint32_t version;
+	std::uint32_t num_columns;
+	std::uint64_t num_rows;
+	std::uint64_t column_stride;
+	std::uint64_t data_offset;
+	std::uint64_t content_hash;
+	std::uint64_t reserved[2];
+};
+
+static_assert(sizeof(Cabecera_binaria) == 64, "La cabecera binaria ocupa 64 bytes");
+
+// version del formato binario, y tipo de columna de valores double
+const std::uint32_t VERSION_BINARIA = 1;
+const std::uint8_t COLUMNA_DOUBLE = 1;
+
+// redondea hacia arriba a un multiplo de alineamiento
+inline std::uint64_t redondear(const std::uint64_t valor, const std::uint64_t alineamiento) {
+	return ((valor + alineamiento - 1) / alineamiento) * alineamiento;
+}
+
+// hash FNV-1a por palabras de 64 bits, continuando a partir de un hash previo
+std::uint64_t hash_palabras(const double * valores, const std::size_t num_valores,
+									 std::uint64_t hash = 14695981039346656037ULL) {
+	for ( std::size_t i = 0; i < num_valores; i++) {
+		std::uint64_t palabra;
+		std::memcpy(&palabra, valores + i, sizeof(palabra));
+
+		hash ^= palabra;
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+// valores que se leen o escriben de una vez al recorrer las columnas de un fichero binario
+const std::size_t VALORES_BLOQUE_BINARIO = 1 << 16;
+
+// cabecera de un fichero binario de num_columnas columnas, la etiqueta incluida, sin el hash
+Cabecera_binaria crear_cabecera(const std::uint32_t num_columnas, const std::uint64_t num_filas) {
+	Cabecera_binaria cabecera;
+	std::memset(&cabecera, 0, sizeof(cabecera));
+	std::memcpy(cabecera.magic, Dataset::BINARY_MAGIC, sizeof(cabecera.magic));
+
+	cabecera.version = VERSION_BINARIA;
+	cabecera.num_columns = num_columnas;
+	cabecera.num_rows = num_filas;
+	cabecera.column_stride = redondear(num_filas, Dataset::BINARY_ALIGNMENT / sizeof(double));
+	cabecera.data_offset = redondear(sizeof(Cabecera_binaria) + num_columnas * (sizeof(std::uint64_t) + 1),
+												Dataset::BINARY_ALIGNMENT);
+
+	return cabecera;
+}
+
+// posicion en el fichero binario de la fila dada de una columna
+inline std::uint64_t posicion_binaria(const Cabecera_binaria & cabecera, const unsigned columna,
+												  const std::uint64_t fila) {
+	return cabecera.data_offset + (columna * cabecera.column_stride + fila) * sizeof(double);
+}
+
+// escribe un bloque entero en una posicion, aunque pwrite lo escriba en varias veces
+bool escribir_en(const int descriptor, const void * datos, std::size_t bytes, std::uint64_t posicion) {
+	const char * actual = static_cast<const char *>(datos);
+
+	while ( bytes > 0 ) {
+		const ssize_t escritos = pwrite(descriptor, actual, bytes, posicion);
+
+		if ( escritos <= 0 ) {
+			return false;
+		}
+
+		actual += escritos;
+		bytes -= escritos;
+		posicion += escritos;
+	}
+
+	return true;
+}
+
+// escribe la cabecera y la tabla de columnas, y deja a cero el espacio de las columnas
+bool escribir_cabecera(const int descriptor, const Cabecera_binaria & cabecera) {
+	std::vector<char> inicio (cabecera.data_offset, 0);
+	char * tabla = inicio.data() + sizeof(Cabecera_binaria);
+
+	std::memcpy(inicio.data(), &cabecera, sizeof(cabecera));
+
+	for ( unsigned j = 0; j < cabecera.num_columns; j++) {
+		const std::uint64_t desplazamiento = posicion_binaria(cabecera, j, 0);
+
+		std::memcpy(tabla + j * sizeof(std::uint64_t), &desplazamiento, sizeof(desplazamiento));
+		tabla[cabecera.num_columns * sizeof(std::uint64_t) + j] = COLUMNA_DOUBLE;
+	}
+
+	return ftruncate(descriptor, posicion_binaria(cabecera, cabecera.num_columns, 0)) == 0 &&
+			 escribir_en(descriptor, inicio.data(), inicio.size(), 0);
+}
+
+// hash de las columnas de un fichero binario ya escrito, leyendolas por bloques
+bool hash_fichero(const int descriptor, const Cabecera_binaria & cabecera, std::uint64_t & hash) {
+	const std::uint64_t total = cabecera.num_columns * cabecera.column_stride;
+	std::vector<double> bloque (VALORES_BLOQUE_BINARIO);
+
+	hash = 14695981039346656037ULL;
+
+	for ( std::uint64_t leidos = 0; leidos < total; ) {
+		const std::size_t num_valores = std::min<std::uint64_t>(bloque.size(), total - leidos);
+		const std::size_t bytes = num_valores * sizeof(double);
+
+		if ( pread(descriptor, bloque.data(), bytes, cabecera.data_offset + leidos * sizeof(double)) !=
+			  static_cast<ssize_t>(bytes) ) {
+			return false;
+		}
+
+		hash = hash_palabras(bloque.data(), num_valores, hash);
+		leidos += num_valores;
+	}
+
+	return true;
+}
+
+} // namespace
+
+
+Dataset :: Dataset()
+	:num_rows_(0), num_columns_(0), row_stride_(0), column_stride_(1), features_(nullptr), content_hash_(0),
+	 mapped_(false), stream_window_bytes_(STREAM_WINDOW_BYTES)
+{}
+
+Dataset :: Dataset(const unsigned num_columns, std::vector<double> && values, std::vector<double> && labels)
+	:num_rows_(labels.size()), num_columns_(num_columns), row_stride_(num_columns), column_stride_(1),
+	 labels_(std::move(labels)), content_hash_(0), mapped_(false), stream_window_bytes_(STREAM_WINDOW_BYTES)
+{
+	auto valores = std::make_shared<const std::vector<double> >(std::move(values));
+
+	features_ = valores->data();
+	storage_ = valores;
+}
+
+Dataset :: Dataset(const std::vector<std::vector<double> > & data, const std::vector<double> & labels)
+	:Dataset()
+{
+	const unsigned num_columnas = data.empty() ? 0 : data[0].size();
+	std::vector<double> valores (data.size() * num_columnas, 0.0);
+
+	// las filas con distinto numero de variables se recortan o se completan con ceros
+	for ( unsigned i = 0; i < data.size(); i++) {
+		const unsigned num_copiar = std::min(static_cast<unsigned>(data[i].size()), num_columnas);
+
+		std::copy(data[i].begin(), data[i].begin() + num_copiar, valores.begin() + i * num_columnas);
+	}
+
+	(*this) = Dataset(num_columnas, std::move(valores), std::vector<double>(labels));
+}
+
+unsigned Dataset :: get_num_rows() const {
+	return num_rows_;
+}
+
+unsigned Dataset :: get_num_columns() const {
+	return num_columns_;
+}
+
+const double * Dataset :: get_row(const unsigned row) const {
+	const std::size_t fila = row_index_ ? (*row_index_)[row] : row;
+
+	return features_ + fila * row_stride_;
+}
+
+std::size_t Dataset :: get_column_stride() const {
+	return column_stride_;
+}
+
+double Dataset :: get_value(const unsigned row, const unsigned column) const {
+	return get_row(row)[column * column_stride_];
+}
+
+std::vector<double> Dataset :: get_row_values(const unsigned row) const {
+	std::vector<double> resultado (num_columns_);
+
+	for ( unsigned j = 0; j < num_columns_; j++) {
+		resultado[j] = get_value(row, j);
+	}
+
+	return resultado;
+}
+
+const std::vector<double> & Dataset :: get_labels() const {
+	return labels_;
+}
+
+std::uint64_t Dataset :: get_content_hash() const {
+	return content_hash_;
+}
+
+bool Dataset :: is_mapped() const {
+	return mapped_;
+}
+
+unsigned Dataset :: get_stream_rows() const {
+	unsigned filas = num_rows_;
+
+	if ( mapped_ && !row_index_ ) {
+		// una ventana incluye la etiqueta de cada fila
+		const std::size_t tam_fila = (num_columns_ + 1) * sizeof(double);
+
+		filas = std::min<std::size_t>(std::max<std::size_t>(stream_window_bytes_ / tam_fila, 1), num_rows_);
+	}
+
+	return filas;
+}
+
+std::size_t Dataset :: get_stream_window_bytes() const {
+	return stream_window_bytes_;
+}
+
+void Dataset :: set_stream_window_bytes(const std::size_t bytes) {
+	stream_window_bytes_ = bytes;
+}
+
+void Dataset :: prefetch_rows(const unsigned first, const unsigned last) const {
+	advise_rows(first, last, MADV_WILLNEED, false);
+}
+
+void Dataset :: release_rows(const unsigned first, const unsigned last) const {
+	// solo se liberan las paginas que no comparten con las filas vecinas
+	advise_rows(first, last, MADV_DONTNEED, true);
+}
+
+void Dataset :: advise_rows(const unsigned first, const unsigned last, const int advice,
+									 const bool whole_pages) const {
+	// las filas de una vista no estan seguidas en la proyeccion
+	if ( !mapped_ || row_index_ || first >= last ) {
+		return ;
+	}
+
+	static const std::uintptr_t tam_pagina = sysconf(_SC_PAGESIZE);
+
+	// las filas ocupan un tramo de cada columna, la de la etiqueta incluida
+	for ( unsigned j = 0; j <= num_columns_; j++) {
+		const double * columna = features_ + j * column_stride_;
+
+		std::uintptr_t inicio = reinterpret_cast<std::uintptr_t>(columna + first);
+		std::uintptr_t fin = reinterpret_cast<std::uintptr_t>(columna + last);
+
+		if ( whole_pages ) {
+			inicio = ((inicio + tam_pagina - 1) / tam_pagina) * tam_pagina;
+			fin = (fin / tam_pagina) * tam_pagina;
+		} else {
+			inicio = (inicio / tam_pagina) * tam_pagina;
+			fin = ((fin + tam_pagina - 1) / tam_pagina) * tam_pagina;
+		}
+
+		if ( inicio < fin ) {
+			madvise(reinterpret_cast<void *>(inicio), fin - inicio, advice);
+		}
+	}
+}
+
+std::vector<std::vector<double> > Dataset :: to_matrix() const {
+	std::vector<std::vector<double> > resultado (num_rows_);
+
+	Task_scheduler::global().parallel_for(0, num_rows_, FILAS_MIN_TAREA, [&](const unsigned i) {
+		resultado[i] = get_row_values(i);
+	});
+
+	return resultado;
+}
+
+Dataset Dataset :: select_rows(const std::vector<std::uint32_t> & rows) const {
+	std::vector<double> valores (rows.size() * num_columns_);
+	std::vector<double> etiquetas (rows.size());
+
+	Task_scheduler::global().parallel_for(0, rows.size(), FILAS_MIN_TAREA, [&](const std::size_t i) {
+		for ( unsigned j = 0; j < num_columns_; j++) {
+			valores[i * num_columns_ + j] = get_value(rows[i], j);
+		}
+
+		etiquetas[i] = labels_[rows[i]];
+	});
+
+	return Dataset(num_columns_, std::move(valores), std::move(etiquetas));
+}
+
+Dataset Dataset :: view_rows(std::vector<std::uint32_t> rows) const {
+	Dataset vista;
+
+	vista.num_rows_ = rows.size();
+	vista.num_columns_ = num_columns_;
+	vista.row_stride_ = row_stride_;
+	vista.column_stride_ = column_stride_;
+	vista.storage_ = storage_;
+	vista.features_ = features_;
+	vista.mapped_ = mapped_;
+	vista.stream_window_bytes_ = stream_window_bytes_;
+	vista.labels_.resize(rows.size());
+
+	for ( std::size_t i = 0; i < rows.size(); i++) {
+		vista.labels_[i] = labels_[rows[i]];
+
+		// la vista de una vista apunta directamente a las filas originales
+		if ( row_index_ ) {
+			rows[i] = (*row_index_)[rows[i]];
+		}
+	}
+
+	vista.row_index_ = std::make_shared<const std::vector<std::uint32_t> >(std::move(rows));
+
+	return vista;
+}
+
+bool Dataset :: is_view() const {
+	return row_index_ != nullptr;
+}
+
+bool Dataset :: read_file(const std::string & data_file, const char comment_char,
+								  const char delimiter, Dataset & dataset) {
+
+	const char * comienzo;
+	std::size_t tam;
+
+	if ( !proyectar_fichero(data_file, comienzo, tam) ) {
+		return false;
+	}
+
+	// un fichero vacio no tiene datos
+	if ( tam == 0 ) {
+		dataset = Dataset();
+		return true;
+	}
+
+	// primera pasada: contamos las filas y los campos de cada fragmento
+	const std::vector<Fragmento> fragmentos = contar_fragmentos(comienzo, comienzo + tam, comment_char, delimiter, false);
+	const unsigned num_fragmentos = fragmentos.size();
+
+	// posicion de la primera fila de cada fragmento en la matriz
+	std::vector<unsigned> primera_fila (num_fragmentos, 0);
+	unsigned num_filas = 0;
+	unsigned num_campos = 0;
+	bool regular = true;
+
+	for ( unsigned f = 0; f < num_fragmentos; f++) {
+		primera_fila[f] = num_filas;
+		num_filas += fragmentos[f].num_filas;
+
+		if ( fragmentos[f].num_filas > 0 ) {
+			regular = regular && !fragmentos[f].irregular &&
+						 (num_campos == 0 || num_campos == fragmentos[f].num_campos);
+			num_campos = fragmentos[f].num_campos;
+		}
+	}
+
+	if ( regular ) {
+		const unsigned num_columnas = num_filas > 0 ? num_campos - 1 : 0;
+
+		std::vector<double> valores (static_cast<std::size_t>(num_filas) * num_columnas);
+		std::vector<double> etiquetas (num_filas);
+
+		// segunda pasada: cada fragmento escribe directamente en sus filas de la matriz
+		Task_scheduler::global().parallel_for(0, num_fragmentos, 1, [&](const unsigned f) {
+			const char * linea = fragmentos[f].inicio;
+			unsigned fila = primera_fila[f];
+
+			while ( linea < fragmentos[f].fin ) {
+				const char * fin = fin_linea(linea, fragmentos[f].fin);
+
+				if ( es_linea_datos(linea, fin, comment_char) ) {
+					leer_fila(linea, fin, delimiter, num_columnas,
+								 valores.data() + static_cast<std::size_t>(fila) * num_columnas, 1, etiquetas[fila]);
+					fila++;
+				}
+
+				linea = fin + 1;
+			}
+		});
+
+		dataset = Dataset(num_columnas, std::move(valores), std::move(etiquetas));
+	}
+
+	munmap(const_cast<char *>(comienzo), tam);
+
+	return regular;
+}
+
+bool Dataset :: write_binary(const std::string & data_file) const {
+
+	Cabecera_binaria cabecera = crear_cabecera(num_columns_ + 1, num_rows_);
+
+	const int descriptor = open(data_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+	if ( descriptor == -1 ) {
+		return false;
+	}
+
+	bool escrito = escribir_cabecera(descriptor, cabecera);
+
+	// cada columna se escribe por bloques, la etiqueta la ultima; el hash sigue el orden del fichero
+	std::vector<double> bloque (std::min<std::uint64_t>(VALORES_BLOQUE_BINARIO, cabecera.column_stride));
+
+	cabecera.content_hash = 14695981039346656037ULL;
+
+	for ( unsigned j = 0; j < cabecera.num_columns && escrito; j++) {
+		for ( std::uint64_t primera = 0; primera < cabecera.column_stride && escrito; primera += bloque.size()) {
+			const std::size_t num_valores = std::min<std::uint64_t>(bloque.size(), cabecera.column_stride - primera);
+
+			// las filas de relleno del final de la columna son ceros
+			for ( std::size_t i = 0; i < num_valores; i++) {
+				const std::uint64_t fila = primera + i;
+
+				bloque[i] = fila >= num_rows_ ? 0.0 : j < num_columns_ ? get_value(fila, j) : labels_[fila];
+			}
+
+			cabecera.content_hash = hash_palabras(bloque.data(), num_valores, cabecera.content_hash);
+			escrito = escribir_en(descriptor, bloque.data(), num_valores * sizeof(double),
+										 posicion_binaria(cabecera, j, primera));
+		}
+	}
+
+	// con todas las columnas escritas ya se conoce el hash de la cabecera
+	escrito = escrito && escribir_en(descriptor, &cabecera, sizeof(cabecera), 0);
+
+	return close(descriptor) == 0 && escrito;
+}
+
+bool Dataset :: convert_text_file(const std::string & text_file, const std::string & binary_file,
+											 const char comment_char, const char delimiter,
+											 unsigned & num_rows, unsigned & num_columns) {
+
+	const char * comienzo;
+	std::size_t tam;
+
+	if ( !proyectar_fichero(text_file, comienzo, tam) ) {
+		return false;
+	}
+
+	if ( tam == 0 ) {
+		return false;
+	}
+
+	const char * final = comienzo + tam;
+
+	// primera pasada: filas y campos, para saber donde empieza cada columna en el fichero binario
+	const std::vector<Fragmento> fragmentos = contar_fragmentos(comienzo, final, comment_char, delimiter, true);
+	unsigned num_filas = 0;
+	unsigned num_campos = 0;
+	bool regular = true;
+
+	for ( const Fragmento & fragmento : fragmentos ) {
+		num_filas += fragmento.num_filas;
+
+		if ( fragmento.num_filas > 0 ) {
+			regular = regular && !fragmento.irregular && (num_campos == 0 || num_campos == fragmento.num_campos);
+			num_campos = fragmento.num_campos;
+		}
+	}
+
+	// las paginas del texto ya contadas se vuelven a leer del fichero cuando hagan falta
+	liberar_paginas(comienzo, final);
+
+	const int descriptor = regular && num_filas > 0 ?
+								  open(binary_file.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644) : -1;
+
+	if ( descriptor == -1 ) {
+		munmap(const_cast<char *>(comienzo), tam);
+		return false;
+	}
+
+	const unsigned num_columnas = num_campos - 1;
+
+	Cabecera_binaria cabecera = crear_cabecera(num_columnas + 1, num_filas);
+
+	bool escrito = escribir_cabecera(descriptor, cabecera);
+
+	// segunda pasada: el texto se convierte por bloques de filas, cada uno en memoria por columnas
+	const unsigned filas_bloque = std::max<std::size_t>(STREAM_WINDOW_BYTES / ((num_columnas + 1) * sizeof(double)), 1);
+
+	std::vector<const char *> lineas;
+	std::vector<const char *> fines;
+	std::vector<double> bloque;
+
+	const char * linea = comienzo;
+	unsigned primera_fila = 0;
+
+	while ( primera_fila < num_filas && escrito ) {
+		const char * inicio_bloque = linea;
+
+		lineas.clear();
+		fines.clear();
+
+		// las lineas de datos del bloque, para convertirlas en paralelo
+		while ( lineas.size() < filas_bloque && linea < final ) {
+			const char * fin = fin_linea(linea, final);
+
+			if ( es_linea_datos(linea, fin, comment_char) ) {
+				lineas.push_back(linea);
+				fines.push_back(fin);
+			}
+
+			linea = fin + 1;
+		}
+
+		const unsigned filas = lineas.size();
+
+		bloque.resize(static_cast<std::size_t>(filas) * (num_columnas + 1));
+
+		Task_scheduler::global().parallel_for(0, filas, FILAS_MIN_TAREA, [&](const unsigned i) {
+			leer_fila(lineas[i], fines[i], delimiter, num_columnas, bloque.data() + i, filas,
+						 bloque[static_cast<std::size_t>(num_columnas) * filas + i]);
+		});
+
+		for ( unsigned j = 0; j <= num_columnas && escrito; j++) {
+			escrito = escribir_en(descriptor, bloque.data() + static_cast<std::size_t>(j) * filas,
+										 filas * sizeof(double), posicion_binaria(cabecera, j, primera_fila));
+		}
+
+		liberar_paginas(inicio_bloque, std::min(linea, final));
+		primera_fila += filas;
+	}
+
+	munmap(const_cast<char *>(comienzo), tam);
+
+	// tercera pasada: el hash recorre las columnas en el orden del fichero
+	escrito = escrito && hash_fichero(descriptor, cabecera, cabecera.content_hash) &&
+				 escribir_en(descriptor, &cabecera, sizeof(cabecera), 0);
+
+	escrito = close(descriptor) == 0 && escrito;
+
+	if ( escrito ) {
+		num_rows = num_filas;
+		num_columns = num_columnas;
+	}
+
+	return escrito;
+}
+
+bool Dataset :: is_binary_file(const std::string & data_file) {
+	std::ifstream entrada (data_file, std::ios::binary);
+	char magic[sizeof(Cabecera_binaria::magic)] = {};
+
+	entrada.read(magic, sizeof(magic));
+
+	return entrada && std::memcmp(magic, BINARY_MAGIC, sizeof(magic)) == 0;
+}
+
+bool Dataset :: map_binary(const std::string & data_file, Dataset & dataset, const bool verify_hash) {
+
+	const int descriptor = open(data_file.c_str(), O_RDONLY);
+
+	if ( descriptor == -1 ) {
+		return false;
+	}
+
+	struct stat info;
+
+	if ( fstat(descriptor, &info) == -1 || static_cast<std::size_t>(info.st_size) < sizeof(Cabecera_binaria) ) {
+		close(descriptor);
+		return false;
+	}
+
+	const std::size_t tam = info.st_size;
+
+	void * proyeccion = mmap(nullptr, tam, PROT_READ, MAP_SHARED, descriptor, 0);
+	close(descriptor);
+
+	if ( proyeccion == MAP_FAILED ) {
+		return false;
+	}
+
+	// la proyeccion se libera cuando no quede ninguna copia del dataset que la use
+	std::shared_ptr<const void> almacen (proyeccion, [tam](const void * p) {
+		munmap(const_cast<void *>(p), tam);
+	});
+
+	const char * base = static_cast<const char *>(proyeccion);
+
+	Cabecera_binaria cabecera;
+	std::memcpy(&cabecera, base, sizeof(cabecera));
+
+	const std::uint64_t bytes_tabla = cabecera.num_columns * (sizeof(std::uint64_t) + 1);
+
+	// la cabecera puede estar corrupta: los productos solo se calculan despues de comprobar
+	// con divisiones que caben en el fichero, asi ninguno se desborda
+	bool valido = std::memcmp(cabecera.magic, BINARY_MAGIC, sizeof(cabecera.magic)) == 0 &&
+					  cabecera.version == VERSION_BINARIA && cabecera.num_columns >= 1 &&
+					  cabecera.num_rows <= std::numeric_limits<unsigned>::max() &&
+					  cabecera.column_stride >= cabecera.num_rows &&
+					  cabecera.data_offset % BINARY_ALIGNMENT == 0 &&
+					  cabecera.data_offset >= sizeof(Cabecera_binaria) + bytes_tabla &&
+					  cabecera.data_offset <= tam &&
+					  cabecera.column_stride <= (tam - cabecera.data_offset) / sizeof(double) / cabecera.num_columns;
+
+	// todas las columnas son de doubles y estan seguidas, a la misma distancia
+	for ( unsigned j = 0; j < cabecera.num_columns && valido; j++) {
+		std::uint64_t desplazamiento;
+		std::memcpy(&desplazamiento, base + sizeof(Cabecera_binaria) + j * sizeof(std::uint64_t),
+						sizeof(desplazamiento));
+
+		const std::uint8_t tipo = base[sizeof(Cabecera_binaria) + cabecera.num_columns * sizeof(std::uint64_t) + j];
+
+		valido = tipo == COLUMNA_DOUBLE &&
+					desplazamiento == cabecera.data_offset + j * cabecera.column_stride * sizeof(double);
+	}
+
+	const double * columnas = valido ? reinterpret_cast<const double *>(base + cabecera.data_offset) : nullptr;
+
+	if ( valido && verify_hash ) {
+		valido = hash_palabras(columnas, cabecera.num_columns * cabecera.column_stride) == cabecera.content_hash;
+	}
+
+	if ( valido ) {
+		const unsigned num_columnas = cabecera.num_columns - 1;
+		const double * etiquetas = columnas + num_columnas * cabecera.column_stride;
+
+		Dataset resultado;
+
+		resultado.num_rows_ = cabecera.num_rows;
+		resultado.num_columns_ = num_columnas;
+		resultado.row_stride_ = 1;
+		resultado.column_stride_ = cabecera.column_stride;
+		resultado.storage_ = almacen;
+		resultado.features_ = columnas;
+		resultado.labels_.assign(etiquetas, etiquetas + cabecera.num_rows);
+		resultado.content_hash_ = cabecera.content_hash;
+		resultado.mapped_ = true;
+
+		dataset = std::move(resultado);
+	}
+
+	return valido;
+}
+
+Dataset Dataset :: load(const std::string & data_file, const char comment_char, const char delimiter) {
+	Dataset resultado;
+
+	if ( is_binary_file(data_file) ) {
+		if ( !map_binary(data_file, resultado) ) {
+			std::cerr << "Error al abrir " << data_file << std::endl;
+		}
+	} else if ( !read_file(data_file, comment_char, delimiter, resultado) ) {
+		// lineas con distinto numero de campos, o un fichero que no se puede proyectar
+		auto leidos = preprocess::read_data<double>(data_file, comment_char, delimiter);
+
+		resultado = Dataset(leidos.first, leidos.second);
+	}
+
+	return resultado;
+}
+
+} // namespace expressions_algs
@@ -0,0 +1,60 @@
+#include "expressions_algs/Evaluation_scheduler.hpp"
+#include "expressions_algs/Task_scheduler.hpp"
+
+namespace expressions_algs {
+
+Evaluation_scheduler :: Evaluation_scheduler(const unsigned num_individuals, const unsigned long total_length,
+															const unsigned num_rows, const unsigned num_threads)
+	:axis_(EvaluationAxis::INDIVIDUALS), row_blocks_(1), num_threads_(std::max(num_threads, 1u))
+{
+
+	const unsigned long trabajo = total_length * num_rows;
+
+	// si hay poco trabajo no compensa crear los hilos
+	if ( trabajo < MIN_PARALLEL_WORK ) {
+		num_threads_ = 1;
+	}
+
+	const unsigned max_bloques = std::max(num_rows / MIN_ROWS_PER_BLOCK, 1u);
+	const unsigned tareas_necesarias = TASKS_PER_THREAD * num_threads_;
+
+	// con suficientes individuos para todas las hebras, o con pocos datos, basta con repartir individuos
+	if ( num_threads_ > 1 && num_individuals > 0 && num_individuals < tareas_necesarias && max_bloques > 1 ) {
+
+		row_blocks_ = std::min((tareas_necesarias + num_individuals - 1) / num_individuals, max_bloques);
+
+		// si hay muy pocos individuos cada uno se reparte entero por filas
+		if ( num_individuals * 2 <= num_threads_ ) {
+			axis_ = EvaluationAxis::ROWS;
+		} else {
+			axis_ = EvaluationAxis::TILES;
+		}
+	}
+
+}
+
+EvaluationAxis Evaluation_scheduler :: get_axis() const {
+	return axis_;
+}
+
+unsigned Evaluation_scheduler :: get_row_blocks() const {
+	return row_blocks_;
+}
+
+unsigned Evaluation_scheduler :: get_num_threads() const {
+	return num_threads_;
+}
+
+bool Evaluation_scheduler :: cache_blocking(const unsigned num_rows, const unsigned long row_bytes) const {
+	return axis_ == EvaluationAxis::INDIVIDUALS && num_rows * row_bytes > L2_CACHE_BYTES;
+}
+
+unsigned Evaluation_scheduler :: cache_block_rows(const unsigned long row_bytes) {
+	return std::max(CACHE_BLOCK_BYTES / std::max(row_bytes, 1UL), 1UL);
+}
+
+unsigned Evaluation_scheduler :: available_threads() {
+	return Task_scheduler::global().get_num_threads();
+}
+
+} // namespace expressions_algs
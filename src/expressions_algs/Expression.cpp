@@ -1,5 +1,7 @@
 #include "expressions_algs/Expression.hpp"
 
+#include <map>
+
 
 namespace expressions_algs {
 
@@ -29,6 +31,12 @@ Expression :: Expression(const std::vector<Node> & subtree, const unsigned max_d
 Expression :: Expression(const unsigned max_length, const double prob_variable,
 							const unsigned num_vars, const unsigned max_depth){
 
+	Expression::initialize_random(max_length, prob_variable, num_vars, max_depth);
+}
+
+void Expression :: initialize_random(const unsigned max_length, const double prob_variable,
+												 const unsigned num_vars, const unsigned max_depth){
+
 	max_depth_ = max_depth;
 
 	num_variables_ = num_vars;
@@ -229,6 +237,8 @@ void Expression :: initialize_empty(){
 	// una expresion vacia no tiene arbol
 	tree_ = std::vector<Node>();
 	num_variables_ = 0;
+	parents_fitness_ = std::make_pair(std::numeric_limits<double>::infinity(),
+												 std::numeric_limits<double>::infinity());
 	no_longer_evaluated();
 }
 
@@ -238,6 +248,8 @@ void Expression :: copy_data(const Expression & otra){
 	// copiamos todos los valores
 	fitness_            = otra.fitness_;
 	is_evaluated_           = otra.is_evaluated_;
+	is_estimated_           = otra.is_estimated_;
+	parents_fitness_        = otra.parents_fitness_;
 	max_depth_ = otra.max_depth_;
 	num_variables_   = otra.num_variables_;
 	tree_              = otra.tree_;
@@ -245,6 +257,19 @@ void Expression :: copy_data(const Expression & otra){
 }
 
 
+void Expression :: move_data(Expression & otra) noexcept {
+	fitness_            = otra.fitness_;
+	is_evaluated_           = otra.is_evaluated_;
+	is_estimated_           = otra.is_estimated_;
+	parents_fitness_        = otra.parents_fitness_;
+	max_depth_ = otra.max_depth_;
+	num_variables_   = otra.num_variables_;
+
+	// el arbol se roba, la otra queda vacia
+	tree_ = std::move(otra.tree_);
+	otra.tree_.clear();
+}
+
 Expression :: Expression(const Expression & otra){
 	// al initialize vacia mantenemos la prfuncidad que queramos
 	max_depth_ = otra.max_depth_;
@@ -256,6 +281,22 @@ Expression :: Expression(const Expression & otra){
 	(*this) = otra;
 }
 
+Expression :: Expression(Expression && otra) noexcept
+	:fitness_(otra.fitness_), is_evaluated_(otra.is_evaluated_), is_estimated_(otra.is_estimated_),
+	 parents_fitness_(otra.parents_fitness_), max_depth_(otra.max_depth_),
+	 tree_(std::move(otra.tree_)), num_variables_(otra.num_variables_)
+{
+	otra.tree_.clear();
+}
+
+Expression & Expression :: operator= (Expression && otra) noexcept {
+	if (this != &otra){
+		move_data(otra);
+	}
+
+	return (*this);
+}
+
 Expression & Expression :: operator= (const Expression & otra){
 	// si no es ella misma
 	if (this != &otra){
@@ -338,7 +379,7 @@ double Expression :: get_number ( const Node & n) const {
 }
 
 double Expression :: evaluate_data(std::stack<Node> & pila,
-										const std::vector<double> & dato) const {
+										const double * dato, const std::size_t paso) const {
 
 	double resultado = 0.0;
 
@@ -357,7 +398,7 @@ double Expression :: evaluate_data(std::stack<Node> & pila,
 	} else if (pila.top().get_node_type() == NodeType::VARIABLE){
 		// si es una variable, la consultamos en el dato dado, eliminamos el nodo
 		// de la pila y devolvemos el value del dato
-		resultado = dato[pila.top().get_value()];
+		resultado = dato[pila.top().get_value() * paso];
 		pila.pop();
 
 	} else {
@@ -368,8 +409,8 @@ double Expression :: evaluate_data(std::stack<Node> & pila,
 		pila.pop();
 
 		// consultamos el value de la rama izquierda y la derecha
-		double valor_izda = evaluate_data(pila, dato);
-		double valor_dcha = evaluate_data(pila, dato);
+		double valor_izda = evaluate_data(pila, dato, paso);
+		double valor_dcha = evaluate_data(pila, dato, paso);
 
 		// aplicamos el operador con ambas ramas y devolvemos el resultado
 		if (operacion == NodeType::PLUS){
@@ -396,6 +437,10 @@ double Expression :: evaluate_data(std::stack<Node> & pila,
 }
 
 double Expression :: evaluate_data(const std::vector<double> & dato) const {
+	return evaluate_data(dato.data(), 1);
+}
+
+double Expression :: evaluate_data(const double * dato, const std::size_t paso) const {
 	double resultado;
 
 	// pila donde almacenaremos la expresion
@@ -407,7 +452,7 @@ double Expression :: evaluate_data(const std::vector<double> & dato) const {
 	}
 
 	// la evaluamos para el dato i
-	resultado = evaluate_data(pila, dato);
+	resultado = evaluate_data(pila, dato, paso);
 
 	return resultado;
 
@@ -429,11 +474,7 @@ void Expression :: evaluate_expression(const std::vector<std::vector<double>> &d
 	if ( (!is_evaluated_ || evaluar) && tree_.size() > 0){
 
 		// para cada dato
-		for (unsigned i = 0; i < data.size(); i++){
-
-			// la evaluamos para el dato i
-			valores_predecidos[i] = evaluate_data(data[i]);
-		}
+		predict_rows(data, 0, data.size(), valores_predecidos);
 
 		// hacemos la media de los cuadrados
 		resultado = f_evaluacion(valores_predecidos, labels);
@@ -443,13 +484,132 @@ void Expression :: evaluate_expression(const std::vector<std::vector<double>> &d
 	// actualizamos el fitness y que esta evaluada y devolvemos el resultado
 	fitness_ = resultado;
 	is_evaluated_ = true;
+	is_estimated_ = false;
+
+}
+
+void Expression :: evaluate_expression(const Dataset & data,
+											  const std::vector<double> & labels,
+										  	  aux::eval_function_t f_evaluacion,
+										  	  const bool evaluar){
+
+	// si no esta evaluada y el arbol contiene una expresion
+	if ( (!is_evaluated_ || evaluar) && tree_.size() > 0){
+		const aux::MetricReduction reduccion = aux::get_metric_reduction(f_evaluacion);
+
+		if ( reduccion != aux::MetricReduction::NONE ) {
+			// la metrica se acumula por ventanas de filas, sin guardar las predicciones
+			aux::dispatch_metric(reduccion, [&](const auto metrica) {
+				const std::size_t paso = data.get_column_stride();
+				const unsigned filas_ventana = std::max(data.get_stream_rows(), 1u);
+				auto suma = metrica.init();
+
+				for ( unsigned inicio = 0; inicio < data.get_num_rows(); inicio += filas_ventana) {
+					const unsigned fin = std::min(inicio + filas_ventana, data.get_num_rows());
+
+					data.prefetch_rows(fin, std::min(fin + filas_ventana, data.get_num_rows()));
+
+					for ( unsigned fila = inicio; fila < fin; fila++) {
+						suma = metrica.accumulate(suma, evaluate_data(data.get_row(fila), paso), labels[fila]);
+					}
+
+					data.release_rows(inicio, fin);
+				}
+
+				fitness_ = metrica.finalize(suma, labels.size());
+			});
+		} else {
+			fitness_ = f_evaluacion(predict(data), labels);
+		}
+	}
+
+	is_evaluated_ = true;
+	is_estimated_ = false;
+
+}
+
+aux::Metrics Expression :: evaluate_metrics(const std::vector<std::vector<double>> & data,
+														  const std::vector<double> & labels,
+														  const std::vector<aux::eval_function_t> & funciones) const {
+	std::vector<double> valores_predecidos (labels.size());
+
+	predict_rows(data, 0, data.size(), valores_predecidos);
+
+	return aux::compute_metrics(valores_predecidos, labels, funciones);
+}
+
+aux::Metrics Expression :: evaluate_metrics(const Dataset & data,
+														  const std::vector<double> & labels,
+														  const std::vector<aux::eval_function_t> & funciones) const {
+	// se predice una sola vez, todas las metricas salen de las mismas predicciones
+	return aux::compute_metrics(predict(data), labels, funciones);
+}
+
+std::vector<double> Expression :: predict(const Dataset & data) const {
+	std::vector<double> valores_predecidos (data.get_num_rows());
+	const unsigned filas_ventana = std::max(data.get_stream_rows(), 1u);
+
+	// recorremos los datos por ventanas, leyendo la siguiente mientras se predice la actual
+	for ( unsigned inicio = 0; inicio < data.get_num_rows(); inicio += filas_ventana) {
+		const unsigned fin = std::min(inicio + filas_ventana, data.get_num_rows());
+
+		data.prefetch_rows(fin, std::min(fin + filas_ventana, data.get_num_rows()));
+		predict_rows(data, inicio, fin, valores_predecidos);
+		data.release_rows(inicio, fin);
+	}
+
+	return valores_predecidos;
+}
+
+void Expression :: predict_rows(const Dataset & data,
+										 const unsigned primera, const unsigned ultima,
+										 std::vector<double> & predicciones) const {
+	const std::size_t paso = data.get_column_stride();
+
+	for (unsigned i = primera; i < ultima; i++){
+		// la evaluamos para el dato i
+		predicciones[i] = evaluate_data(data.get_row(i), paso);
+	}
+}
 
+void Expression :: predict_rows(const std::vector<std::vector<double>> & data,
+										 const unsigned primera, const unsigned ultima,
+										 std::vector<double> & predicciones) const {
+	for (unsigned i = primera; i < ultima; i++){
+		// la evaluamos para el dato i
+		predicciones[i] = evaluate_data(data[i]);
+	}
+}
+
+void Expression :: set_fitness(const double fitness){
+	fitness_ = fitness;
+	is_evaluated_ = true;
+	is_estimated_ = false;
 }
 
 bool Expression :: is_evaluated() const{
 	return is_evaluated_;
 }
 
+bool Expression :: is_estimated() const{
+	return is_estimated_;
+}
+
+void Expression :: set_estimated_fitness(const double estimacion){
+	// el fitness es solo una estimacion, la expresion sigue sin estar evaluada
+	fitness_ = estimacion;
+	is_evaluated_ = false;
+	is_estimated_ = true;
+}
+
+void Expression :: set_parents_fitness(const double primer_padre, const double segundo_padre){
+	parents_fitness_ = std::make_pair(primer_padre, segundo_padre);
+}
+
+std::pair<double, double> Expression :: get_parents_fitness() const{
+	return parents_fitness_;
+}
+
 double Expression :: get_fitness() const{
 	return fitness_;
 }
@@ -458,6 +618,81 @@ unsigned Expression :: get_tree_length() const{
 	return tree_.size();
 }
 
+void Expression :: write(std::ostream & os) const {
+	aux::write_binary(os, fitness_);
+	aux::write_binary(os, static_cast<std::uint8_t>(is_evaluated_));
+	aux::write_binary(os, static_cast<std::uint8_t>(is_estimated_));
+	aux::write_binary(os, parents_fitness_.first);
+	aux::write_binary(os, parents_fitness_.second);
+	aux::write_binary(os, static_cast<std::uint32_t>(max_depth_));
+	aux::write_binary(os, static_cast<std::uint32_t>(num_variables_));
+	aux::write_binary(os, static_cast<std::uint32_t>(tree_.size()));
+
+	// el valor numerico se escribe entero, asi no se pierde precision como en la forma de texto
+	for ( const Node & nodo : tree_ ) {
+		aux::write_binary(os, static_cast<std::uint8_t>(nodo.get_node_type()));
+		aux::write_binary(os, static_cast<std::int32_t>(nodo.get_value()));
+		aux::write_binary(os, nodo.get_numeric_value());
+	}
+}
+
+bool Expression :: read(std::istream & is) {
+	double fitness;
+	std::uint8_t evaluada, estimada;
+	std::pair<double, double> padres;
+	std::uint32_t profundidad, num_variables, num_nodos;
+
+	bool correcto = aux::read_binary(is, fitness) && aux::read_binary(is, evaluada) &&
+						 aux::read_binary(is, estimada) && aux::read_binary(is, padres.first) &&
+						 aux::read_binary(is, padres.second) && aux::read_binary(is, profundidad) &&
+						 aux::read_binary(is, num_variables) && aux::read_binary(is, num_nodos) &&
+						 profundidad > 0 && num_nodos <= MAX_SERIALIZED_LENGTH;
+
+	std::vector<Node> arbol;
+
+	// en preorden cada operador necesita dos operandos mas, cada termino cubre uno
+	unsigned pendientes = 1;
+
+	for ( std::uint32_t i = 0; i < num_nodos && correcto; i++) {
+		std::uint8_t tipo;
+		std::int32_t valor;
+		double valor_numerico;
+
+		correcto = aux::read_binary(is, tipo) && aux::read_binary(is, valor) &&
+					  aux::read_binary(is, valor_numerico) &&
+					  tipo <= static_cast<std::uint8_t>(NodeType::DIVISION) && pendientes > 0;
+
+		if ( correcto ) {
+			Node nodo;
+			nodo.set_node_type(static_cast<NodeType>(tipo));
+			nodo.set_value(valor);
+			nodo.set_numeric_value(valor_numerico);
+
+			if ( nodo.get_node_type() == NodeType::NUMBER || nodo.get_node_type() == NodeType::VARIABLE ) {
+				pendientes--;
+			} else {
+				pendientes++;
+			}
+
+			arbol.push_back(nodo);
+		}
+	}
+
+	correcto = correcto && ( arbol.empty() || pendientes == 0 );
+
+	if ( correcto ) {
+		fitness_ = fitness;
+		is_evaluated_ = evaluada != 0;
+		is_estimated_ = estimada != 0;
+		parents_fitness_ = padres;
+		max_depth_ = profundidad;
+		num_variables_ = num_variables;
+		tree_ = std::move(arbol);
+	}
+
+	return correcto;
+}
+
 
 
 bool Expression :: exchange_subtree(const Expression & otra, const unsigned pos,
@@ -470,7 +705,7 @@ bool Expression :: exchange_subtree(const Expression & otra, const unsigned pos,
 
 	//Expression padre_cortado((otra.tree_ + cruce_padre), otra.max_depth_);
 
-	std::vector<Node> padre_cortado = get_subtree(otra.get_tree(), cruce_padre);
+	std::vector<Node> padre_cortado = get_subtree(otra.tree_, cruce_padre);
 
 	// sumamos, la parte de la mom, la length de la parte del dad, y lo que nos queda de mom tras el cruce
 	unsigned nueva_longitud = pos + padre_cortado.size() + (get_tree_length() - madre_cortada.size() - pos);
@@ -513,26 +748,97 @@ bool Expression :: exchange_subtree(const Expression & otra, const unsigned pos,
 
 void Expression :: tree_crossover(const Expression & otra, Expression & son1, Expression & son2) const {
 
-	int punto_cruce_madre;
-	int punto_cruce_padre;
+	const std::vector<unsigned> tam_madre = get_subtree_sizes();
+	const std::vector<unsigned> tam_padre = otra.get_subtree_sizes();
 
-	bool cruce_mal;
+	const long longitud_madre = get_tree_length();
+	const long longitud_padre = otra.get_tree_length();
 
-	// cruzamos mientras se cruce mal
-	do {
+	// numero de subarboles del padre con cada tamaño o menos
+	std::vector<unsigned> acumulados (longitud_padre + 1, 0);
+
+	for ( unsigned j = 0; j < tam_padre.size(); j++) {
+		acumulados[tam_padre[j]]++;
+	}
+
+	for ( unsigned t = 1; t < acumulados.size(); t++) {
+		acumulados[t] += acumulados[t - 1];
+	}
+
+	// un subarbol del padre de tamaño t cabe en el punto i de la madre si los dos hijos caben en su
+	// profundidad maxima: t <= tam_madre[i] + max_depth_ - longitud_madre y
+	// t >= tam_madre[i] + longitud_padre - otra.max_depth_
+	auto rango = [&](const unsigned i) {
+		const long minimo = std::max(static_cast<long>(tam_madre[i]) + longitud_padre - static_cast<long>(otra.max_depth_), 1L);
+		const long maximo = std::min(static_cast<long>(tam_madre[i]) + static_cast<long>(max_depth_) - longitud_madre, longitud_padre);
+
+		return std::make_pair(minimo, maximo);
+	};
 
-		punto_cruce_madre = Random::get_int(get_tree_length());
-		punto_cruce_padre = Random::get_int(otra.get_tree_length());
+	auto posibles = [&](const unsigned i) {
+		const auto limites = rango(i);
 
-		cruce_mal = !(exchange_subtree(otra, punto_cruce_madre, punto_cruce_padre, son1));
+		return limites.first > limites.second ? 0 : acumulados[limites.second] - acumulados[limites.first - 1];
+	};
 
-		if ( !cruce_mal ) {
-			cruce_mal = !(otra.exchange_subtree((*this), punto_cruce_padre, punto_cruce_madre, son2));
+	long total = 0;
+
+	for ( unsigned i = 0; i < tam_madre.size(); i++) {
+		total += posibles(i);
+	}
+
+	// si no hay ningun par de puntos valido los hijos se quedan como estaban
+	if ( total > 0 ) {
+		// elegir un par valido al azar es lo mismo que repetir el cruce hasta que salga uno valido
+		long elegido = Random::get_int(static_cast<int>(total));
+		unsigned punto_cruce_madre = 0;
+
+		while ( elegido >= posibles(punto_cruce_madre) ) {
+			elegido -= posibles(punto_cruce_madre);
+			punto_cruce_madre++;
 		}
 
-	} while (cruce_mal);
+		const auto limites = rango(punto_cruce_madre);
+		unsigned punto_cruce_padre = 0;
+
+		// el elegido-esimo subarbol del padre con un tamaño valido
+		for ( unsigned j = 0; j < tam_padre.size(); j++) {
+			if ( tam_padre[j] >= limites.first && tam_padre[j] <= limites.second ) {
+				if ( elegido == 0 ) {
+					punto_cruce_padre = j;
+					break;
+				}
+
+				elegido--;
+			}
+		}
+
+		exchange_subtree(otra, punto_cruce_madre, punto_cruce_padre, son1);
+		otra.exchange_subtree((*this), punto_cruce_padre, punto_cruce_madre, son2);
+	}
+
+}
+
+std::vector<unsigned> Expression :: get_subtree_sizes() const {
+
+	std::vector<unsigned> tamanios (tree_.size());
+	std::stack<unsigned> pila;
+
+	// recorriendo el preorden al reves, los dos hijos de un operador ya estan en la pila
+	for ( int i = static_cast<int>(tree_.size()) - 1; i >= 0; i--) {
+		tamanios[i] = 1;
 
+		if ( tree_[i].get_node_type() != NodeType::NUMBER && tree_[i].get_node_type() != NodeType::VARIABLE ) {
+			for ( unsigned rama = 0; rama < 2 && !pila.empty(); rama++) {
+				tamanios[i] += pila.top();
+				pila.pop();
+			}
+		}
 
+		pila.push(tamanios[i]);
+	}
+
+	return tamanios;
 }
 
 
@@ -546,6 +852,7 @@ void Expression :: assign_tree (const std::vector<Node> & nuevo_arbol) {
 void Expression :: no_longer_evaluated(){
 	// ponemos la flag a false y establecemos el fitness a NaN
 	is_evaluated_ = false;
+	is_estimated_ = false;
 	fitness_ = std::numeric_limits<double>::infinity();
 }
 
@@ -739,21 +1046,94 @@ void Expression :: mutate_GP (const int num_vars) {
 			tree_[posicion].set_random_node_type();
 		}
 	} else {
-		// generamos un arbol aleatorio en la posicion
+		// generamos un arbol aleatorio en la posicion, con los nodos que deja libres la profundidad maxima
+		const unsigned tam_cortado = get_subtree(tree_, posicion).size();
+		const long libres = static_cast<long>(max_depth_) - static_cast<long>(tree_.size()) + tam_cortado;
+		const unsigned presupuesto = std::max(std::min(libres, static_cast<long>(max_depth_)), 1L);
+
+		std::vector<Node> arbol_hijo;
+		arbol_hijo.reserve(tree_.size() - tam_cortado + presupuesto);
+
+		// el subarbol se escribe directamente entre las dos partes que se conservan
+		arbol_hijo.insert(arbol_hijo.end(), tree_.begin(), tree_.begin() + posicion);
+		append_random_subtree(max_depth_, presupuesto, 0.3, num_vars, arbol_hijo);
+		arbol_hijo.insert(arbol_hijo.end(), tree_.begin() + posicion + tam_cortado, tree_.end());
+
+		tree_ = std::move(arbol_hijo);
+
+	}
+
+}
+
+const std::vector<double> & Expression :: subtree_fit_probabilities(const unsigned longitud_maxima,
+																						  const unsigned presupuesto) {
+
+	static thread_local std::map<std::pair<unsigned, unsigned>, std::vector<double> > tablas;
 
-		bool cruce_mal;
-		Expression hijo = (*this);
+	std::vector<double> & tabla = tablas[std::make_pair(longitud_maxima, presupuesto)];
 
-		do {
+	if ( tabla.empty() ) {
+		const unsigned ancho = presupuesto + 1;
+		tabla.assign((presupuesto + 1) * ancho, 0.0);
 
-			Expression exp_aleatorio(max_depth_, 0.3, num_vars, max_depth_);
+		// desde el final: con i nodos y sin ramas libres el arbol ha terminado dentro del presupuesto
+		for ( int i = presupuesto; i >= 0; i--) {
+			tabla[i * ancho] = 1.0;
 
-			cruce_mal = !(exchange_subtree(exp_aleatorio, posicion, 0, hijo));
+			// con r ramas libres hacen falta al menos r nodos mas
+			for ( unsigned r = 1; r + i <= presupuesto; r++) {
+				// misma probabilidad de operador que generate_random_expression
+				const float prob_terminal = static_cast<float>(r*r+1) / static_cast<float>(longitud_maxima-i);
+				const double prob_operador = std::max(1.0 - prob_terminal, 0.0);
 
-		} while (cruce_mal);
+				const double sigue_operador = r + 1 + i + 1 <= presupuesto ? tabla[(i + 1) * ancho + r + 1] : 0.0;
 
-		assign_tree(hijo.tree_);
+				tabla[i * ancho + r] = prob_operador * sigue_operador +
+											  (1.0 - prob_operador) * tabla[(i + 1) * ancho + r - 1];
+			}
+		}
+	}
+
+	return tabla;
+}
+
+void Expression :: append_random_subtree(const unsigned longitud_maxima, const unsigned presupuesto,
+													  const double prob_variable, const unsigned num_variables,
+													  std::vector<Node> & arbol) {
+
+	const std::vector<double> & tabla = subtree_fit_probabilities(longitud_maxima, presupuesto);
+	const unsigned ancho = presupuesto + 1;
+
+	unsigned ramas_libres = 1;
+
+	for ( unsigned i = 0; ramas_libres > 0; i++) {
+		const float prob_terminal = static_cast<float>(ramas_libres*ramas_libres+1) /
+											 static_cast<float>(longitud_maxima-i);
+		const double prob_operador = std::max(1.0 - prob_terminal, 0.0);
+
+		const double sigue_operador = ramas_libres + 1 + i + 1 <= presupuesto ?
+												tabla[(i + 1) * ancho + ramas_libres + 1] : 0.0;
 
+		// probabilidad de un operador sabiendo que el arbol cabe en el presupuesto
+		const double prob_condicionada = prob_operador * sigue_operador / tabla[i * ancho + ramas_libres];
+
+		arbol.emplace_back();
+		Node & nodo = arbol.back();
+
+		if ( Random::get_float() < prob_condicionada ) {
+			nodo.set_random_node_type();
+			ramas_libres++;
+		} else {
+			if ( Random::get_float() < prob_variable ) {
+				nodo.set_node_type(NodeType::VARIABLE);
+				nodo.set_random_term(num_variables);
+			} else {
+				nodo.set_node_type(NodeType::NUMBER);
+				nodo.set_numeric_value(Random::get_float(-10.0, 10.0));
+			}
+
+			ramas_libres--;
+		}
 	}
 
 }
@@ -0,0 +1,86 @@
+#include "expressions_algs/Fold_executor.hpp"
+#include "expressions_algs/Task_scheduler.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace expressions_algs {
+
+Fold_executor :: Fold_executor(const unsigned num_folds, const unsigned num_threads)
+	:num_folds_(num_folds), fold_times_(num_folds, 0.0), wall_time_(0.0)
+{
+
+	// las hebras que sobran al repartir los folds las toman los bucles paralelos de cada fold
+	concurrent_folds_ = std::max(std::min(num_folds, num_threads), 1u);
+
+}
+
+void Fold_executor :: run(const std::function<void(const unsigned)> & fold_task) {
+
+	const auto inicio = std::chrono::steady_clock::now();
+
+	// cada fold fija su propia semilla, la hebra actual recupera despues su generador
+	const std::mt19937 generador = Random::get_generator();
+
+	// cada tarea toma folds hasta que no quedan, asi solo hay concurrent_folds_ a la vez; los
+	// bucles paralelos de cada fold comparten las hebras del planificador con los demas folds
+	std::atomic<unsigned> siguiente (0);
+	Task_group grupo;
+
+	for ( unsigned tarea = 0; tarea < concurrent_folds_; tarea++) {
+		grupo.run([this, &siguiente, &fold_task]() {
+			unsigned fold;
+
+			while ( ( fold = siguiente++ ) < num_folds_ ) {
+				const auto inicio_fold = std::chrono::steady_clock::now();
+
+				fold_task(fold);
+
+				fold_times_[fold] = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio_fold).count();
+			}
+		});
+	}
+
+	// la hebra actual tambien ejecuta folds mientras espera
+	grupo.wait();
+
+	Random::set_generator(generador);
+
+	wall_time_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+}
+
+unsigned Fold_executor :: get_concurrent_folds() const {
+	return concurrent_folds_;
+}
+
+const std::vector<double> & Fold_executor :: get_fold_times() const {
+	return fold_times_;
+}
+
+double Fold_executor :: get_wall_time() const {
+	return wall_time_;
+}
+
+double Fold_executor :: get_speedup() const {
+	double suma = 0.0;
+
+	for ( unsigned i = 0; i < fold_times_.size(); i++) {
+		suma += fold_times_[i];
+	}
+
+	return wall_time_ > 0.0 ? suma / wall_time_ : 1.0;
+}
+
+unsigned long Fold_executor :: fold_seed(const unsigned long seed, const unsigned fold) {
+	// splitmix64, semillas muy distintas para folds consecutivos
+	std::uint64_t semilla = seed + (fold + 1) * 0x9E3779B97F4A7C15ULL;
+
+	semilla = (semilla ^ (semilla >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	semilla = (semilla ^ (semilla >> 27)) * 0x94D049BB133111EBULL;
+
+	return semilla ^ (semilla >> 31);
+}
+
+} // namespace expressions_algs
@@ -36,6 +36,12 @@ GA_P_Expression :: GA_P_Expression(const std::vector<Node> & subtree, const unsi
 GA_P_Expression :: GA_P_Expression(const unsigned max_length, const double prob_variable,
 							const unsigned num_vars, const unsigned max_depth){
 
+	GA_P_Expression::initialize_random(max_length, prob_variable, num_vars, max_depth);
+}
+
+void GA_P_Expression :: initialize_random(const unsigned max_length, const double prob_variable,
+														const unsigned num_vars, const unsigned max_depth){
+
 	max_depth_ = max_depth;
 
 	initialize_empty();
@@ -53,9 +59,7 @@ GA_P_Expression :: GA_P_Expression(const unsigned max_length, const double prob_
 void GA_P_Expression :: initialize_chromosome(const unsigned length){
 	chromosome_.resize(length);
 	// para cada elemento escogemos un numero aleatorio en [-10, 10]
-	for (unsigned i = 0; i < chromosome_.size(); i++){
-		chromosome_[i] = Random::get_float(-10.0f, 10.0f);
-	}
+	Random::fill_float(chromosome_, -10.0f, 10.0f);
 
 }
 
@@ -82,6 +86,29 @@ GA_P_Expression :: GA_P_Expression(const GA_P_Expression & otra) : Expression(ot
 
 }
 
+void GA_P_Expression :: move_data(GA_P_Expression & otra) noexcept {
+
+	Expression::move_data(otra);
+
+	chromosome_ = std::move(otra.chromosome_);
+	otra.chromosome_.clear();
+}
+
+GA_P_Expression :: GA_P_Expression(GA_P_Expression && otra) noexcept
+	:Expression(std::move(otra)), chromosome_(std::move(otra.chromosome_))
+{
+	otra.chromosome_.clear();
+}
+
+GA_P_Expression & GA_P_Expression :: operator= (GA_P_Expression && otra) noexcept {
+	// si no es ella misma
+	if (this != &otra){
+		move_data(otra);
+	}
+
+	return (*this);
+}
+
 
 
 GA_P_Expression & GA_P_Expression :: operator= (const GA_P_Expression & otra){
@@ -231,6 +258,33 @@ void GA_P_Expression :: assign_chromosome(const std::vector<double> & new_chromo
 	chromosome_ = new_chromosome;
 }
 
+void GA_P_Expression :: write(std::ostream & os) const {
+	Expression::write(os);
+
+	aux::write_binary(os, static_cast<std::uint32_t>(chromosome_.size()));
+
+	for ( const double gen : chromosome_ ) {
+		aux::write_binary(os, gen);
+	}
+}
+
+bool GA_P_Expression :: read(std::istream & is) {
+	std::uint32_t longitud = 0;
+	bool correcto = Expression::read(is) && aux::read_binary(is, longitud) && longitud <= MAX_SERIALIZED_LENGTH;
+
+	std::vector<double> cromosoma (correcto ? longitud : 0);
+
+	for ( std::uint32_t i = 0; i < cromosoma.size() && correcto; i++) {
+		correcto = aux::read_binary(is, cromosoma[i]);
+	}
+
+	if ( correcto ) {
+		chromosome_ = std::move(cromosoma);
+	}
+
+	return correcto;
+}
+
 bool GA_P_Expression :: same_niche(const GA_P_Expression & otra) const {
 
 	bool resultado = chromosome_.size() == otra.get_tree_length();
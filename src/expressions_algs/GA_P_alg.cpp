@@ -11,6 +11,14 @@ GA_P_alg :: GA_P_alg(const std::vector<std::vector<double> > & data, const std::
 
 }
 
+GA_P_alg :: GA_P_alg(const Dataset & data, const unsigned long seed, const unsigned population_size,
+				 const unsigned depth, const double prob_var) {
+	initialize_empty();
+	load_data(data);
+	initialize(seed, population_size, depth, prob_var);
+
+}
+
 
 
 GA_P_alg :: GA_P_alg(const std::string data_file, const char comment_char,
@@ -26,8 +34,113 @@ GA_P_alg :: GA_P_alg(const std::string data_file, const char comment_char,
 
 }
 
+std::unique_ptr<Population_alg<GA_P_Expression> > GA_P_alg :: clone() const {
+	return std::make_unique<GA_P_alg>(*this);
+}
+
+std::pair<bool, bool> GA_P_alg :: breed_intra_niche(const GA_P_Expression & mom, const GA_P_Expression & dad,
+																	 GA_P_Expression & son1, GA_P_Expression & son2,
+																	 const Parameters & parameters, const int generation,
+																	 const int num_generations) const {
+	std::pair<bool, bool> modificados = std::make_pair(false, false);
+
+	son1 = mom;
+	son2 = dad;
+
+	// cruce de la parte GA
+	if ( Random::get_float() < parameters.get_ga_crossover_probability() ) {
+		// cruce del cromosoma utilizando BLX_alfa
+		mom.blx_alpha_crossover(dad, son1, son2);
+		modificados.first = modificados.second = true;
+	}
+
+
+	if ( Random::get_float() < parameters.get_ga_mutation_probability() ) {
+		// mutacion GA en el primer hijo
+		son1.mutate_ga(generation, num_generations);
+		modificados.first = true;
+	}
+
+	if ( Random::get_float() < parameters.get_ga_mutation_probability() ) {
+		// mutacion GA en el segundo hijo
+		son2.mutate_ga(generation, num_generations);
+		modificados.second = true;
+	}
+
+	return modificados;
+}
+
+std::pair<bool, bool> GA_P_alg :: breed_inter_niche(const GA_P_Expression & mom, const GA_P_Expression & dad,
+																	 GA_P_Expression & son1, GA_P_Expression & son2,
+																	 const Parameters & parameters, const int generation,
+																	 const int num_generations) {
+	std::pair<bool, bool> modificados = std::make_pair(false, false);
+
+	son1 = mom;
+	son2 = dad;
+
+	// cruce de la parte GP
+	if ( Random::get_float() <  parameters.get_pg_crossover_probability() ) {
+		// cruce de programacion genetica, se intercambian arboles
+
+		mom.tree_crossover(dad, son1, son2);
+		modificados.first = modificados.second = true;
+	}
+
+	// cruce de la parte GA
+	if ( Random::get_float() < parameters.get_ga_crossover_probability() ) {
+		// cruce del cromosoma utilizando BLX_alfa
+		mom.blx_alpha_crossover(dad, son1, son2);
+		modificados.first = modificados.second = true;
+	}
+
+	// si no hay cruce, los hijos ya estaban con el value de los parents
+	if ( Random::get_float() < parameters.get_ga_mutation_probability() ) {
+		// mutacion GA en el primer hijo
+		son1.mutate_ga(generation, num_generations);
+		modificados.first = true;
+	}
+
+	if ( Random::get_float() < parameters.get_ga_mutation_probability() ) {
+		// mutacion GA en el segundo hijo
+		son2.mutate_ga(generation, num_generations);
+		modificados.second = true;
+	}
+
+
+	auto resultado_mut_gp = apply_GP_mutations(son1, son2, parameters.get_pg_mutation_probability());
+
+	modificados.first = modificados.first || resultado_mut_gp.first;
+	modificados.second = modificados.second || resultado_mut_gp.second;
+
+	return modificados;
+}
+
+std::pair<bool, bool> GA_P_alg :: breed(const GA_P_Expression & mom, const GA_P_Expression & dad,
+													 GA_P_Expression & son1, GA_P_Expression & son2,
+													 const Parameters & parameters, const int generation,
+													 const int num_generations) {
+
+	// sin poblacion ordenada en parejas, el cruce intra-nicho solo es posible si los padres comparten nicho
+	if ( parameters.get_ga_inter_niche_crossover_probability() < Random::get_float() && mom.same_niche(dad) ) {
+		return breed_intra_niche(mom, dad, son1, son2, parameters, generation, num_generations);
+	}
+
+	return breed_inter_niche(mom, dad, son1, son2, parameters, generation, num_generations);
+}
+
 void GA_P_alg :: fit(const Parameters & parameters) {
 
+	if ( parameters.get_steady_state() ) {
+		fit_steady_state(parameters);
+		return;
+	}
+
+	if ( parameters.get_pipelined() ) {
+		fit_pipelined(parameters);
+		return;
+	}
+
 
 	// en cada generation hacemos dos evaluaciones, así que si queremos cierto
 	// numero de evaluaciones, las generaciones serán la mitad
@@ -35,19 +148,15 @@ void GA_P_alg :: fit(const Parameters & parameters) {
 
 	int generation = 0;
 	int parent, mom;
-	bool modificado_hijo1;
-	bool modificado_hijo2;
 
 	// evaluo la poblacion al inicio
-	population_.evaluate_population(data_, output_data_, parameters.get_evaluation_functions());
+	evaluate_population(parameters);
 	// population_.ordenar();
 
 
 
 	GA_P_Expression mejor_individuo = population_.get_best_individual();
 
-	GA_P_Expression son1, son2;
-
 	bool cruce_intra_nicho_posible = true;
 
 	while ( generation < NUM_GENERACIONES) {
@@ -59,6 +168,10 @@ void GA_P_alg :: fit(const Parameters & parameters) {
 		cruzados.resize(population_.get_population_size(), false);
 		int primero_sin_cruzar = 0;
 
+		// primero se forman las parejas y el tipo de cruce de cada una, despues se cruzan en paralelo
+		std::vector<std::pair<unsigned, unsigned> > parejas;
+		std::vector<bool> intra_nicho;
+
 		for ( unsigned i = 0; i < population_.get_population_size(); i += 2){
 
 			mom = primero_sin_cruzar;
@@ -68,7 +181,6 @@ void GA_P_alg :: fit(const Parameters & parameters) {
 			cruzados[mom] = true;
 
 			cruce_intra_nicho_posible = false;
-			modificado_hijo1 = modificado_hijo2 = false;
 
 			if ( parameters.get_ga_inter_niche_crossover_probability() < Random::get_float() ){
 				// cruce intra-nicho
@@ -77,7 +189,6 @@ void GA_P_alg :: fit(const Parameters & parameters) {
 
 				cruce_intra_nicho_posible = parent != -1;
 
-				// aplicamos el cruce
 				if ( cruce_intra_nicho_posible) {
 					// ya he escogido a ese parent
 					cruzados[parent] = true;
@@ -87,30 +198,6 @@ void GA_P_alg :: fit(const Parameters & parameters) {
 						} while (cruzados[primero_sin_cruzar]);
 
 					}
-
-					son1 = population_[mom];
-					son2 = population_[parent];
-
-					// cruce de la parte GA
-					if ( Random::get_float() < parameters.get_ga_crossover_probability() ) {
-						// cruce del cromosoma utilizando BLX_alfa
-						population_[mom].blx_alpha_crossover(population_[parent], son1, son2);
-						modificado_hijo1 = modificado_hijo2 = true;
-					}
-
-
-					if ( Random::get_float() < parameters.get_ga_mutation_probability() ) {
-						// mutacion GP en el primer hijo
-						son1.mutate_ga(generation, NUM_GENERACIONES);
-						modificado_hijo1 = true;
-					}
-
-					if ( Random::get_float() < parameters.get_ga_mutation_probability() ) {
-						// mutacion GP en el segundo hijo
-						son2.mutate_ga(generation, NUM_GENERACIONES);
-						modificado_hijo2 = true;
-					}
-
 				}
 
 			}
@@ -123,65 +210,27 @@ void GA_P_alg :: fit(const Parameters & parameters) {
 					++primero_sin_cruzar;
 				} while (cruzados[primero_sin_cruzar]);
 				cruzados[parent] = true;
-
-				son1 = population_[mom];
-				son2 = population_[parent];
-
-				// cruce de la parte GP
-				if ( Random::get_float() <  parameters.get_pg_crossover_probability() ) {
-					// cruce de programacion genetica, se intercambian arboles
-
-					population_[mom].tree_crossover(population_[parent], son1, son2);
-					modificado_hijo1 = modificado_hijo2 = true;
-				}
-
-				// cruce de la parte GA
-				if ( Random::get_float() < parameters.get_ga_crossover_probability() ) {
-					// cruce del cromosoma utilizando BLX_alfa
-					population_[mom].blx_alpha_crossover(population_[parent], son1, son2);
-					modificado_hijo1 = modificado_hijo2 = true;
-				}
-
-				// si no hay cruce, los hijos ya estaban con el value de los parents
-				if ( Random::get_float() < parameters.get_ga_mutation_probability() ) {
-					// mutacion GP en el primer hijo
-					son1.mutate_ga(generation, NUM_GENERACIONES);
-					modificado_hijo1 = true;
-				}
-
-				if ( Random::get_float() < parameters.get_ga_mutation_probability() ) {
-					// mutacion GP en el segundo hijo
-					son2.mutate_ga(generation, NUM_GENERACIONES);
-					modificado_hijo2 = true;
-				}
-
-
-				auto resultado_mut_gp = apply_GP_mutations(son1, son2, parameters.get_pg_mutation_probability());
-
-				modificado_hijo1 = modificado_hijo1 || resultado_mut_gp.first;
-				modificado_hijo2 = modificado_hijo2 || resultado_mut_gp.second;
-
 			}
 
-
-			if ( modificado_hijo1 ) {
-				population_[mom] = son1;
-				population_[mom].no_longer_evaluated();
-			}
-
-			if ( modificado_hijo2) {
-				population_[parent] = son2;
-				population_[parent].no_longer_evaluated();
-			}
+			parejas.emplace_back(mom, parent);
+			intra_nicho.push_back(cruce_intra_nicho_posible);
 
 		}
 
+		// aplicamos los cruces
+		breed_pairs(parejas, [&](const unsigned pareja, const GA_P_Expression & madre, const GA_P_Expression & padre,
+										 GA_P_Expression & son1, GA_P_Expression & son2) {
+			return intra_nicho[pareja] ?
+					 breed_intra_niche(madre, padre, son1, son2, parameters, generation, NUM_GENERACIONES) :
+					 breed_inter_niche(madre, padre, son1, son2, parameters, generation, NUM_GENERACIONES);
+		});
+
 
 		apply_elitism(mejor_individuo);
-		population_.evaluate_population(data_, output_data_, parameters.get_evaluation_functions());
-		population_.ordenar();
+		evaluate_population(parameters);
 
-		mejor_individuo = population_[0];
+		// la evaluacion mantiene la elite de la poblacion, no hace falta ordenarla
+		mejor_individuo = population_.get_best_individual();
 
 		if ( parameters.get_show_evaluation() ) {
 			// mostramos el mejor individuo
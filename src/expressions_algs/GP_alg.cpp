@@ -12,6 +12,14 @@ GP_alg :: GP_alg(const std::vector<std::vector<double> > & data, const std::vect
 
 }
 
+GP_alg :: GP_alg(const Dataset & data, const unsigned long seed, const unsigned population_size,
+				 const unsigned depth, const double prob_var) {
+	initialize_empty();
+	load_data(data);
+	initialize(seed, population_size, depth, prob_var);
+
+}
+
 
 
 GP_alg :: GP_alg(const std::string data_file, const char comment_char,
@@ -32,71 +40,81 @@ GP_alg :: ~GP_alg() {
 }
 
 
-void GP_alg :: fit(const Parameters & parameters) {
+std::unique_ptr<Population_alg<Expression> > GP_alg :: clone() const {
+	return std::make_unique<GP_alg>(*this);
+}
 
-	const int NUM_GENERACIONES = parameters.get_num_evaluations() / static_cast<double>(population_.get_population_size());
+std::pair<bool, bool> GP_alg :: breed(const Expression & mom, const Expression & dad,
+												 Expression & son1, Expression & son2,
+												 const Parameters & parameters, const int, const int) {
+	std::pair<bool, bool> modificados = std::make_pair(false, false);
 
-	int generation = 0;
-	int parent, mom;
-	bool modificado_hijo1;
-	bool modificado_hijo2;
+	son1 = mom;
+	son2 = dad;
 
-	// evaluo la poblacion al inicio
-	population_.evaluate_population(data_, output_data_, parameters.get_evaluation_functions());
+	// cruce de la parte GP
+	if ( Random::get_float() < parameters.get_pg_crossover_probability() ) {
+		// cruce de programacion genetica, se intercambian arboles
 
-	Expression mejor_individuo = population_.get_best_individual();
+		mom.tree_crossover(dad, son1, son2);
+		modificados.first = modificados.second = true;
+	}
 
-	Expression son1, son2;
+	// si no hay cruce, los hijos ya estaban con el value de los parents
 
-	while ( generation < NUM_GENERACIONES) {
+	auto resultado_mut_gp = apply_GP_mutations(son1, son2, parameters.get_pg_mutation_probability());
 
-		// seleccionamos la poblacion a cruzar
-		population_ = tournament_selection(parameters.get_tournament_size());
+	modificados.first = modificados.first || resultado_mut_gp.first;
+	modificados.second = modificados.second || resultado_mut_gp.second;
 
-		// aplicamos los operadores geneticos
-		for ( unsigned i = 0; i < population_.get_population_size(); i += 2){
+	return modificados;
+}
 
-			mom = i;
-			parent = i + 1;
+void GP_alg :: fit(const Parameters & parameters) {
 
-			son1 = population_[mom];
-			son2 = population_[parent];
+	if ( parameters.get_steady_state() ) {
+		fit_steady_state(parameters);
+		return;
+	}
 
-			modificado_hijo1 = modificado_hijo2 = false;
+	if ( parameters.get_pipelined() ) {
+		fit_pipelined(parameters);
+		return;
+	}
 
-			// cruce de la parte GP
-			if ( Random::get_float() < parameters.get_pg_crossover_probability() ) {
-				// cruce de programacion genetica, se intercambian arboles
+	const int NUM_GENERACIONES = parameters.get_num_evaluations() / static_cast<double>(population_.get_population_size());
 
-				population_[mom].tree_crossover(population_[parent], son1, son2);
-				modificado_hijo1 = modificado_hijo2 = true;
-			}
+	int generation = 0;
 
-			// si no hay cruce, los hijos ya estaban con el value de los parents
+	// evaluo la poblacion al inicio
+	evaluate_population(parameters);
 
-			auto resultado_mut_gp = apply_GP_mutations(son1, son2, parameters.get_pg_mutation_probability());
+	Expression mejor_individuo = population_.get_best_individual();
 
-			modificado_hijo1 = modificado_hijo1 || resultado_mut_gp.first;
-			modificado_hijo2 = modificado_hijo2 || resultado_mut_gp.second;
+	while ( generation < NUM_GENERACIONES) {
 
-			if ( modificado_hijo1 ) {
-				population_[mom] = son1;
-				population_[mom].no_longer_evaluated();
-			}
+		// seleccionamos la poblacion a cruzar
+		population_ = tournament_selection(parameters.get_tournament_size());
 
-			if ( modificado_hijo2) {
-				population_[parent] = son2;
-				population_[parent].no_longer_evaluated();
-			}
+		// cada individuo se cruza con el siguiente
+		std::vector<std::pair<unsigned, unsigned> > parejas;
 
+		for ( unsigned i = 0; i + 1 < population_.get_population_size(); i += 2){
+			parejas.emplace_back(i, i + 1);
 		}
 
+		// aplicamos los operadores geneticos
+		breed_pairs(parejas, [&](const unsigned, const Expression & madre, const Expression & padre,
+										 Expression & son1, Expression & son2) {
+			return breed(madre, padre, son1, son2, parameters, generation, NUM_GENERACIONES);
+		});
+
 
 		apply_elitism(mejor_individuo);
 
 
 		// evaluamos
-		population_.evaluate_population(data_, output_data_, parameters.get_evaluation_functions());
+		evaluate_population(parameters);
 
 		mejor_individuo = population_.get_best_individual();
 
@@ -0,0 +1,222 @@
+#include "expressions_algs/Island_coordinator.hpp"
+#include "expressions_algs/Fold_executor.hpp"
+#include "expressions_algs/aux_expressions_alg.hpp"
+
+namespace expressions_algs {
+
+std::string Island_assignment :: encode() const {
+	std::ostringstream salida;
+
+	aux::write_binary(salida, static_cast<std::uint32_t>(island));
+	aux::write_binary(salida, static_cast<std::uint32_t>(num_islands));
+	aux::write_binary(salida, static_cast<std::uint64_t>(seed));
+	aux::write_binary(salida, static_cast<std::uint32_t>(migration_interval));
+	aux::write_binary(salida, static_cast<std::uint32_t>(num_migrants));
+
+	salida << configuration;
+
+	return salida.str();
+}
+
+bool Island_assignment :: decode(const std::string & payload) {
+	std::istringstream entrada (payload);
+	std::uint32_t isla, islas, intervalo, emigrantes;
+	std::uint64_t semilla;
+
+	const bool correcto = aux::read_binary(entrada, isla) && aux::read_binary(entrada, islas) &&
+								 aux::read_binary(entrada, semilla) && aux::read_binary(entrada, intervalo) &&
+								 aux::read_binary(entrada, emigrantes) && isla < islas && intervalo > 0;
+
+	if ( correcto ) {
+		island = isla;
+		num_islands = islas;
+		seed = semilla;
+		migration_interval = intervalo;
+		num_migrants = emigrantes;
+
+		// el resto del mensaje es la configuracion
+		configuration = payload.substr(entrada.tellg());
+	}
+
+	return correcto;
+}
+
+
+Island_coordinator :: Island_coordinator(const unsigned num_islands, const unsigned long seed,
+													  const unsigned migration_interval, const unsigned num_migrants,
+													  const MigrationTopology topology)
+	:num_islands_(std::max(num_islands, 1u)), seed_(seed), migration_interval_(std::max(migration_interval, 1u)),
+	 num_migrants_(num_migrants), topology_(topology), num_migrations_(0)
+{
+}
+
+bool Island_coordinator :: listen(const std::string & address) {
+	return listener_.listen(address);
+}
+
+const std::string & Island_coordinator :: get_address() const {
+	return listener_.get_address();
+}
+
+bool Island_coordinator :: run(const std::string & configuration) {
+	std::vector<Socket_channel> islas (num_islands_);
+	std::uint32_t tipo = 0;
+	std::string mensaje;
+
+	result_fitness_.clear();
+	results_.clear();
+	num_migrations_ = 0;
+
+	bool correcto = listener_.is_open();
+
+	// cada proceso recibe la isla que le toca por orden de conexion
+	for ( unsigned i = 0; i < num_islands_ && correcto; i++) {
+		islas[i] = listener_.accept();
+		correcto = islas[i].receive(tipo, mensaje) && tipo == static_cast<std::uint32_t>(IslandMessage::HELLO);
+	}
+
+	for ( unsigned i = 0; i < num_islands_ && correcto; i++) {
+		Island_assignment asignacion;
+		asignacion.island = i;
+		asignacion.num_islands = num_islands_;
+		asignacion.seed = seed_;
+		asignacion.migration_interval = migration_interval_;
+		asignacion.num_migrants = num_migrants_;
+		asignacion.configuration = configuration;
+
+		correcto = islas[i].send(static_cast<std::uint32_t>(IslandMessage::START), asignacion.encode());
+	}
+
+	// el mismo generador de destinos que Island_model
+	std::mt19937 generador (Fold_executor::fold_seed(seed_, num_islands_));
+	bool terminado = false;
+
+	while ( correcto && !terminado ) {
+		std::vector<std::string> mensajes (num_islands_);
+		std::vector<std::uint32_t> tipos (num_islands_);
+
+		// todas las islas terminan la epoca antes de repartir, en orden porque es una barrera
+		for ( unsigned i = 0; i < num_islands_ && correcto; i++) {
+			correcto = islas[i].receive(tipos[i], mensajes[i]) && tipos[i] == tipos[0] &&
+						  ( tipos[i] == static_cast<std::uint32_t>(IslandMessage::MIGRANTS) ||
+							 tipos[i] == static_cast<std::uint32_t>(IslandMessage::RESULT) );
+		}
+
+		if ( correcto && tipos[0] == static_cast<std::uint32_t>(IslandMessage::RESULT) ) {
+			for ( unsigned i = 0; i < num_islands_ && correcto; i++) {
+				double fitness = 0.0;
+				std::istringstream entrada (mensajes[i]);
+
+				correcto = aux::read_binary(entrada, fitness);
+
+				if ( correcto ) {
+					result_fitness_.push_back(fitness);
+					results_.push_back(mensajes[i].substr(sizeof(double)));
+				}
+			}
+
+			terminado = true;
+		} else if ( correcto ) {
+			// remitentes de cada isla, en orden creciente porque se recorren los emisores en orden
+			std::vector<std::vector<unsigned> > remitentes (num_islands_);
+
+			for ( unsigned i = 0; i < num_islands_; i++) {
+				for ( const unsigned destino : destinations(topology_, i, num_islands_, generador) ) {
+					remitentes[destino].push_back(i);
+				}
+			}
+
+			for ( unsigned i = 0; i < num_islands_ && correcto; i++) {
+				std::ostringstream buzon;
+				aux::write_binary(buzon, static_cast<std::uint32_t>(remitentes[i].size()));
+
+				for ( const unsigned remitente : remitentes[i] ) {
+					aux::write_binary(buzon, static_cast<std::uint64_t>(mensajes[remitente].size()));
+					buzon << mensajes[remitente];
+				}
+
+				correcto = islas[i].send(static_cast<std::uint32_t>(IslandMessage::INBOX), buzon.str());
+			}
+
+			num_migrations_++;
+		}
+	}
+
+	if ( !correcto ) {
+		result_fitness_.clear();
+		results_.clear();
+	}
+
+	return correcto;
+}
+
+unsigned Island_coordinator :: get_num_islands() const {
+	return num_islands_;
+}
+
+unsigned Island_coordinator :: get_num_migrations() const {
+	return num_migrations_;
+}
+
+unsigned Island_coordinator :: get_best_island() const {
+	unsigned mejor = 0;
+
+	for ( unsigned i = 1; i < result_fitness_.size(); i++) {
+		// un NaN nunca es el mejor, a igual fitness se queda la primera isla
+		if ( !std::isnan(result_fitness_[i]) &&
+			  ( std::isnan(result_fitness_[mejor]) || result_fitness_[i] < result_fitness_[mejor] ) ) {
+			mejor = i;
+		}
+	}
+
+	return mejor;
+}
+
+double Island_coordinator :: get_fitness(const unsigned island) const {
+	return result_fitness_[island];
+}
+
+const std::string & Island_coordinator :: get_result(const unsigned island) const {
+	return results_[island];
+}
+
+bool Island_coordinator :: join(const std::string & address, Socket_channel & channel,
+											Island_assignment & assignment, const unsigned attempts) {
+	std::uint32_t tipo = 0;
+	std::string mensaje;
+
+	return channel.connect(address, attempts) &&
+			 channel.send(static_cast<std::uint32_t>(IslandMessage::HELLO), "") &&
+			 channel.receive(tipo, mensaje) && tipo == static_cast<std::uint32_t>(IslandMessage::START) &&
+			 assignment.decode(mensaje);
+}
+
+std::vector<unsigned> Island_coordinator :: destinations(const MigrationTopology topology, const unsigned island,
+																			const unsigned num_islands, std::mt19937 & generator) {
+	std::vector<unsigned> resultado;
+
+	if ( num_islands > 1 ) {
+		if ( topology == MigrationTopology::RING ) {
+			resultado.push_back((island + 1) % num_islands);
+		} else if ( topology == MigrationTopology::RANDOM ) {
+			unsigned destino = std::uniform_int_distribution<unsigned>(0, num_islands - 2)(generator);
+
+			// se salta la propia isla
+			if ( destino >= island ) {
+				destino++;
+			}
+
+			resultado.push_back(destino);
+		} else {
+			for ( unsigned i = 0; i < num_islands; i++) {
+				if ( i != island ) {
+					resultado.push_back(i);
+				}
+			}
+		}
+	}
+
+	return resultado;
+}
+
+} // namespace expressions_algs
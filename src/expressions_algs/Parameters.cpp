@@ -16,7 +16,10 @@ Parameters :: Parameters(const int N_EVALS,
 	:num_evaluations_(N_EVALS), gp_crossover_probability_(PROB_CROSSOVER_GP),
 	 ga_crossover_probability_(PROB_CROSSOVER_GA), gp_mutation_probability_(PROB_MUTA_GP),
 	 ga_mutation_probability_(PROB_MUTA_GA), probabilidad_cruce_intranicho_(INTERNICHE_CROSSOVER_PROB),
-	 tournament_size_(TOURNAMENT_SIZE), show_evolution_(SHOW_EVOLUTION), eval_f_(f_eval)
+	 tournament_size_(TOURNAMENT_SIZE), show_evolution_(SHOW_EVOLUTION), eval_f_(f_eval),
+	 racing_sample_size_(0), racing_top_quantile_(0.25), racing_confidence_(2.0),
+	 use_surrogate_(false), surrogate_exploration_fraction_(0.1), steady_state_(false),
+	 pipelined_(false), pipeline_ready_fraction_(0.5)
 	  {}
 
 
@@ -35,6 +38,11 @@ Parameters :: Parameters(const int N_EVALS,
 int Parameters :: get_num_evaluations() const {
 	return num_evaluations_;
 }
+
+void Parameters :: set_num_evaluations(const int num_evaluations) {
+	num_evaluations_ = num_evaluations;
+}
+
 double Parameters :: get_pg_crossover_probability() const {
 	return gp_crossover_probability_;
 }
@@ -78,4 +86,57 @@ aux::eval_function_t Parameters :: get_error_function(const unsigned i) const {
 	return eval_error_functions_[i];
 }
 
+void Parameters :: set_racing(const unsigned sample_size, const double top_quantile,
+										const double confidence) {
+	racing_sample_size_ = sample_size;
+	racing_top_quantile_ = top_quantile;
+	racing_confidence_ = confidence;
+}
+
+unsigned Parameters :: get_racing_sample_size() const {
+	return racing_sample_size_;
+}
+
+double Parameters :: get_racing_top_quantile() const {
+	return racing_top_quantile_;
+}
+
+double Parameters :: get_racing_confidence() const {
+	return racing_confidence_;
+}
+
+void Parameters :: set_surrogate(const bool use_surrogate, const double exploration_fraction) {
+	use_surrogate_ = use_surrogate;
+	surrogate_exploration_fraction_ = exploration_fraction;
+}
+
+bool Parameters :: get_use_surrogate() const {
+	return use_surrogate_;
+}
+
+double Parameters :: get_surrogate_exploration_fraction() const {
+	return surrogate_exploration_fraction_;
+}
+
+void Parameters :: set_steady_state(const bool steady_state) {
+	steady_state_ = steady_state;
+}
+
+bool Parameters :: get_steady_state() const {
+	return steady_state_;
+}
+
+void Parameters :: set_pipelined(const bool pipelined, const double ready_fraction) {
+	pipelined_ = pipelined;
+	pipeline_ready_fraction_ = ready_fraction;
+}
+
+bool Parameters :: get_pipelined() const {
+	return pipelined_;
+}
+
+double Parameters :: get_pipeline_ready_fraction() const {
+	return pipeline_ready_fraction_;
+}
+
 }
@@ -0,0 +1,121 @@
+#include "expressions_algs/Racing_evaluator.hpp"
+
+namespace expressions_algs {
+
+Racing_evaluator :: Racing_evaluator(const unsigned sample_size, const double top_quantile,
+												 const double confidence, const unsigned num_batches)
+	:sample_size_(sample_size), top_quantile_(top_quantile), confidence_(confidence),
+	 num_batches_(num_batches)
+	 {}
+
+
+void Racing_evaluator :: prepare(const Dataset & data,
+											const std::vector<double> & labels) {
+
+	sample_data_.clear();
+	sample_labels_.clear();
+
+	// si la muestra no es mucho menor que los datos no merece la pena competir
+	if ( sample_size_ < 2 * num_batches_ || 2 * sample_size_ > data.get_num_rows() ) {
+		return ;
+	}
+
+	// ordenamos los indices de los datos por su etiqueta
+	std::vector<unsigned> orden (data.get_num_rows());
+
+	for ( unsigned i = 0; i < orden.size(); i++) {
+		orden[i] = i;
+	}
+
+	std::sort(orden.begin(), orden.end(), [&labels](const unsigned a, const unsigned b) {
+		return labels[a] < labels[b];
+	});
+
+	sample_data_.resize(sample_size_);
+	sample_labels_.resize(sample_size_);
+
+	// cada estrato tiene el mismo numero de datos, escogemos uno aleatorio de cada uno
+	for ( unsigned i = 0; i < sample_size_; i++) {
+		const unsigned inicio = (static_cast<unsigned long>(i) * data.get_num_rows()) / sample_size_;
+		const unsigned fin = (static_cast<unsigned long>(i + 1) * data.get_num_rows()) / sample_size_;
+
+		const unsigned escogido = orden[Random::get_int(inicio, fin)];
+
+		sample_data_[i] = data.get_row_values(escogido);
+		sample_labels_[i] = labels[escogido];
+	}
+
+}
+
+bool Racing_evaluator :: is_active() const {
+	return !sample_data_.empty();
+}
+
+bool Racing_evaluator :: same_configuration(const unsigned sample_size, const double top_quantile,
+														  const double confidence) const {
+	return sample_size_ == sample_size && aux::compare_floats(top_quantile_, top_quantile) &&
+			 aux::compare_floats(confidence_, confidence);
+}
+
+
+std::pair<double, double> Racing_evaluator :: estimate(const Expression & exp,
+																		 aux::eval_function_t f_evaluacion) const {
+
+	std::vector<double> predicciones (sample_data_.size());
+
+	for ( unsigned i = 0; i < sample_data_.size(); i++) {
+		predicciones[i] = exp.evaluate_data(sample_data_[i]);
+	}
+
+	const double estimacion = f_evaluacion(predicciones, sample_labels_);
+
+	// cada lote coge un dato de cada num_batches_, al estar ordenada la muestra tambien esta estratificado
+	std::vector<double> errores_lotes (num_batches_);
+	std::vector<double> predicciones_lote;
+	std::vector<double> etiquetas_lote;
+
+	for ( unsigned lote = 0; lote < num_batches_; lote++) {
+		predicciones_lote.clear();
+		etiquetas_lote.clear();
+
+		for ( unsigned i = lote; i < sample_data_.size(); i += num_batches_) {
+			predicciones_lote.push_back(predicciones[i]);
+			etiquetas_lote.push_back(sample_labels_[i]);
+		}
+
+		errores_lotes[lote] = f_evaluacion(predicciones_lote, etiquetas_lote);
+	}
+
+	double media = 0.0;
+
+	for ( unsigned lote = 0; lote < num_batches_; lote++) {
+		media += errores_lotes[lote];
+	}
+
+	media /= num_batches_;
+
+	double varianza = 0.0;
+
+	for ( unsigned lote = 0; lote < num_batches_; lote++) {
+		varianza += (errores_lotes[lote] - media) * (errores_lotes[lote] - media);
+	}
+
+	varianza /= (num_batches_ - 1);
+
+	// error estandar de la media de los lotes
+	const double error_estandar = std::sqrt(varianza / num_batches_);
+
+	return std::make_pair(estimacion, error_estandar);
+
+}
+
+double Racing_evaluator :: threshold(const std::vector<double> & fitness) const {
+	return aux::quantile(fitness, top_quantile_);
+}
+
+bool Racing_evaluator :: promote(const std::pair<double, double> & estimacion, const double umbral) const {
+	// el intervalo de confianza de la estimacion alcanza el cuantil superior
+	return estimacion.first - confidence_ * estimacion.second <= umbral;
+}
+
+} // namespace expressions_algs
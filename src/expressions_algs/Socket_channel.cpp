@@ -0,0 +1,348 @@
+#include "expressions_algs/Socket_channel.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace expressions_algs {
+
+namespace {
+
+/**
+  * @brief Cabecera de un mensaje
+  */
+
+struct Cabecera {
+	std::uint32_t tipo;
+	std::uint32_t reservado;
+	std::uint64_t longitud;
+};
+
+const std::string PREFIJO_UNIX = "unix:";
+const std::string PREFIJO_TCP = "tcp:";
+
+// separa "tcp:<host>:<puerto>" en el host y el puerto, el host puede tener ':' si es IPv6
+bool separar_tcp(const std::string & direccion, std::string & host, std::string & puerto) {
+	const std::string resto = direccion.substr(PREFIJO_TCP.size());
+	const std::size_t separador = resto.rfind(':');
+
+	if ( separador == std::string::npos || separador + 1 == resto.size() ) {
+		return false;
+	}
+
+	host = resto.substr(0, separador);
+	puerto = resto.substr(separador + 1);
+
+	return true;
+}
+
+// direccion de un socket unix, false si la ruta no cabe
+bool direccion_unix(const std::string & direccion, sockaddr_un & resultado) {
+	const std::string ruta = direccion.substr(PREFIJO_UNIX.size());
+
+	std::memset(&resultado, 0, sizeof(resultado));
+	resultado.sun_family = AF_UNIX;
+
+	if ( ruta.empty() || ruta.size() >= sizeof(resultado.sun_path) ) {
+		return false;
+	}
+
+	std::memcpy(resultado.sun_path, ruta.c_str(), ruta.size());
+
+	return true;
+}
+
+// resuelve un host y un puerto tcp, nullptr si no se puede
+addrinfo * resolver_tcp(const std::string & direccion, const bool pasivo) {
+	std::string host, puerto;
+	addrinfo * resultado = nullptr;
+
+	if ( separar_tcp(direccion, host, puerto) ) {
+		addrinfo pistas;
+		std::memset(&pistas, 0, sizeof(pistas));
+		pistas.ai_family = AF_UNSPEC;
+		pistas.ai_socktype = SOCK_STREAM;
+		pistas.ai_flags = pasivo ? AI_PASSIVE : 0;
+
+		if ( getaddrinfo(host.empty() ? nullptr : host.c_str(), puerto.c_str(), &pistas, &resultado) != 0 ) {
+			resultado = nullptr;
+		}
+	}
+
+	return resultado;
+}
+
+// los mensajes son pequeños y se esperan respuestas, no se agrupan escrituras
+void sin_retardo(const int descriptor) {
+	const int activo = 1;
+	setsockopt(descriptor, IPPROTO_TCP, TCP_NODELAY, &activo, sizeof(activo));
+}
+
+} // namespace
+
+
+Socket_channel :: Socket_channel()
+	:descriptor_(-1), listening_(false)
+{
+}
+
+Socket_channel :: Socket_channel(const int descriptor, const std::string & address)
+	:descriptor_(descriptor), address_(address), listening_(false)
+{
+}
+
+Socket_channel :: Socket_channel(Socket_channel && otro) noexcept
+	:descriptor_(otro.descriptor_), address_(std::move(otro.address_)), listening_(otro.listening_)
+{
+	otro.descriptor_ = -1;
+	otro.listening_ = false;
+}
+
+Socket_channel & Socket_channel :: operator= (Socket_channel && otro) noexcept {
+	if ( this != &otro ) {
+		close();
+
+		descriptor_ = otro.descriptor_;
+		address_ = std::move(otro.address_);
+		listening_ = otro.listening_;
+
+		otro.descriptor_ = -1;
+		otro.listening_ = false;
+	}
+
+	return *this;
+}
+
+Socket_channel :: ~Socket_channel() {
+	close();
+}
+
+bool Socket_channel :: listen(const std::string & address, const int backlog) {
+	close();
+
+	if ( address.compare(0, PREFIJO_UNIX.size(), PREFIJO_UNIX) == 0 ) {
+		sockaddr_un direccion;
+
+		if ( direccion_unix(address, direccion) ) {
+			descriptor_ = socket(AF_UNIX, SOCK_STREAM, 0);
+
+			// un fichero de una ejecucion anterior impediria el bind
+			unlink(direccion.sun_path);
+
+			if ( descriptor_ >= 0 && bind(descriptor_, reinterpret_cast<sockaddr *>(&direccion), sizeof(direccion)) == 0 &&
+				  ::listen(descriptor_, backlog) == 0 ) {
+				address_ = address;
+				listening_ = true;
+			}
+		}
+	} else if ( address.compare(0, PREFIJO_TCP.size(), PREFIJO_TCP) == 0 ) {
+		addrinfo * direcciones = resolver_tcp(address, true);
+
+		for ( addrinfo * d = direcciones; d != nullptr && !listening_; d = d->ai_next) {
+			descriptor_ = socket(d->ai_family, d->ai_socktype, d->ai_protocol);
+
+			if ( descriptor_ >= 0 ) {
+				const int activo = 1;
+				setsockopt(descriptor_, SOL_SOCKET, SO_REUSEADDR, &activo, sizeof(activo));
+
+				if ( bind(descriptor_, d->ai_addr, d->ai_addrlen) == 0 && ::listen(descriptor_, backlog) == 0 ) {
+					listening_ = true;
+				} else {
+					::close(descriptor_);
+					descriptor_ = -1;
+				}
+			}
+		}
+
+		if ( direcciones != nullptr ) {
+			freeaddrinfo(direcciones);
+		}
+
+		// con el puerto 0 el nucleo elige uno, la direccion guardada lleva el real
+		if ( listening_ ) {
+			sockaddr_storage local;
+			socklen_t longitud = sizeof(local);
+			std::string host, puerto;
+			separar_tcp(address, host, puerto);
+
+			if ( getsockname(descriptor_, reinterpret_cast<sockaddr *>(&local), &longitud) == 0 ) {
+				const unsigned numero = local.ss_family == AF_INET6 ?
+												ntohs(reinterpret_cast<sockaddr_in6 *>(&local)->sin6_port) :
+												ntohs(reinterpret_cast<sockaddr_in *>(&local)->sin_port);
+				puerto = std::to_string(numero);
+			}
+
+			address_ = PREFIJO_TCP + host + ":" + puerto;
+		}
+	}
+
+	if ( !listening_ ) {
+		close();
+	}
+
+	return listening_;
+}
+
+Socket_channel Socket_channel :: accept() {
+	int conexion = -1;
+
+	do {
+		conexion = ::accept(descriptor_, nullptr, nullptr);
+	} while ( conexion < 0 && errno == EINTR );
+
+	if ( conexion >= 0 && address_.compare(0, PREFIJO_TCP.size(), PREFIJO_TCP) == 0 ) {
+		sin_retardo(conexion);
+	}
+
+	return conexion >= 0 ? Socket_channel(conexion, address_) : Socket_channel();
+}
+
+bool Socket_channel :: connect(const std::string & address, const unsigned attempts, const unsigned wait_ms) {
+	close();
+
+	const bool es_unix = address.compare(0, PREFIJO_UNIX.size(), PREFIJO_UNIX) == 0;
+	const bool es_tcp = address.compare(0, PREFIJO_TCP.size(), PREFIJO_TCP) == 0;
+
+	// el proceso que escucha puede no haber arrancado todavia
+	for ( unsigned intento = 0; intento < attempts && descriptor_ < 0 && ( es_unix || es_tcp ); intento++) {
+		if ( intento > 0 ) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(wait_ms));
+		}
+
+		if ( es_unix ) {
+			sockaddr_un direccion;
+
+			if ( !direccion_unix(address, direccion) ) {
+				break;
+			}
+
+			descriptor_ = socket(AF_UNIX, SOCK_STREAM, 0);
+
+			if ( descriptor_ >= 0 &&
+				  ::connect(descriptor_, reinterpret_cast<sockaddr *>(&direccion), sizeof(direccion)) != 0 ) {
+				::close(descriptor_);
+				descriptor_ = -1;
+			}
+		} else {
+			addrinfo * direcciones = resolver_tcp(address, false);
+
+			for ( addrinfo * d = direcciones; d != nullptr && descriptor_ < 0; d = d->ai_next) {
+				descriptor_ = socket(d->ai_family, d->ai_socktype, d->ai_protocol);
+
+				if ( descriptor_ >= 0 && ::connect(descriptor_, d->ai_addr, d->ai_addrlen) != 0 ) {
+					::close(descriptor_);
+					descriptor_ = -1;
+				}
+			}
+
+			if ( direcciones != nullptr ) {
+				freeaddrinfo(direcciones);
+			}
+
+			if ( descriptor_ >= 0 ) {
+				sin_retardo(descriptor_);
+			}
+		}
+	}
+
+	if ( descriptor_ >= 0 ) {
+		address_ = address;
+	}
+
+	return descriptor_ >= 0;
+}
+
+bool Socket_channel :: write_all(const char * datos, std::size_t tam) {
+	while ( tam > 0 ) {
+		// sin SIGPIPE si el otro extremo ya cerro, el error se devuelve
+		const ssize_t escritos = ::send(descriptor_, datos, tam, MSG_NOSIGNAL);
+
+		if ( escritos < 0 && errno == EINTR ) {
+			continue;
+		}
+
+		if ( escritos <= 0 ) {
+			return false;
+		}
+
+		datos += escritos;
+		tam -= escritos;
+	}
+
+	return true;
+}
+
+bool Socket_channel :: read_all(char * datos, std::size_t tam) {
+	while ( tam > 0 ) {
+		const ssize_t leidos = ::recv(descriptor_, datos, tam, 0);
+
+		if ( leidos < 0 && errno == EINTR ) {
+			continue;
+		}
+
+		if ( leidos <= 0 ) {
+			return false;
+		}
+
+		datos += leidos;
+		tam -= leidos;
+	}
+
+	return true;
+}
+
+bool Socket_channel :: send(const std::uint32_t type, const std::string & payload) {
+	const Cabecera cabecera = {type, 0, payload.size()};
+
+	return descriptor_ >= 0 && !listening_ && payload.size() <= MAX_PAYLOAD &&
+			 write_all(reinterpret_cast<const char *>(&cabecera), sizeof(cabecera)) &&
+			 write_all(payload.data(), payload.size());
+}
+
+bool Socket_channel :: receive(std::uint32_t & type, std::string & payload) {
+	Cabecera cabecera;
+
+	bool correcto = descriptor_ >= 0 && !listening_ &&
+						 read_all(reinterpret_cast<char *>(&cabecera), sizeof(cabecera)) &&
+						 cabecera.longitud <= MAX_PAYLOAD;
+
+	if ( correcto ) {
+		payload.resize(cabecera.longitud);
+		correcto = read_all(&payload[0], payload.size());
+		type = cabecera.tipo;
+	}
+
+	return correcto;
+}
+
+bool Socket_channel :: is_open() const {
+	return descriptor_ >= 0;
+}
+
+const std::string & Socket_channel :: get_address() const {
+	return address_;
+}
+
+void Socket_channel :: close() {
+	if ( descriptor_ >= 0 ) {
+		::close(descriptor_);
+
+		// el fichero del socket unix solo lo borra quien escucha en el
+		if ( listening_ && address_.compare(0, PREFIJO_UNIX.size(), PREFIJO_UNIX) == 0 ) {
+			unlink(address_.substr(PREFIJO_UNIX.size()).c_str());
+		}
+	}
+
+	descriptor_ = -1;
+	listening_ = false;
+}
+
+} // namespace expressions_algs
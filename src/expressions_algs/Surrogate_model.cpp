@@ -0,0 +1,237 @@
+#include "expressions_algs/Surrogate_model.hpp"
+
+namespace expressions_algs {
+
+Surrogate_model :: Surrogate_model(const double confidence, const unsigned warmup)
+	:residual_variance_(0.0), confidence_(confidence), warmup_(warmup), num_trained_(0),
+	 num_checked_(0), num_confirmed_(0), num_skipped_(0)
+{
+	weights_.fill(0.0);
+
+	// la matriz de correlacion inversa comienza como una identidad escalada
+	for ( unsigned i = 0; i < NUM_FEATURES; i++) {
+		covariance_[i].fill(0.0);
+		covariance_[i][i] = 1000.0;
+	}
+}
+
+
+void Surrogate_model :: prepare(const Dataset & data,
+										  const std::vector<double> & labels) {
+
+	(*this) = Surrogate_model(confidence_, warmup_);
+
+	const unsigned num_filas = std::min(static_cast<unsigned>(data.get_num_rows()), NUM_PROBE_ROWS);
+
+	probe_data_.resize(num_filas);
+	probe_labels_.resize(num_filas);
+
+	// filas fijas repartidas uniformemente por los datos
+	for ( unsigned i = 0; i < num_filas; i++) {
+		const unsigned fila = (static_cast<unsigned long>(i) * data.get_num_rows()) / num_filas;
+
+		probe_data_[i] = data.get_row_values(fila);
+		probe_labels_[i] = labels[fila];
+	}
+
+}
+
+bool Surrogate_model :: is_prepared() const {
+	return !probe_data_.empty();
+}
+
+
+double Surrogate_model :: scale(const double value) {
+	double resultado = 50.0;
+
+	if ( std::isfinite(value) ) {
+		resultado = std::copysign(std::log1p(std::abs(value)), value);
+	} else if ( value < 0.0 ) {
+		resultado = -50.0;
+	}
+
+	return resultado;
+}
+
+double Surrogate_model :: unscale(const double value) {
+	return std::copysign(std::expm1(std::abs(value)), value);
+}
+
+
+Surrogate_model::Features Surrogate_model :: features(const Expression & exp,
+																		aux::eval_function_t f_evaluacion) const {
+	Features resultado;
+
+	std::vector<double> salidas (probe_data_.size());
+
+	// hash FNV-1a de las salidas redondeadas en las filas de prueba
+	std::uint64_t hash = 14695981039346656037ULL;
+
+	for ( unsigned i = 0; i < probe_data_.size(); i++) {
+		salidas[i] = exp.evaluate_data(probe_data_[i]);
+
+		const std::int64_t redondeado = std::isfinite(salidas[i]) ?
+												  static_cast<std::int64_t>(std::llround(salidas[i] * 1e6)) :
+												  std::numeric_limits<std::int64_t>::max();
+
+		hash ^= static_cast<std::uint64_t>(redondeado);
+		hash *= 1099511628211ULL;
+	}
+
+	const std::pair<double, double> padres = exp.get_parents_fitness();
+
+	resultado.values[0] = 1.0;
+	resultado.values[1] = scale(exp.get_tree_length());
+	resultado.values[2] = scale(exp.compute_depth());
+	resultado.values[3] = scale(std::min(padres.first, padres.second));
+	resultado.values[4] = scale(std::max(padres.first, padres.second));
+	resultado.values[5] = scale(f_evaluacion(salidas, probe_labels_));
+
+	resultado.phenotype = hash;
+
+	return resultado;
+}
+
+
+double Surrogate_model :: predict_scaled(const Features & features) const {
+	double resultado = 0.0;
+
+	auto fenotipo = phenotypes_.find(features.phenotype);
+
+	if ( fenotipo != phenotypes_.end() ) {
+		// ya hemos visto una expresion con las mismas salidas
+		resultado = scale(fenotipo->second);
+	} else {
+		for ( unsigned i = 0; i < NUM_FEATURES; i++) {
+			resultado += weights_[i] * features.values[i];
+		}
+	}
+
+	return resultado;
+}
+
+double Surrogate_model :: predict(const Features & features) const {
+	return unscale(predict_scaled(features));
+}
+
+
+bool Surrogate_model :: clearly_worse(const Features & features, const double threshold) const {
+
+	bool resultado = false;
+
+	if ( num_trained_ >= warmup_ && !std::isnan(threshold) ) {
+		const double margen = confidence_ * std::sqrt(residual_variance_);
+
+		resultado = predict_scaled(features) - margen > scale(threshold);
+	}
+
+	return resultado;
+}
+
+
+void Surrogate_model :: train(const Features & features, const double fitness) {
+
+	if ( std::isfinite(fitness) ) {
+		const double objetivo = scale(fitness);
+
+		// actualizamos la varianza de los residuos antes de aprender el dato
+		double prediccion = 0.0;
+
+		for ( unsigned i = 0; i < NUM_FEATURES; i++) {
+			prediccion += weights_[i] * features.values[i];
+		}
+
+		const double residuo = objetivo - prediccion;
+
+		num_trained_++;
+
+		const double tasa = std::max(1.0 / num_trained_, 0.02);
+		residual_variance_ = (1.0 - tasa) * residual_variance_ + tasa * residuo * residuo;
+
+		// minimos cuadrados recursivos con factor de olvido, la poblacion cambia con las generaciones
+		const double OLVIDO = 0.995;
+
+		std::array<double, NUM_FEATURES> px;
+		double denominador = OLVIDO;
+
+		for ( unsigned i = 0; i < NUM_FEATURES; i++) {
+			px[i] = 0.0;
+
+			for ( unsigned j = 0; j < NUM_FEATURES; j++) {
+				px[i] += covariance_[i][j] * features.values[j];
+			}
+
+			denominador += features.values[i] * px[i];
+		}
+
+		double traza = 0.0;
+
+		for ( unsigned i = 0; i < NUM_FEATURES; i++) {
+			weights_[i] += (px[i] / denominador) * residuo;
+
+			for ( unsigned j = 0; j < NUM_FEATURES; j++) {
+				covariance_[i][j] = (covariance_[i][j] - px[i] * px[j] / denominador) / OLVIDO;
+			}
+
+			traza += covariance_[i][i];
+		}
+
+		// si las caracteristicas no varian la matriz crece sin limite, la reiniciamos
+		if ( !std::isfinite(traza) || traza > 1e6 ) {
+			for ( unsigned i = 0; i < NUM_FEATURES; i++) {
+				covariance_[i].fill(0.0);
+				covariance_[i][i] = 1000.0;
+			}
+		}
+
+		// acotamos la memoria de fenotipos
+		if ( phenotypes_.size() > 100000 ) {
+			phenotypes_.clear();
+		}
+
+		phenotypes_[features.phenotype] = fitness;
+	}
+
+}
+
+
+void Surrogate_model :: record_check(const bool really_worse) {
+	num_checked_++;
+
+	if ( really_worse ) {
+		num_confirmed_++;
+	}
+}
+
+void Surrogate_model :: record_skip() {
+	num_skipped_++;
+}
+
+double Surrogate_model :: precision() const {
+	double resultado = std::numeric_limits<double>::quiet_NaN();
+
+	if ( num_checked_ > 0 ) {
+		resultado = static_cast<double>(num_confirmed_) / num_checked_;
+	}
+
+	return resultado;
+}
+
+unsigned long Surrogate_model :: get_num_skipped() const {
+	return num_skipped_;
+}
+
+
+double Surrogate_model :: tournament_threshold(const std::vector<double> & fitness,
+															  const unsigned tournament_size) {
+	double cuantil = 1.0;
+
+	// con torneos de tamaño k, un individuo en el cuantil q gana de media k * (1 - q)^(k - 1) torneos
+	if ( tournament_size > 1 ) {
+		cuantil = 1.0 - std::pow(1.0 / tournament_size, 1.0 / (tournament_size - 1.0));
+	}
+
+	return aux::quantile(fitness, cuantil);
+}
+
+} // namespace expressions_algs
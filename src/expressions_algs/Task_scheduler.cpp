@@ -0,0 +1,336 @@
+#include "expressions_algs/Task_scheduler.hpp"
+
+#ifdef __linux__
+	#include <pthread.h>
+	#include <sched.h>
+#endif
+
+namespace expressions_algs {
+
+namespace {
+
+	// planificador y deque de la hebra actual, si pertenece a un pool
+	thread_local Task_scheduler * planificador_actual = nullptr;
+	thread_local unsigned cola_actual = 0;
+
+	// grupo de la tarea que ejecuta la hebra actual, padre de los grupos que abre
+	thread_local const Task_group * grupo_actual = nullptr;
+
+	// planificador global de la biblioteca
+	std::mutex cerrojo_global;
+	std::unique_ptr<Task_scheduler> planificador_global;
+
+	// siguiente nucleo que se reserva para un pool dedicado
+	std::atomic<unsigned> siguiente_nucleo (0);
+
+}
+
+Task_scheduler :: Task_scheduler(const unsigned num_threads)
+	:num_threads_(std::max(num_threads, 1u)), dedicated_(false), num_queued_(0), num_sleeping_(0), stop_(false)
+{
+
+	for ( unsigned i = 0; i < num_threads_; i++) {
+		queues_.push_back(std::make_unique<Task_queue>());
+	}
+
+	// la hebra que espera a las tareas es una mas del pool
+	for ( unsigned i = 1; i < num_threads_; i++) {
+		threads_.emplace_back(&Task_scheduler::worker_loop, this, i);
+	}
+
+}
+
+Task_scheduler :: Task_scheduler(const unsigned num_threads, const std::vector<unsigned> & cores)
+	:num_threads_(std::max(num_threads, 1u)), dedicated_(true), num_queued_(0), num_sleeping_(0), stop_(false)
+{
+
+	// la deque 0 es la de las hebras de fuera, que solo esperan
+	for ( unsigned i = 0; i <= num_threads_; i++) {
+		queues_.push_back(std::make_unique<Task_queue>());
+	}
+
+	for ( unsigned i = 1; i <= num_threads_; i++) {
+		threads_.emplace_back(&Task_scheduler::worker_loop, this, i);
+
+		#ifdef __linux__
+			if ( !cores.empty() ) {
+				cpu_set_t nucleos;
+				CPU_ZERO(&nucleos);
+
+				for ( const unsigned nucleo : cores ) {
+					CPU_SET(nucleo, &nucleos);
+				}
+
+				// si el sistema no lo permite la hebra sigue sin fijar, con el mismo resultado
+				pthread_setaffinity_np(threads_.back().native_handle(), sizeof(nucleos), &nucleos);
+			}
+		#endif
+	}
+
+}
+
+Task_scheduler :: ~Task_scheduler() {
+
+	{
+		std::lock_guard<std::mutex> cerrojo (sleep_lock_);
+		stop_ = true;
+	}
+
+	wake_up_.notify_all();
+
+	for ( std::thread & hebra : threads_ ) {
+		hebra.join();
+	}
+
+	// sin hebras en el pool las tareas que quedan las ejecuta el destructor
+	while ( run_one(0) ) {
+	}
+
+}
+
+unsigned Task_scheduler :: current_queue() const {
+	return planificador_actual == this ? cola_actual : 0;
+}
+
+void Task_scheduler :: push(Task && task) {
+	Task_queue & cola = *queues_[current_queue()];
+
+	{
+		std::lock_guard<std::mutex> cerrojo (cola.lock);
+		cola.tasks.push_back(std::move(task));
+		num_queued_++;
+	}
+
+	// una hebra que se va a dormir vuelve a mirar las tareas con el cerrojo cogido
+	if ( num_sleeping_ > 0 ) {
+		{
+			std::lock_guard<std::mutex> cerrojo (sleep_lock_);
+		}
+
+		wake_up_.notify_one();
+	}
+
+}
+
+bool Task_scheduler :: run_one(const unsigned queue, const Task_group * group) {
+	Task tarea;
+	bool encontrada = false;
+
+	// sin grupo vale cualquier tarea, con grupo solo las suyas o las de sus descendientes
+	const auto valida = [group](const Task & candidata) {
+		return group == nullptr || candidata.group->descends_from(*group);
+	};
+
+	// primero la tarea mas reciente de la propia deque, que comparte datos en cache
+	{
+		Task_queue & propia = *queues_[queue];
+		std::lock_guard<std::mutex> cerrojo (propia.lock);
+
+		for ( auto it = propia.tasks.rbegin(); it != propia.tasks.rend() && !encontrada; ++it) {
+			if ( valida(*it) ) {
+				tarea = std::move(*it);
+				propia.tasks.erase(std::next(it).base());
+				encontrada = true;
+			}
+		}
+	}
+
+	// despues se roba la tarea mas antigua de otra deque, que suele ser la mas grande
+	for ( unsigned i = 1; i < queues_.size() && !encontrada; i++) {
+		Task_queue & victima = *queues_[(queue + i) % queues_.size()];
+		std::lock_guard<std::mutex> cerrojo (victima.lock);
+
+		for ( auto it = victima.tasks.begin(); it != victima.tasks.end() && !encontrada; ++it) {
+			if ( valida(*it) ) {
+				tarea = std::move(*it);
+				victima.tasks.erase(it);
+				encontrada = true;
+			}
+		}
+	}
+
+	if ( encontrada ) {
+		num_queued_--;
+
+		const Task_group * anterior = grupo_actual;
+		grupo_actual = tarea.group;
+		tarea.function();
+		grupo_actual = anterior;
+
+		// despues de avisar al grupo ya no se puede usar, quien espera puede destruirlo
+		tarea.group->pending_.fetch_sub(1, std::memory_order_release);
+
+		// quien espera desde fuera de un pool dedicado vuelve a mirar su grupo con el cerrojo cogido
+		if ( dedicated_ ) {
+			{
+				std::lock_guard<std::mutex> cerrojo (sleep_lock_);
+			}
+
+			task_finished_.notify_all();
+		}
+	}
+
+	return encontrada;
+}
+
+void Task_scheduler :: worker_loop(const unsigned queue) {
+	planificador_actual = this;
+	cola_actual = queue;
+
+	while ( true ) {
+		if ( !run_one(queue) ) {
+			num_sleeping_++;
+
+			{
+				std::unique_lock<std::mutex> cerrojo (sleep_lock_);
+				wake_up_.wait(cerrojo, [this]() { return stop_ || num_queued_ > 0; });
+			}
+
+			num_sleeping_--;
+
+			if ( stop_ && num_queued_ == 0 ) {
+				break;
+			}
+		}
+	}
+
+}
+
+unsigned Task_scheduler :: num_chunks(const unsigned size, const unsigned grain) const {
+	const unsigned long por_grano = (static_cast<unsigned long>(size) + std::max(grain, 1u) - 1) / std::max(grain, 1u);
+	const unsigned long maximo = static_cast<unsigned long>(TASKS_PER_THREAD) * num_threads_;
+
+	return num_threads_ == 1 ? 1 : std::max(std::min(por_grano, maximo), 1UL);
+}
+
+unsigned Task_scheduler :: get_num_threads() const {
+	return num_threads_;
+}
+
+bool Task_scheduler :: is_dedicated() const {
+	return dedicated_;
+}
+
+Task_scheduler & Task_scheduler :: global() {
+	// las tareas de un pool dedicado abren sus bucles paralelos en el mismo pool
+	if ( planificador_actual != nullptr && planificador_actual->dedicated_ ) {
+		return *planificador_actual;
+	}
+
+	std::lock_guard<std::mutex> cerrojo (cerrojo_global);
+
+	if ( !planificador_global ) {
+		planificador_global = std::make_unique<Task_scheduler>(default_threads());
+	}
+
+	return *planificador_global;
+}
+
+void Task_scheduler :: set_global_threads(const unsigned num_threads) {
+	std::lock_guard<std::mutex> cerrojo (cerrojo_global);
+
+	if ( !planificador_global || planificador_global->get_num_threads() != std::max(num_threads, 1u) ) {
+		// primero se paran las hebras del pool anterior
+		planificador_global.reset();
+		planificador_global = std::make_unique<Task_scheduler>(num_threads);
+	}
+
+}
+
+unsigned Task_scheduler :: default_threads() {
+	unsigned hebras = 1;
+
+	#ifdef _OPENMP
+		hebras = omp_get_max_threads();
+	#endif
+
+	return std::max(hebras, 1u);
+}
+
+std::vector<unsigned> Task_scheduler :: reserve_cores(const unsigned num_cores) {
+	std::vector<unsigned> reservados;
+
+	#ifdef __linux__
+		cpu_set_t permitidos;
+		std::vector<unsigned> nucleos;
+
+		// solo los nucleos en los que puede ejecutarse el proceso
+		if ( sched_getaffinity(0, sizeof(permitidos), &permitidos) == 0 ) {
+			for ( unsigned nucleo = 0; nucleo < CPU_SETSIZE; nucleo++) {
+				if ( CPU_ISSET(nucleo, &permitidos) ) {
+					nucleos.push_back(nucleo);
+				}
+			}
+		}
+
+		if ( !nucleos.empty() ) {
+			const unsigned primero = siguiente_nucleo.fetch_add(num_cores);
+
+			// con mas hebras que nucleos se vuelve a empezar por el primero
+			for ( unsigned i = 0; i < num_cores; i++) {
+				reservados.push_back(nucleos[(primero + i) % nucleos.size()]);
+			}
+		}
+	#endif
+
+	return reservados;
+}
+
+Task_group :: Task_group(Task_scheduler & scheduler)
+	:scheduler_(scheduler), parent_(grupo_actual), pending_(0)
+{
+}
+
+Task_group :: ~Task_group() {
+	wait();
+}
+
+bool Task_group :: descends_from(const Task_group & ancestor) const {
+	const Task_group * grupo = this;
+
+	// los antecesores siguen vivos, cada uno espera a la tarea que abrio a su hijo
+	while ( grupo != nullptr && grupo != &ancestor ) {
+		grupo = grupo->parent_;
+	}
+
+	return grupo != nullptr;
+}
+
+void Task_group :: run(std::function<void()> task) {
+	pending_.fetch_add(1, std::memory_order_relaxed);
+	scheduler_.push(Task_scheduler::Task{std::move(task), this});
+}
+
+void Task_group :: wait() {
+
+	// solo se ayuda con tareas del grupo, una tarea ajena alargaria la espera y
+	// ocuparia la hebra que el grupo tiene asignada
+	// las tareas que ejecuta esta hebra mientras espera pueden cambiar su generador
+	const std::mt19937 generador = Random::get_generator();
+	const unsigned cola = scheduler_.current_queue();
+	bool ayudado = false;
+
+	// fuera de un pool dedicado no se ejecutan sus tareas, se duerme hasta que terminan
+	if ( scheduler_.dedicated_ && cola == 0 ) {
+		std::unique_lock<std::mutex> cerrojo (scheduler_.sleep_lock_);
+
+		scheduler_.task_finished_.wait(cerrojo, [this]() {
+			return pending_.load(std::memory_order_acquire) == 0;
+		});
+	}
+
+	while ( pending_.load(std::memory_order_acquire) > 0 ) {
+		if ( scheduler_.run_one(cola, this) ) {
+			ayudado = true;
+		} else {
+			std::this_thread::yield();
+		}
+	}
+
+	if ( ayudado ) {
+		Random::set_generator(generador);
+	}
+
+}
+
+} // namespace expressions_algs
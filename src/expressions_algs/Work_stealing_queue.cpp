@@ -0,0 +1,63 @@
+#include "expressions_algs/Work_stealing_queue.hpp"
+
+namespace expressions_algs {
+
+Work_stealing_queue :: Work_stealing_queue(const std::vector<unsigned> & tasks,
+														 const std::vector<double> & costs,
+														 const unsigned num_workers)
+	:deques_(std::max(num_workers, 1u)), locks_(std::max(num_workers, 1u))
+{
+
+	std::vector<unsigned> orden (tasks.size());
+
+	for ( unsigned i = 0; i < orden.size(); i++) {
+		orden[i] = i;
+	}
+
+	// las tareas mas costosas primero, a igual coste se respeta el orden original
+	std::stable_sort(orden.begin(), orden.end(), [&costs](const unsigned a, const unsigned b) {
+		return costs[a] > costs[b];
+	});
+
+	// repartimos como en una baraja, cada trabajador recibe una mezcla de tareas largas y cortas
+	for ( unsigned i = 0; i < orden.size(); i++) {
+		deques_[i % deques_.size()].push_back(tasks[orden[i]]);
+	}
+
+}
+
+bool Work_stealing_queue :: next(const unsigned worker, unsigned & task) {
+
+	bool encontrada = false;
+
+	{
+		std::lock_guard<std::mutex> cerrojo (locks_[worker]);
+
+		if ( !deques_[worker].empty() ) {
+			task = deques_[worker].front();
+			deques_[worker].pop_front();
+			encontrada = true;
+		}
+	}
+
+	// robamos la tarea mas barata de otro trabajador, para no quitarle la que esta a punto de coger
+	for ( unsigned i = 1; i < deques_.size() && !encontrada; i++) {
+		const unsigned victima = (worker + i) % deques_.size();
+
+		std::lock_guard<std::mutex> cerrojo (locks_[victima]);
+
+		if ( !deques_[victima].empty() ) {
+			task = deques_[victima].back();
+			deques_[victima].pop_back();
+			encontrada = true;
+		}
+	}
+
+	return encontrada;
+}
+
+unsigned Work_stealing_queue :: get_num_workers() const {
+	return deques_.size();
+}
+
+} // namespace expressions_algs
@@ -8,40 +8,91 @@ bool compare_floats(const double a, const double b, const double epsilon) {
 
 double cuadratic_mean_error(const std::vector<double> & predicted_values,
 										const std::vector<double> & real_values) {
+	return reduce_metric(Mean_squared_error(), predicted_values, real_values);
+}
+
+double root_cuadratic_mean_error(const std::vector<double> & predicted_values,
+											  const std::vector<double> & real_values) {
+	return reduce_metric(Root_mean_squared_error(), predicted_values, real_values);
+}
+
+double mean_absolute_error(const std::vector<double> & predicted_values,
+									const std::vector<double> & real_values) {
+	return reduce_metric(Mean_absolute_error(), predicted_values, real_values);
+}
+
+MetricReduction get_metric_reduction(eval_function_t evaluation_f) {
+
+	MetricReduction result = MetricReduction::NONE;
+
+	if ( evaluation_f == cuadratic_mean_error ) {
+		result = MetricReduction::MEAN_SQUARED;
+	} else if ( evaluation_f == root_cuadratic_mean_error ) {
+		result = MetricReduction::ROOT_MEAN_SQUARED;
+	} else if ( evaluation_f == mean_absolute_error ) {
+		result = MetricReduction::MEAN_ABSOLUTE;
+	}
+
+	return result;
+}
+
+Metrics compute_metrics(const std::vector<double> & predicted_values, const std::vector<double> & real_values,
+								const std::vector<eval_function_t> & functions) {
+
+	Metrics result;
 
-	double result = 0.0;
+	Mean_squared_error::state_t suma_cuadrados = Mean_squared_error::init();
+	Mean_absolute_error::state_t suma_absolutos = Mean_absolute_error::init();
 
+	// una sola pasada para todas las metricas que se acumulan fila a fila
 	for ( unsigned i = 0; i < real_values.size(); i++ ) {
-		result += std::pow( predicted_values[i] - real_values[i] , 2.0);
+		suma_cuadrados = Mean_squared_error::accumulate(suma_cuadrados, predicted_values[i], real_values[i]);
+		suma_absolutos = Mean_absolute_error::accumulate(suma_absolutos, predicted_values[i], real_values[i]);
 	}
 
-	result = result / static_cast<double>(real_values.size());
+	result.mse = Mean_squared_error::finalize(suma_cuadrados, real_values.size());
+	result.rmse = Root_mean_squared_error::finalize(suma_cuadrados, real_values.size());
+	result.mae = Mean_absolute_error::finalize(suma_absolutos, real_values.size());
+
+	result.values.resize(functions.size());
+
+	// solo se llama a las funciones que no se pueden sacar de la pasada anterior
+	for ( unsigned i = 0; i < functions.size(); i++ ) {
+		switch ( get_metric_reduction(functions[i]) ) {
+			case MetricReduction::MEAN_SQUARED:
+				result.values[i] = result.mse;
+				break;
+			case MetricReduction::ROOT_MEAN_SQUARED:
+				result.values[i] = result.rmse;
+				break;
+			case MetricReduction::MEAN_ABSOLUTE:
+				result.values[i] = result.mae;
+				break;
+			default:
+				result.values[i] = functions[i](predicted_values, real_values);
+		}
+	}
 
 	return result;
-
 }
 
-double root_cuadratic_mean_error(const std::vector<double> & predicted_values,
-											  const std::vector<double> & real_values) {
+double quantile(std::vector<double> values, const double quantile) {
 
-	double result = cuadratic_mean_error(predicted_values, real_values);
-	// result = RMSE
-	result = std::sqrt(result);
+	double result = std::numeric_limits<double>::infinity();
 
-	return result;
+	// los NaN no se pueden ordenar
+	values.erase(std::remove_if(values.begin(), values.end(), [](const double v) {
+		return std::isnan(v);
+	}), values.end());
 
-}
+	if ( !values.empty() ) {
+		const unsigned position = quantile * (values.size() - 1);
 
-double mean_absolute_error(const std::vector<double> & predicted_values,
-									const std::vector<double> & real_values) {
+		std::nth_element(values.begin(), values.begin() + position, values.end());
 
-	double result = 0.0;
-	for ( unsigned i = 0; i < real_values.size(); i++ ) {
-		result += std::abs(predicted_values[i] - real_values[i]);
+		result = values[position];
 	}
 
-	result = result / static_cast<double>(real_values.size());
-
 	return result;
 }
 
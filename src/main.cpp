@@ -1,14 +1,12 @@
 #include <iostream>
 #include "expressions_algs/GA_P_alg.hpp"
 #include "expressions_algs/GP_alg.hpp"
+#include "expressions_algs/Fold_executor.hpp"
 
 #include <ctime>
 #include "Random.hpp"
 #include <chrono>
 
-#ifdef _OPENMP
-	#include <omp.h>
-#endif
 
 
 int main(int argc, char ** argv){
@@ -50,10 +48,8 @@ int main(int argc, char ** argv){
 	execution_params.add_error_function(expressions_algs::aux::root_cuadratic_mean_error);
 	execution_params.add_error_function(expressions_algs::aux::mean_absolute_error);
 
-	// si utilizamos openMP, establecemos el número de trabajos
-	#ifdef _OPENMP
-		omp_set_num_threads(num_jobs);
-	#endif
+	// establecemos el número de hebras del planificador de tareas
+	expressions_algs::Task_scheduler::set_global_threads(num_jobs);
 
 	int original_seed = seed;
 	Random::set_seed(seed);
@@ -75,9 +71,11 @@ int main(int argc, char ** argv){
  
 
 	// No hacemos 5x2 cv, solo 5-fold cv 
-	for (unsigned i = 0; i < num_it; i++) {
-		auto start_time_it = std::chrono::high_resolution_clock::now();
+	// los folds son independientes y se ejecutan a la vez, cada uno fija su semilla al crear el algoritmo
+	expressions_algs::Fold_executor gap_folds(num_it);
+	std::vector<std::pair<expressions_algs::GA_P_Expression, std::vector<std::vector<double> > > > gap_results(num_it);
 
+	gap_folds.run([&](const unsigned i) {
 		std::string t =std::to_string(i);
 		std::string train_file=std::string(argv[1]);
 		std::string::size_type n = 0;
@@ -89,26 +87,23 @@ int main(int argc, char ** argv){
  		n = test_file.find( s, n );
 		if(n!= std::string::npos)				test_file.replace( n, s.size(), t );
 		
-		auto data = expressions_algs::preprocess::read_data<double>(train_file, '@', ',');
-		auto data_test = expressions_algs::preprocess::read_data<double>(test_file, '@', ',');
+		auto data = expressions_algs::Dataset::load(train_file, '@', ',');
+		auto data_test = expressions_algs::Dataset::load(test_file, '@', ',');
 
-		expressions_algs::GA_P_alg myGAP (data.first, data.second, seed, population_size, max_expression_depth, prob_variable);
+		expressions_algs::GA_P_alg myGAP (data, seed, population_size, max_expression_depth, prob_variable);
 		
-		auto cv_result=myGAP.fit_cv_files(data,data_test,execution_params);
-
-
-
-		auto end_time = std::chrono::high_resolution_clock::now();
-
+		gap_results[i] = myGAP.fit_cv_files(data,data_test,execution_params);
+	});
 
-		std::chrono::duration<double> execution_time = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time_it);
+	for (unsigned i = 0; i < num_it; i++) {
+		const auto & cv_result = gap_results[i];
 
 		std::cout << original_seed << "\t"
 					<< cv_result.second[0][0] << "\t"
 					<< cv_result.second[1][0] << "\t"
 					<< cv_result.second[2][0] << "\t"
 					<< cv_result.first << "\t"
-					<< execution_time.count() << "\t GAP" << "\t" << "cv: " << i << std::endl;
+					<< gap_folds.get_fold_times()[i] << "\t GAP" << "\t" << "cv: " << i << std::endl;
 
 
 		//if ( cv_result.first.get_fitness() < best_gap_expression.get_fitness()) {
@@ -126,6 +121,9 @@ int main(int argc, char ** argv){
 			}
 	}
 
+	std::clog << "# GAP folds: " << gap_folds.get_concurrent_folds() << " concurrent, speedup "
+				 << gap_folds.get_speedup() << std::endl;
+
 	mean_error_ecm_gap /= num_cv * num_it * 1.0;
 	mean_error_recm_gap /= num_cv * num_it * 1.0;
 	mean_error_mae_gap /= num_cv * num_it * 1.0;
@@ -144,26 +142,20 @@ int main(int argc, char ** argv){
 
 
 	std::string fichero_ValidacionFinal=std::string(argv[3]);
-	auto datos_val = expressions_algs::preprocess::read_data<double>(fichero_ValidacionFinal, '@', ',');
+	auto datos_val = expressions_algs::Dataset::load(fichero_ValidacionFinal, '@', ',');
 	
 	start_time = std::chrono::high_resolution_clock::now();
 	// evaluate the best expression over the final validation data
-	best_gap_expression.evaluate_expression(datos_val.first, datos_val.second, expressions_algs::aux::cuadratic_mean_error, true);
-	double error_val_gap_ecm = best_gap_expression.get_fitness();
-
-	best_gap_expression.evaluate_expression(datos_val.first, datos_val.second, expressions_algs::aux::root_cuadratic_mean_error, true);
-	double error_val_gap_recm = best_gap_expression.get_fitness();
-
-	best_gap_expression.evaluate_expression(datos_val.first, datos_val.second, expressions_algs::aux::mean_absolute_error, true);
-	double error_val_gap_mae = best_gap_expression.get_fitness();
+	// una sola prediccion de validacion para las tres metricas
+	const auto metricas_val_gap = best_gap_expression.evaluate_metrics(datos_val, datos_val.get_labels());
 	
 	end_time = std::chrono::high_resolution_clock::now();
 	execution_time = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
 
 	std::cout << original_seed << "\t"
-				 << error_val_gap_ecm << "\t"
-				 << error_val_gap_recm << "\t"
-				 << error_val_gap_mae << "\t"
+				 << metricas_val_gap.mse << "\t"
+				 << metricas_val_gap.rmse << "\t"
+				 << metricas_val_gap.mae << "\t"
 				 << best_gap_expression << "\t"
 				 << execution_time.count() << "\t GAP VAL" << std::endl;
 
@@ -179,9 +171,10 @@ int main(int argc, char ** argv){
 
 	start_time = std::chrono::high_resolution_clock::now();
 	best_error=100000.0;
-	for (unsigned i = 0; i < num_it; i++) {
+	expressions_algs::Fold_executor gp_folds(num_it);
+	std::vector<std::pair<expressions_algs::Expression, std::vector<std::vector<double> > > > gp_results(num_it);
 
-		auto start_time_it = std::chrono::high_resolution_clock::now();
+	gp_folds.run([&](const unsigned i) {
 		std::string t =std::to_string(i);
 		std::string train_file=std::string(argv[1]);
 		std::string::size_type n = 0;
@@ -193,16 +186,18 @@ int main(int argc, char ** argv){
 
 		if(n!= std::string::npos)				test_file.replace( n, s.size(), t );
 		
-		auto data = expressions_algs::preprocess::read_data<double>(train_file, '@', ',');
+		auto data = expressions_algs::Dataset::load(train_file, '@', ',');
 
-		auto data_test = expressions_algs::preprocess::read_data<double>(test_file, '@', ',');
+		auto data_test = expressions_algs::Dataset::load(test_file, '@', ',');
 	
 
-		expressions_algs::GP_alg myPG (data.first, data.second, seed, population_size, max_expression_depth, prob_variable);
+		expressions_algs::GP_alg myPG (data, seed, population_size, max_expression_depth, prob_variable);
 		
-		auto cv_result=myPG.fit_cv_files(data,data_test,execution_params);
-
+		gp_results[i] = myPG.fit_cv_files(data,data_test,execution_params);
+	});
 
+	for (unsigned i = 0; i < num_it; i++) {
+		const auto & cv_result = gp_results[i];
 	
 		if(cv_result.second[0][0] < best_error){
 			best_pg_expression = cv_result.first;
@@ -214,20 +209,17 @@ int main(int argc, char ** argv){
 			mean_error_mae_gp += cv_result.second[2][0];
 		}
 
-		auto end_time = std::chrono::high_resolution_clock::now();
-
-
-		std::chrono::duration<double> execution_time = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time_it);
-
 		std::cout << original_seed << "\t"
 					<< cv_result.second[0][0] << "\t"
 					<< cv_result.second[1][0] << "\t"
 					<< cv_result.second[2][0] << "\t"
 					<< cv_result.first << "\t"
-					<< execution_time.count() << "\t GP" << "\t" << "cv: " << i << std::endl;
+					<< gp_folds.get_fold_times()[i] << "\t GP" << "\t" << "cv: " << i << std::endl;
 
 	}
 
+	std::clog << "# GP folds: " << gp_folds.get_concurrent_folds() << " concurrent, speedup "
+				 << gp_folds.get_speedup() << std::endl;
 
 	mean_error_ecm_gp /= num_cv * num_it * 1.0;
 	mean_error_recm_gp /= num_cv * num_it * 1.0;
@@ -247,22 +239,16 @@ int main(int argc, char ** argv){
 
 	start_time = std::chrono::high_resolution_clock::now();
 	//Y sobre pg
-	best_pg_expression.evaluate_expression(datos_val.first, datos_val.second, expressions_algs::aux::cuadratic_mean_error, true);
-	double error_val_pg_ecm = best_pg_expression.get_fitness();
-
-	best_pg_expression.evaluate_expression(datos_val.first, datos_val.second, expressions_algs::aux::root_cuadratic_mean_error, true);
-	double error_val_pg_recm = best_pg_expression.get_fitness();
-
-	best_pg_expression.evaluate_expression(datos_val.first, datos_val.second, expressions_algs::aux::mean_absolute_error, true);
-	double error_val_pg_mae = best_pg_expression.get_fitness();
+	// una sola prediccion de validacion para las tres metricas
+	const auto metricas_val_pg = best_pg_expression.evaluate_metrics(datos_val, datos_val.get_labels());
 	
 	end_time = std::chrono::high_resolution_clock::now();
 	execution_time = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
 
 	std::cout << original_seed << "\t"
-				 << error_val_pg_ecm << "\t"
-				 << error_val_pg_recm << "\t"
-				 << error_val_pg_mae << "\t"
+				 << metricas_val_pg.mse << "\t"
+				 << metricas_val_pg.rmse << "\t"
+				 << metricas_val_pg.mae << "\t"
 				 << best_pg_expression<< "\t"
 				 << execution_time.count() << "\t GP VAL" << std::endl;
 
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "expressions_algs/GA_P_alg.hpp"
+#include "expressions_algs/GP_alg.hpp"
+
+
+// datos sinteticos fijos, para que dos versiones de la biblioteca se midan con los mismos datos
+expressions_algs::Dataset synthetic_data(const unsigned num_rows, const unsigned num_columns) {
+	std::mt19937 generador (12345);
+	std::uniform_real_distribution<double> valores (-10.0, 10.0);
+
+	std::vector<std::vector<double> > data (num_rows, std::vector<double>(num_columns));
+	std::vector<double> labels (num_rows);
+
+	for ( unsigned i = 0; i < num_rows; i++) {
+		for ( unsigned j = 0; j < num_columns; j++) {
+			data[i][j] = valores(generador);
+		}
+
+		labels[i] = data[i][0] * data[i][1] + std::sin(data[i][2]) - 0.5 * data[i][num_columns - 1];
+	}
+
+	return expressions_algs::Dataset(data, labels);
+}
+
+
+// milisegundos de cada generacion: cada fit con tantas evaluaciones como individuos hace una sola
+template <class Algorithm>
+std::vector<double> time_generations(Algorithm & algorithm, const expressions_algs::Parameters & parameters,
+												 const unsigned num_generations) {
+	std::vector<double> tiempos;
+
+	// la primera generacion tambien evalua la poblacion inicial, no se cuenta
+	algorithm.fit(parameters);
+
+	for ( unsigned g = 0; g < num_generations; g++) {
+		const auto inicio = std::chrono::steady_clock::now();
+
+		algorithm.fit(parameters);
+
+		tiempos.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count());
+	}
+
+	std::sort(tiempos.begin(), tiempos.end());
+
+	return tiempos;
+}
+
+
+int main(int argc, char ** argv) {
+
+	if ( argc > 5 ) {
+		std::cerr << "ERROR: Bad number of arguments." << std::endl;
+		std::cerr << "\t Use: " << argv[0] << " [num_generations] [max_depth] [tournament_size] [data_file]" << std::endl;
+		exit(-1);
+	}
+
+	const std::vector<unsigned> POPULATION_SIZES = {1000, 10000};
+	const unsigned long SEED = 12345;
+
+	const unsigned num_generations = argc >= 2 ? std::max(atoi(argv[1]), 1) : 5;
+	const unsigned max_depth = argc >= 3 ? std::max(atoi(argv[2]), 1) : 50;
+	const int tournament_size = argc >= 4 ? std::max(atoi(argv[3]), 2) : 4;
+
+	const expressions_algs::Dataset data = argc == 5 ? expressions_algs::Dataset::load(argv[4], '@', ',') :
+														  synthetic_data(400, 13);
+
+	if ( data.get_num_rows() == 0 ) {
+		std::cerr << "ERROR: No data could be read from " << argv[4] << std::endl;
+		exit(-1);
+	}
+
+	std::cout << "# " << data.get_num_rows() << " rows, " << data.get_num_columns() << " features, max depth "
+				 << max_depth << ", tournament " << tournament_size << ", " << num_generations << " generations" << std::endl;
+	std::cout << "# algorithm\tpopulation\tbest_ms\tmedian_ms" << std::endl;
+
+	for ( const unsigned population_size : POPULATION_SIZES ) {
+		// cada llamada a fit hace exactamente una generacion
+		const expressions_algs::Parameters parameters (population_size, expressions_algs::aux::cuadratic_mean_error,
+																	  0.75, 0.75, 0.05, 0.05, 0.3, tournament_size, false);
+
+		Random::set_seed(SEED);
+		expressions_algs::GA_P_alg ga_p (data, SEED, population_size, max_depth, 0.3);
+		const std::vector<double> tiempos_gap = time_generations(ga_p, parameters, num_generations);
+
+		std::cout << "GA-P\t" << population_size << "\t" << tiempos_gap.front() << "\t"
+					 << tiempos_gap[tiempos_gap.size() / 2] << std::endl;
+
+		Random::set_seed(SEED);
+		expressions_algs::GP_alg gp (data, SEED, population_size, max_depth, 0.3);
+		const std::vector<double> tiempos_gp = time_generations(gp, parameters, num_generations);
+
+		std::cout << "GP\t" << population_size << "\t" << tiempos_gp.front() << "\t"
+					 << tiempos_gp[tiempos_gp.size() / 2] << std::endl;
+	}
+
+}
@@ -0,0 +1,54 @@
+#include <iostream>
+
+#include "expressions_algs/Dataset.hpp"
+
+
+int main(int argc, char ** argv) {
+
+	if ( argc < 3 ) {
+		std::cerr << "ERROR: Bad number of arguments, expected file path and output." << std::endl;
+		std::cerr << "\t Use: " << argv[0] << " <file> <output_file> [comment_char] [separator_char]" << std::endl;
+		exit(-1);
+	}
+
+	std::string file = argv[1];
+	std::string output = argv[2];
+	char comment = '@';
+	char separator = ',';
+
+	if (argc >= 4) {
+		comment = argv[3][0];
+	}
+
+	if (argc == 5) {
+		separator = argv[4][0];
+	}
+
+	unsigned num_rows = 0;
+	unsigned num_columns = 0;
+
+	// un fichero de texto regular se convierte por bloques, sin cargarlo en memoria
+	if ( expressions_algs::Dataset::is_binary_file(file) ||
+		  !expressions_algs::Dataset::convert_text_file(file, output, comment, separator, num_rows, num_columns) ) {
+
+		// el resto de ficheros se cargan enteros, completando las filas con menos campos
+		auto data = expressions_algs::Dataset::load(file, comment, separator);
+
+		if ( data.get_num_rows() == 0 ) {
+			std::cerr << "ERROR: No data could be read from " << file << std::endl;
+			exit(-1);
+		}
+
+		if ( !data.write_binary(output) ) {
+			std::cerr << "ERROR: Could not write " << output << std::endl;
+			exit(-1);
+		}
+
+		num_rows = data.get_num_rows();
+		num_columns = data.get_num_columns();
+	}
+
+	std::cout << "Converted " << num_rows << " rows and " << num_columns
+	          << " features to " << output << std::endl;
+
+}
@@ -6,9 +6,6 @@
 #include "Random.hpp"
 #include <chrono>
 #include <ranges>
-#ifdef _OPENMP
-	#include <omp.h>
-#endif
 
 
 int main(int argc, char ** argv){
@@ -33,10 +30,8 @@ int main(int argc, char ** argv){
 
 
 	int num_trabajos = 2;
-	// si utilizamos openMP, establecemos el número de trabajos
-	#ifdef _OPENMP
-		omp_set_num_threads(num_trabajos);
-	#endif
+	// establecemos el número de hebras del planificador de tareas
+	expressions_algs::Task_scheduler::set_global_threads(num_trabajos);
 
 	int original_seed = seed;
 	Random::set_seed(seed);
@@ -46,20 +41,14 @@ int main(int argc, char ** argv){
  
 	expressions_algs::Expression expression(file_exp, max_depth, num_vars);
 
-	expression.evaluate_expression(data.first, data.second, expressions_algs::aux::cuadratic_mean_error, true);
-	double error_medio_ecm = expression.get_fitness();
-
-	expression.evaluate_expression(data.first, data.second, expressions_algs::aux::root_cuadratic_mean_error, true);
-	double error_medio_recm = expression.get_fitness();
-
-	expression.evaluate_expression(data.first, data.second, expressions_algs::aux::mean_absolute_error, true);
-	double error_medio_mae = expression.get_fitness();
+	// una sola prediccion de los datos para las tres metricas
+	const auto metricas = expression.evaluate_metrics(data.first, data.second);
 
 	// mostramos el resultado
 	std::cout << original_seed << "\t"
-				 << error_medio_ecm << "\t"
-				 << error_medio_recm << "\t"
-				 << error_medio_mae << std::endl;
+				 << metricas.mse << "\t"
+				 << metricas.rmse << "\t"
+				 << metricas.mae << std::endl;
 
 	return 0;
 
@@ -0,0 +1,232 @@
+#include <iostream>
+#include "expressions_algs/GA_P_alg.hpp"
+#include "expressions_algs/GP_alg.hpp"
+#include "expressions_algs/Island_coordinator.hpp"
+#include "expressions_algs/Island_worker.hpp"
+
+#include "Random.hpp"
+#include <chrono>
+#include <map>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+// parametros que el coordinador envia a las islas, en el orden de la linea de ordenes
+const std::vector<std::string> PARAMETROS = {"train", "test", "algorithm", "population_size", "variable_prob",
+															"max_depth", "num_evaluations", "prob_pg_crossover", "prob_ga_crossover",
+															"prob_gp_mutation", "prob_ga_mutation", "prob_inter_niche_crossover",
+															"tournament_size", "seed"};
+
+void mostrar_uso(const char * programa) {
+	std::cerr << "ERROR: Wrong number of params\n"
+				 << "\t Use: " << programa << " coordinator <address> <num_islands> <train_data_file> <test_data_file> <GAP|GP>\n"
+				 << "\t\t\t <population_size> <variable_prob> <max_depth> <num_evaluations> <prob_pg_crossover> <prob_ga_crossover>\n"
+				 << "\t\t\t <prob_gp_mutation> <prob_ga_mutation> <prob_inter_niche_crossover> <tournament_size> <seed>\n"
+				 << "\t\t\t [migration_interval] [migrants] [ring|random|full]\n"
+				 << "\t      " << programa << " worker <address> [num_jobs]\n"
+				 << "\t      " << programa << " local <num_islands> <train_data_file> ... (the same params as coordinator)\n"
+				 << "\t address is unix:<path> or tcp:<host>:<port>. Every worker reads train_data_file from its own disk.\n"
+				 << "\t local runs the coordinator and one worker process per island in this machine."
+				 << std::endl;
+}
+
+// topologia de migracion a partir de su nombre: ring, random o full
+expressions_algs::MigrationTopology topologia(const std::string & nombre) {
+	expressions_algs::MigrationTopology resultado = expressions_algs::MigrationTopology::RING;
+
+	if ( nombre == "random" ) {
+		resultado = expressions_algs::MigrationTopology::RANDOM;
+	} else if ( nombre == "full" ) {
+		resultado = expressions_algs::MigrationTopology::FULLY_CONNECTED;
+	}
+
+	return resultado;
+}
+
+// cada linea de la configuracion es un parametro seguido de su valor
+std::map<std::string, std::string> leer_configuracion(const std::string & texto) {
+	std::map<std::string, std::string> configuracion;
+	std::istringstream entrada (texto);
+	std::string nombre, valor;
+
+	while ( entrada >> nombre >> valor ) {
+		configuracion[nombre] = valor;
+	}
+
+	return configuracion;
+}
+
+// parametros de ajuste de una isla, con las mismas funciones de error que main
+expressions_algs::Parameters parametros_ejecucion(const std::map<std::string, std::string> & configuracion) {
+	expressions_algs::Parameters execution_params(std::stoi(configuracion.at("num_evaluations")),
+																 expressions_algs::aux::cuadratic_mean_error,
+																 std::stod(configuracion.at("prob_pg_crossover")),
+																 std::stod(configuracion.at("prob_ga_crossover")),
+																 std::stod(configuracion.at("prob_gp_mutation")),
+																 std::stod(configuracion.at("prob_ga_mutation")),
+																 std::stod(configuracion.at("prob_inter_niche_crossover")),
+																 std::stoi(configuracion.at("tournament_size")), false);
+
+	execution_params.add_error_function(expressions_algs::aux::root_cuadratic_mean_error);
+	execution_params.add_error_function(expressions_algs::aux::mean_absolute_error);
+
+	return execution_params;
+}
+
+// ajusta la isla asignada al trabajador, todas las islas crean el algoritmo igual
+template <class ALG, class EXP>
+bool ajustar_isla(expressions_algs::Island_worker<EXP> & trabajador,
+						const std::map<std::string, std::string> & configuracion) {
+
+	const auto datos = expressions_algs::Dataset::load(configuracion.at("train"), '@', ',');
+
+	if ( datos.get_num_rows() == 0 ) {
+		std::cerr << "ERROR: Could not read " << configuracion.at("train") << std::endl;
+		return false;
+	}
+
+	ALG algoritmo (datos, std::stoi(configuracion.at("seed")), std::stoi(configuracion.at("population_size")),
+						std::stoi(configuracion.at("max_depth")), std::stod(configuracion.at("variable_prob")));
+
+	return trabajador.fit(algoritmo, parametros_ejecucion(configuracion));
+}
+
+int ejecutar_trabajador(const std::string & direccion) {
+	expressions_algs::Socket_channel canal;
+	expressions_algs::Island_assignment asignacion;
+
+	if ( !expressions_algs::Island_coordinator::join(direccion, canal, asignacion) ) {
+		std::cerr << "ERROR: Could not connect to " << direccion << std::endl;
+		return -1;
+	}
+
+	// el tipo de los individuos viene en la configuracion enviada por el coordinador
+	const std::map<std::string, std::string> configuracion = leer_configuracion(asignacion.configuration);
+	bool correcto = false;
+
+	if ( configuracion.at("algorithm") == "GP" ) {
+		expressions_algs::Island_worker<expressions_algs::Expression> trabajador (std::move(canal), asignacion);
+		correcto = ajustar_isla<expressions_algs::GP_alg>(trabajador, configuracion);
+	} else {
+		expressions_algs::Island_worker<expressions_algs::GA_P_Expression> trabajador (std::move(canal), asignacion);
+		correcto = ajustar_isla<expressions_algs::GA_P_alg>(trabajador, configuracion);
+	}
+
+	return correcto ? 0 : -1;
+}
+
+// escribe el mejor individuo de cada isla y las metricas en test del mejor de todas, como main
+template <class EXP>
+void mostrar_resultados(const expressions_algs::Island_coordinator & coordinador,
+								const std::map<std::string, std::string> & configuracion, const double segundos) {
+
+	const std::string & seed = configuracion.at("seed");
+	const std::string & nombre = configuracion.at("algorithm");
+	std::vector<EXP> mejores (coordinador.get_num_islands());
+
+	for ( unsigned i = 0; i < mejores.size(); i++) {
+		std::istringstream entrada (coordinador.get_result(i));
+		mejores[i].read(entrada);
+
+		std::cout << seed << "\t"
+					 << coordinador.get_fitness(i) << "\t"
+					 << mejores[i] << "\t " << nombre << "\t" << "island: " << i << std::endl;
+	}
+
+	const auto test = expressions_algs::Dataset::load(configuracion.at("test"), '@', ',');
+	const EXP & mejor = mejores[coordinador.get_best_island()];
+	const auto metricas = mejor.evaluate_metrics(test, test.get_labels());
+
+	std::cout << seed << "\t"
+				 << metricas.mse << "\t"
+				 << metricas.rmse << "\t"
+				 << metricas.mae << "\t"
+				 << mejor << "\t"
+				 << segundos << "\t " << nombre << " ISLANDS" << "\t" << "migrations: " << coordinador.get_num_migrations()
+				 << std::endl;
+}
+
+int main(int argc, char ** argv) {
+
+	const std::string modo = argc > 1 ? argv[1] : "";
+
+	if ( modo == "worker" && ( argc == 3 || argc == 4 ) ) {
+		// establecemos el número de hebras del planificador de tareas
+		if ( argc == 4 ) {
+			expressions_algs::Task_scheduler::set_global_threads(std::max(atoi(argv[3]), 1));
+		}
+
+		return ejecutar_trabajador(argv[2]);
+	}
+
+	// coordinator y local reciben los mismos parametros, local no recibe la direccion
+	const int primero = modo == "coordinator" ? 3 : 2;
+	const int num_parametros = argc - primero - 1;
+
+	if ( ( modo != "coordinator" && modo != "local" ) || num_parametros < static_cast<int>(PARAMETROS.size()) ||
+		  num_parametros > static_cast<int>(PARAMETROS.size()) + 3 ) {
+		mostrar_uso(argv[0]);
+		exit(-1);
+	}
+
+	const unsigned num_islas = std::max(atoi(argv[primero]), 1);
+	std::ostringstream configuracion;
+
+	for ( unsigned i = 0; i < PARAMETROS.size(); i++) {
+		configuracion << PARAMETROS[i] << " " << argv[primero + 1 + i] << "\n";
+	}
+
+	const int opcionales = primero + 1 + PARAMETROS.size();
+	const unsigned long seed = std::stoul(argv[primero + PARAMETROS.size()]);
+	const unsigned intervalo = argc > opcionales ? atoi(argv[opcionales]) : 10;
+	const unsigned emigrantes = argc > opcionales + 1 ? atoi(argv[opcionales + 1]) : 5;
+	const std::string nombre_topologia = argc > opcionales + 2 ? argv[opcionales + 2] : "ring";
+
+	const std::string direccion = modo == "coordinator" ? std::string(argv[2]) :
+											"unix:/tmp/main_islands_" + std::to_string(getpid()) + ".sock";
+
+	expressions_algs::Island_coordinator coordinador (num_islas, seed, intervalo, emigrantes, topologia(nombre_topologia));
+
+	if ( !coordinador.listen(direccion) ) {
+		std::cerr << "ERROR: Could not listen on " << direccion << std::endl;
+		exit(-1);
+	}
+
+	// en local cada isla es un proceso hijo; se crean antes de que el padre use openMP
+	std::vector<pid_t> hijos;
+
+	for ( unsigned i = 0; i < num_islas && modo == "local"; i++) {
+		const pid_t hijo = fork();
+
+		if ( hijo == 0 ) {
+			_exit(ejecutar_trabajador(coordinador.get_address()) == 0 ? 0 : 1);
+		}
+
+		hijos.push_back(hijo);
+	}
+
+	const auto start_time = std::chrono::high_resolution_clock::now();
+	const std::map<std::string, std::string> parametros = leer_configuracion(configuracion.str());
+
+	bool correcto = coordinador.run(configuracion.str());
+
+	for ( const pid_t hijo : hijos ) {
+		int estado = 0;
+		correcto = waitpid(hijo, &estado, 0) == hijo && WIFEXITED(estado) && WEXITSTATUS(estado) == 0 && correcto;
+	}
+
+	if ( !correcto ) {
+		std::cerr << "ERROR: An island did not finish" << std::endl;
+		exit(-1);
+	}
+
+	std::chrono::duration<double> execution_time = std::chrono::high_resolution_clock::now() - start_time;
+
+	if ( parametros.at("algorithm") == "GP" ) {
+		mostrar_resultados<expressions_algs::Expression>(coordinador, parametros, execution_time.count());
+	} else {
+		mostrar_resultados<expressions_algs::GA_P_Expression>(coordinador, parametros, execution_time.count());
+	}
+
+	return 0;
+}
@@ -0,0 +1,461 @@
+#include <iostream>
+#include "expressions_algs/GA_P_alg.hpp"
+#include "expressions_algs/GP_alg.hpp"
+#include "expressions_algs/Fold_executor.hpp"
+#include "expressions_algs/Successive_halving.hpp"
+#include "expressions_algs/Island_model.hpp"
+
+#include "Random.hpp"
+#include <chrono>
+#include <map>
+#include <sys/stat.h>
+
+
+// numero de ficheros de train/test de la validacion cruzada, como en main
+const unsigned num_it = 5;
+
+// valores de cada parametro de la rejilla, por defecto los de executions.sh
+typedef std::map<std::string, std::vector<std::string> > Rejilla;
+
+const std::vector<std::string> PARAMETROS = {"population_size", "variable_prob", "max_depth", "num_evaluations",
+															"prob_pg_crossover", "prob_ga_crossover", "prob_gp_mutation",
+															"prob_ga_mutation", "prob_inter_niche_crossover", "tournament_size",
+															"steady_state", "pipelined", "islands", "migration_interval", "migrants",
+															"topology", "seed"};
+
+// parametros que fijan la poblacion inicial, cada combinacion de ellos es una busqueda por successive halving
+const std::vector<std::string> PARAMETROS_ESTRUCTURA = {"population_size", "variable_prob", "max_depth", "seed"};
+
+Rejilla rejilla_por_defecto() {
+	Rejilla rejilla;
+
+	rejilla["population_size"] = {"1000"};
+	rejilla["variable_prob"] = {"0.3"};
+	rejilla["max_depth"] = {"20", "60"};
+	rejilla["num_evaluations"] = {"1000000"};
+	rejilla["prob_pg_crossover"] = {"0.75"};
+	rejilla["prob_ga_crossover"] = {"0.75"};
+	rejilla["prob_gp_mutation"] = {"0.05"};
+	rejilla["prob_ga_mutation"] = {"0.05"};
+	rejilla["prob_inter_niche_crossover"] = {"0.3"};
+	rejilla["tournament_size"] = {"100"};
+	rejilla["steady_state"] = {"0"};
+	rejilla["pipelined"] = {"0"};
+
+	// con mas de una isla cada ejecucion es un modelo de islas del algoritmo
+	rejilla["islands"] = {"1"};
+	rejilla["migration_interval"] = {"10"};
+	rejilla["migrants"] = {"5"};
+	rejilla["topology"] = {"ring"};
+	rejilla["seed"] = {"12345", "92034", "8324", "34679", "34634"};
+
+	// con halving_min_evaluations mayor que 0 se buscan los mejores parametros en lugar de ejecutarlos todos
+	rejilla["halving_min_evaluations"] = {"0"};
+	rejilla["halving_eta"] = {"3"};
+
+	return rejilla;
+}
+
+// cada linea es el nombre de un parametro seguido de sus valores, # marca un comentario
+bool leer_rejilla(const std::string & fichero, Rejilla & rejilla) {
+	std::ifstream entrada (fichero);
+	std::string linea;
+
+	while ( entrada && std::getline(entrada, linea) ) {
+		std::stringstream ss (linea.substr(0, linea.find('#')));
+		std::string nombre, valor;
+
+		if ( ss >> nombre ) {
+			if ( rejilla.find(nombre) == rejilla.end() ) {
+				std::cerr << "ERROR: Unknown parameter " << nombre << " in " << fichero << std::endl;
+				return false;
+			}
+
+			rejilla[nombre].clear();
+
+			while ( ss >> valor ) {
+				rejilla[nombre].push_back(valor);
+			}
+
+			if ( rejilla[nombre].empty() ) {
+				std::cerr << "ERROR: Parameter " << nombre << " without values in " << fichero << std::endl;
+				return false;
+			}
+		}
+	}
+
+	return static_cast<bool>(entrada) || entrada.eof();
+}
+
+// fichero de un dato de la validacion cruzada, cambiando el primer 0 por el indice, como en main
+std::string fichero_fold(const std::string & fichero, const unsigned i) {
+	std::string resultado = fichero;
+	const std::string::size_type n = resultado.find("0");
+
+	if ( n != std::string::npos ) {
+		resultado.replace(n, 1, std::to_string(i));
+	}
+
+	return resultado;
+}
+
+std::string nombre_base(const std::string & fichero) {
+	const std::string::size_type barra = fichero.find_last_of('/');
+
+	return barra == std::string::npos ? fichero : fichero.substr(barra + 1);
+}
+
+// parametros de ajuste de una ejecucion, con las mismas funciones de error que main
+expressions_algs::Parameters parametros_ejecucion(const std::map<std::string, std::string> & configuracion) {
+	expressions_algs::Parameters execution_params(std::stoi(configuracion.at("num_evaluations")),
+																 expressions_algs::aux::cuadratic_mean_error,
+																 std::stod(configuracion.at("prob_pg_crossover")),
+																 std::stod(configuracion.at("prob_ga_crossover")),
+																 std::stod(configuracion.at("prob_gp_mutation")),
+																 std::stod(configuracion.at("prob_ga_mutation")),
+																 std::stod(configuracion.at("prob_inter_niche_crossover")),
+																 std::stoi(configuracion.at("tournament_size")), false);
+
+	execution_params.set_steady_state(std::stoi(configuracion.at("steady_state")) != 0);
+	execution_params.set_pipelined(std::stoi(configuracion.at("pipelined")) != 0);
+
+	execution_params.add_error_function(expressions_algs::aux::root_cuadratic_mean_error);
+	execution_params.add_error_function(expressions_algs::aux::mean_absolute_error);
+
+	return execution_params;
+}
+
+/**
+  * @brief Datos de todas las ejecuciones, leidos una sola vez y compartidos sin copiarlos
+  */
+
+struct Almacen_datos {
+	std::vector<expressions_algs::Dataset> train;
+	std::vector<expressions_algs::Dataset> test;
+	expressions_algs::Dataset validacion;
+};
+
+// topologia de migracion a partir de su nombre en la rejilla: ring, random o full
+expressions_algs::MigrationTopology topologia(const std::string & nombre) {
+	expressions_algs::MigrationTopology resultado = expressions_algs::MigrationTopology::RING;
+
+	if ( nombre == "random" ) {
+		resultado = expressions_algs::MigrationTopology::RANDOM;
+	} else if ( nombre == "full" ) {
+		resultado = expressions_algs::MigrationTopology::FULLY_CONNECTED;
+	}
+
+	return resultado;
+}
+
+// ajusta un modelo de islas del algoritmo con sus propias hebras y prueba su mejor individuo, con el
+// mismo resultado que fit_cv_files
+template <class EXP>
+std::pair<EXP, std::vector<std::vector<double> > > ajustar_islas(const expressions_algs::Population_alg<EXP> & algoritmo,
+																					  const expressions_algs::Dataset & test,
+																					  const std::map<std::string, std::string> & configuracion,
+																					  const expressions_algs::Parameters & parametros,
+																					  const unsigned num_hebras) {
+
+	expressions_algs::Island_model<EXP> islas (algoritmo, std::stoi(configuracion.at("islands")),
+															 std::stoi(configuracion.at("seed")),
+															 std::stoi(configuracion.at("migration_interval")),
+															 std::stoi(configuracion.at("migrants")),
+															 topologia(configuracion.at("topology")));
+	islas.fit(parametros, num_hebras);
+
+	const EXP mejor = islas.get_best_individual();
+	const auto metricas = mejor.evaluate_metrics(test, test.get_labels());
+
+	return std::make_pair(mejor, std::vector<std::vector<double> >{{metricas.mse}, {metricas.rmse}, {metricas.mae}});
+}
+
+// ajusta el algoritmo con cada fold y lo valida, escribiendo las mismas lineas que main; un modelo de
+// islas usa hebras_islas hebras
+template <class ALG, class EXP>
+void ejecutar_algoritmo(const Almacen_datos & almacen, const std::map<std::string, std::string> & configuracion,
+								const expressions_algs::Parameters & parametros, const std::string & nombre,
+								std::ostream & salida, const unsigned hebras_islas) {
+
+	const int seed = std::stoi(configuracion.at("seed"));
+	const int population_size = std::stoi(configuracion.at("population_size"));
+	const double prob_variable = std::stod(configuracion.at("variable_prob"));
+	const int max_expression_depth = std::stoi(configuracion.at("max_depth"));
+
+	double mean_error_ecm = 0.0;
+	double mean_error_recm = 0.0;
+	double mean_error_mae = 0.0;
+	double best_error = 100000.0;
+
+	EXP best_expression;
+
+	auto start_time = std::chrono::high_resolution_clock::now();
+
+	for ( unsigned i = 0; i < num_it; i++) {
+		auto start_time_it = std::chrono::high_resolution_clock::now();
+
+		ALG algoritmo (almacen.train[i], seed, population_size, max_expression_depth, prob_variable);
+
+		auto cv_result = std::stoi(configuracion.at("islands")) > 1 ?
+							  ajustar_islas<EXP>(algoritmo, almacen.test[i], configuracion, parametros, hebras_islas) :
+							  algoritmo.fit_cv_files(almacen.train[i], almacen.test[i], parametros);
+
+		std::chrono::duration<double> execution_time = std::chrono::high_resolution_clock::now() - start_time_it;
+
+		salida << seed << "\t"
+				 << cv_result.second[0][0] << "\t"
+				 << cv_result.second[1][0] << "\t"
+				 << cv_result.second[2][0] << "\t"
+				 << cv_result.first << "\t"
+				 << execution_time.count() << "\t " << nombre << "\t" << "cv: " << i << std::endl;
+
+		if ( cv_result.second[0][0] < best_error ) {
+			best_expression = cv_result.first;
+			best_error = cv_result.second[0][0];
+		}
+
+		mean_error_ecm += cv_result.second[0][0];
+		mean_error_recm += cv_result.second[1][0];
+		mean_error_mae += cv_result.second[2][0];
+	}
+
+	std::chrono::duration<double> execution_time = std::chrono::high_resolution_clock::now() - start_time;
+
+	salida << seed << "\t"
+			 << mean_error_ecm / num_it << "\t"
+			 << mean_error_recm / num_it << "\t"
+			 << mean_error_mae / num_it << "\t"
+			 << best_expression << "\t"
+			 << execution_time.count() << "\t " << nombre << " AVG" << std::endl;
+
+	start_time = std::chrono::high_resolution_clock::now();
+
+	const expressions_algs::Dataset & datos_val = almacen.validacion;
+
+	// una sola prediccion de validacion para las tres metricas
+	const auto metricas_val = best_expression.evaluate_metrics(datos_val, datos_val.get_labels());
+
+	execution_time = std::chrono::high_resolution_clock::now() - start_time;
+
+	salida << seed << "\t"
+			 << metricas_val.mse << "\t"
+			 << metricas_val.rmse << "\t"
+			 << metricas_val.mae << "\t"
+			 << best_expression << "\t"
+			 << execution_time.count() << "\t " << nombre << " VAL" << std::endl;
+}
+
+// busca por successive halving los mejores parametros de ajuste entre las ejecuciones de un grupo, que
+// comparten la poblacion inicial, ajustando con el primer fold de train y validando con el primer fold de test
+template <class ALG, class EXP>
+void buscar_parametros(const Almacen_datos & almacen, const std::vector<std::map<std::string, std::string> > & grupo,
+							  const Rejilla & rejilla, const std::string & nombre, std::ostream & salida) {
+
+	const auto & estructura = grupo.front();
+	const int seed = std::stoi(estructura.at("seed"));
+
+	std::vector<expressions_algs::Parameters> candidatos;
+	int max_evaluaciones = 0;
+
+	for ( unsigned i = 0; i < grupo.size(); i++) {
+		candidatos.push_back(parametros_ejecucion(grupo[i]));
+		max_evaluaciones = std::max(max_evaluaciones, candidatos.back().get_num_evaluations());
+	}
+
+	auto start_time = std::chrono::high_resolution_clock::now();
+
+	ALG algoritmo (almacen.train[0], seed, std::stoi(estructura.at("population_size")),
+						std::stoi(estructura.at("max_depth")), std::stod(estructura.at("variable_prob")));
+
+	expressions_algs::Successive_halving<EXP> busqueda (candidatos, std::stoi(rejilla.at("halving_min_evaluations").front()),
+																		 max_evaluaciones, std::stoi(rejilla.at("halving_eta").front()));
+
+	const unsigned mejor = busqueda.search(algoritmo, almacen.test[0], seed);
+
+	std::chrono::duration<double> execution_time = std::chrono::high_resolution_clock::now() - start_time;
+
+	// error en validacion del mejor candidato, con el algoritmo que ha ido continuando entre peldaños
+	const expressions_algs::Dataset & datos_val = almacen.validacion;
+	const auto metricas_val = expressions_algs::aux::compute_metrics(busqueda.get_best_algorithm().predict(datos_val),
+																						  datos_val.get_labels());
+
+	salida << seed << "\t"
+			 << busqueda.get_scores()[mejor] << "\t"
+			 << metricas_val.mse << "\t"
+			 << metricas_val.rmse << "\t"
+			 << metricas_val.mae << "\t"
+			 << busqueda.get_evaluations()[mejor] << "\t"
+			 << busqueda.get_best_algorithm().get_best_individual() << "\t"
+			 << execution_time.count() << "\t " << nombre;
+
+	for ( auto it = PARAMETROS.begin(); it != PARAMETROS.end(); ++it) {
+		const bool estructura_fija = std::find(PARAMETROS_ESTRUCTURA.begin(), PARAMETROS_ESTRUCTURA.end(), *it) !=
+											  PARAMETROS_ESTRUCTURA.end();
+
+		if ( !estructura_fija && rejilla.at(*it).size() > 1 ) {
+			salida << " " << *it << "=" << grupo[mejor].at(*it);
+		}
+	}
+
+	salida << std::endl;
+}
+
+
+int main(int argc, char ** argv) {
+
+	if ( argc < 5 || argc > 7 ) {
+		std::cerr << "ERROR: Wrong number of params\n"
+					 << "\t Use: " << argv[0] << " <train_data_file> <test_data_file> <val_data_file> <grid_file> [output_dir] [num_threads]\n"
+					 << "\t Each line of grid_file is a parameter followed by its values, the runs are all the combinations:\n\t\t";
+
+		for ( unsigned i = 0; i < PARAMETROS.size(); i++) {
+			std::cerr << PARAMETROS[i] << " ";
+		}
+
+		std::cerr << "\n\t With halving_min_evaluations > 0 (and halving_eta) the fit parameters are searched by successive halving instead"
+					 << std::endl;
+		exit(-1);
+	}
+
+	Rejilla rejilla = rejilla_por_defecto();
+
+	if ( !leer_rejilla(argv[4], rejilla) ) {
+		exit(-1);
+	}
+
+	const std::string directorio = argc >= 6 ? argv[5] : "executions_output";
+	unsigned num_hebras = expressions_algs::Evaluation_scheduler::available_threads();
+
+	if ( argc == 7 ) {
+		num_hebras = std::max(atoi(argv[6]), 1);
+	}
+
+	// todos los bucles paralelos, la lectura de los datos incluida, usan como mucho num_hebras hebras
+	expressions_algs::Task_scheduler::set_global_threads(num_hebras);
+
+	mkdir(directorio.c_str(), 0755);
+
+	const bool halving = std::stoi(rejilla["halving_min_evaluations"].front()) > 0;
+
+	// leemos cada fichero una sola vez, todas las ejecuciones comparten los datos
+	Almacen_datos almacen;
+
+	for ( unsigned i = 0; i < num_it; i++) {
+		almacen.train.push_back(expressions_algs::Dataset::load(fichero_fold(argv[1], i), '@', ','));
+		almacen.test.push_back(expressions_algs::Dataset::load(fichero_fold(argv[2], i), '@', ','));
+	}
+
+	almacen.validacion = expressions_algs::Dataset::load(argv[3], '@', ',');
+
+	// todas las combinaciones de la rejilla, la semilla es la que cambia mas deprisa
+	std::vector<std::map<std::string, std::string> > ejecuciones (1);
+
+	for ( auto it = PARAMETROS.begin(); it != PARAMETROS.end(); ++it) {
+		std::vector<std::map<std::string, std::string> > combinaciones;
+
+		for ( unsigned i = 0; i < ejecuciones.size(); i++) {
+			for ( unsigned j = 0; j < rejilla[*it].size(); j++) {
+				combinaciones.push_back(ejecuciones[i]);
+				combinaciones.back()[*it] = rejilla[*it][j];
+			}
+		}
+
+		ejecuciones = combinaciones;
+	}
+
+	if ( halving ) {
+		// agrupamos las ejecuciones que comparten la poblacion inicial, en el orden de la rejilla
+		std::map<std::string, unsigned> indice_grupo;
+		std::vector<std::vector<std::map<std::string, std::string> > > grupos;
+
+		for ( unsigned e = 0; e < ejecuciones.size(); e++) {
+			std::string clave;
+
+			for ( auto it = PARAMETROS_ESTRUCTURA.begin(); it != PARAMETROS_ESTRUCTURA.end(); ++it) {
+				clave += ejecuciones[e][*it] + " ";
+			}
+
+			if ( indice_grupo.find(clave) == indice_grupo.end() ) {
+				indice_grupo[clave] = grupos.size();
+				grupos.emplace_back();
+			}
+
+			grupos[indice_grupo[clave]].push_back(ejecuciones[e]);
+		}
+
+		std::clog << "# successive halving: " << grupos.size() << " searches of " << grupos.front().size()
+					 << " candidates" << std::endl;
+
+		std::ofstream salida (directorio + "/" + nombre_base(argv[1]) + "_halving.dat");
+		salida << "# seed \t Score test 0 \t MSE val \t RMSE val \t MAE val \t Evaluations \t Best expression \t Execution time \t Best parameters\n";
+
+		// cada busqueda ajusta a la vez los candidatos de cada peldaño
+		for ( unsigned g = 0; g < grupos.size(); g++) {
+			salida << "# max_depth " << grupos[g].front()["max_depth"] << " population_size "
+					 << grupos[g].front()["population_size"] << " variable_prob " << grupos[g].front()["variable_prob"] << "\n";
+
+			buscar_parametros<expressions_algs::GA_P_alg, expressions_algs::GA_P_Expression>(almacen, grupos[g], rejilla,
+																														 "GAP", salida);
+			buscar_parametros<expressions_algs::GP_alg, expressions_algs::Expression>(almacen, grupos[g], rejilla,
+																											"GP", salida);
+		}
+
+		return 0;
+	}
+
+	// un fichero por combinacion de parametros sin contar la semilla, como executions.sh con la profundidad
+	std::vector<std::string> ficheros (ejecuciones.size());
+
+	for ( unsigned e = 0; e < ejecuciones.size(); e++) {
+		ficheros[e] = directorio + "/" + nombre_base(argv[1]) + "_prof_" + ejecuciones[e]["max_depth"];
+
+		for ( auto it = PARAMETROS.begin(); it != PARAMETROS.end(); ++it) {
+			if ( *it != "seed" && *it != "max_depth" && rejilla[*it].size() > 1 ) {
+				ficheros[e] += "_" + *it + "_" + ejecuciones[e][*it];
+			}
+		}
+
+		ficheros[e] += ".dat";
+	}
+
+	std::vector<std::string> resultados (ejecuciones.size());
+
+	// un conjunto fijo de hebras para todas las ejecuciones, las que sobran las toman sus bucles paralelos
+	expressions_algs::Fold_executor ejecutor (ejecuciones.size(), num_hebras);
+
+	std::clog << "# " << ejecuciones.size() << " runs, " << ejecutor.get_concurrent_folds() << " concurrent, "
+				 << num_hebras << " threads" << std::endl;
+
+	// los modelos de islas tienen sus propios pools, cada ejecucion a la vez se queda con una parte de las hebras
+	const unsigned hebras_islas = std::max(num_hebras / ejecutor.get_concurrent_folds(), 1u);
+
+	ejecutor.run([&](const unsigned e) {
+		const auto & configuracion = ejecuciones[e];
+		const expressions_algs::Parameters execution_params = parametros_ejecucion(configuracion);
+
+		std::stringstream salida;
+
+		ejecutar_algoritmo<expressions_algs::GA_P_alg, expressions_algs::GA_P_Expression>(almacen, configuracion,
+																													 execution_params, "GAP", salida, hebras_islas);
+		ejecutar_algoritmo<expressions_algs::GP_alg, expressions_algs::Expression>(almacen, configuracion,
+																										execution_params, "GP", salida, hebras_islas);
+
+		resultados[e] = salida.str();
+	});
+
+	// escribimos los resultados en el orden de la rejilla, sin importar cuando terminase cada ejecucion
+	std::map<std::string, std::ofstream> salidas;
+
+	for ( unsigned e = 0; e < ejecuciones.size(); e++) {
+		if ( salidas.find(ficheros[e]) == salidas.end() ) {
+			salidas[ficheros[e]].open(ficheros[e]);
+			salidas[ficheros[e]] << "# seed \t MSE 5cv \t RMSE 5cv \t MAE 5cv \t Best expression  \t Execution time\n";
+		}
+
+		salidas[ficheros[e]] << resultados[e];
+	}
+
+	std::clog << "# " << ejecutor.get_wall_time() << " s, speedup " << ejecutor.get_speedup() << std::endl;
+
+	return 0;
+}
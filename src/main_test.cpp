@@ -1,6 +1,8 @@
 #include "tests/tests_nodo.hpp"
 #include "tests/tests_expresion.hpp"
 #include "tests/tests_expresion_gap.hpp"
+#include "tests/tests_poblacion.hpp"
+#include "tests/tests_datos.hpp"
 
 #include <gtest/gtest.h>
 
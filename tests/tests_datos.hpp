@@ -0,0 +1,214 @@
+#ifndef TESTS_DATOS
+#define TESTS_DATOS
+
+#include <gtest/gtest.h>
+#include "expressions_algs/Dataset.hpp"
+#include "expressions_algs/preprocess.hpp"
+
+TEST (Dataset, LeerFichero) {
+	expressions_algs::Dataset datos;
+
+	ASSERT_TRUE(expressions_algs::Dataset::read_file("tests/test_datos.dat", '@', ',', datos));
+
+	// se ignoran la cabecera, los comentarios, las lineas vacias y las que empiezan por un blanco
+	ASSERT_EQ(datos.get_num_rows(), 3u);
+	ASSERT_EQ(datos.get_num_columns(), 3u);
+
+	EXPECT_DOUBLE_EQ(datos.get_row(0)[0], 1.5);
+	EXPECT_DOUBLE_EQ(datos.get_row(0)[1], -2.0);
+	EXPECT_DOUBLE_EQ(datos.get_row(0)[2], 300.0);
+	EXPECT_DOUBLE_EQ(datos.get_labels()[0], 4.0);
+
+	// los valores se convierten igual que con strtod
+	EXPECT_DOUBLE_EQ(datos.get_row(1)[0], 16.0);
+	EXPECT_TRUE(std::isinf(datos.get_row(1)[1]));
+	EXPECT_DOUBLE_EQ(datos.get_labels()[1], -0.25);
+
+	// la ultima linea no tiene salto de linea
+	EXPECT_DOUBLE_EQ(datos.get_labels()[2], 11.0);
+}
+
+TEST (Dataset, FicheroIrregular) {
+	expressions_algs::Dataset datos (matriz<double>(1, std::vector<double>(1)), std::vector<double>(1));
+
+	// con lineas de distinto numero de campos no se modifican los datos
+	EXPECT_FALSE(expressions_algs::Dataset::read_file("tests/test_datos_irregular.dat", '@', ',', datos));
+	EXPECT_EQ(datos.get_num_rows(), 1u);
+
+	EXPECT_FALSE(expressions_algs::Dataset::read_file("tests/no_existe.dat", '@', ',', datos));
+}
+
+TEST (Dataset, FormatoBinarioSinCopia) {
+	expressions_algs::Dataset texto;
+
+	ASSERT_TRUE(expressions_algs::Dataset::read_file("tests/test_datos.dat", '@', ',', texto));
+	ASSERT_TRUE(texto.write_binary("tests/test_datos.bin"));
+
+	EXPECT_TRUE(expressions_algs::Dataset::is_binary_file("tests/test_datos.bin"));
+	EXPECT_FALSE(expressions_algs::Dataset::is_binary_file("tests/test_datos.dat"));
+
+	expressions_algs::Dataset binario;
+
+	ASSERT_TRUE(expressions_algs::Dataset::map_binary("tests/test_datos.bin", binario, true));
+	std::remove("tests/test_datos.bin");
+
+	// las columnas estan alineadas a 64 bytes y se accede con el paso entre columnas
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(binario.get_row(0)) % 64, 0u);
+	EXPECT_EQ(binario.get_column_stride(), 8u);
+	EXPECT_NE(binario.get_content_hash(), 0u);
+
+	ASSERT_EQ(binario.get_num_rows(), texto.get_num_rows());
+	ASSERT_EQ(binario.get_num_columns(), texto.get_num_columns());
+
+	EXPECT_EQ(binario.to_matrix(), texto.to_matrix());
+	EXPECT_EQ(binario.get_labels(), texto.get_labels());
+}
+
+TEST (Dataset, CabeceraBinariaCorrupta) {
+	expressions_algs::Dataset texto;
+
+	ASSERT_TRUE(expressions_algs::Dataset::read_file("tests/test_datos.dat", '@', ',', texto));
+
+	// escribe el fichero con otras filas y otro paso entre columnas, con la tabla de columnas
+	// coherente con ellos aunque el calculo se desborde, y lo intenta proyectar
+	auto proyectar_con = [&texto](const std::uint64_t filas, const std::uint64_t paso) {
+		EXPECT_TRUE(texto.write_binary("tests/test_datos.bin"));
+
+		std::fstream fichero ("tests/test_datos.bin", std::ios::in | std::ios::out | std::ios::binary);
+		std::uint64_t inicio_columnas;
+
+		fichero.seekg(32);
+		fichero.read(reinterpret_cast<char *>(&inicio_columnas), sizeof(inicio_columnas));
+
+		fichero.seekp(16);
+		fichero.write(reinterpret_cast<const char *>(&filas), sizeof(filas));
+		fichero.write(reinterpret_cast<const char *>(&paso), sizeof(paso));
+
+		fichero.seekp(64);
+
+		for ( unsigned j = 0; j <= texto.get_num_columns(); j++) {
+			const std::uint64_t desplazamiento = inicio_columnas + j * paso * sizeof(double);
+			fichero.write(reinterpret_cast<const char *>(&desplazamiento), sizeof(desplazamiento));
+		}
+
+		fichero.close();
+
+		expressions_algs::Dataset binario;
+		const bool proyectado = expressions_algs::Dataset::map_binary("tests/test_datos.bin", binario);
+
+		std::remove("tests/test_datos.bin");
+
+		return proyectado;
+	};
+
+	// un paso entre columnas enorme desborda columnas * paso * 8 hasta un tamaño que cabe en el fichero
+	EXPECT_FALSE(proyectar_con(texto.get_num_rows(), 1ULL << 61));
+
+	// mas filas de las que se pueden indexar
+	EXPECT_FALSE(proyectar_con((1ULL << 32) + 3, 1ULL << 61));
+
+	// sin cambiar nada se proyecta
+	EXPECT_TRUE(proyectar_con(texto.get_num_rows(), 8));
+}
+
+TEST (Dataset, ConversionSinCargar) {
+	unsigned filas = 0;
+	unsigned columnas = 0;
+
+	ASSERT_TRUE(expressions_algs::Dataset::convert_text_file("tests/test_datos.dat", "tests/test_datos.bin",
+																				'@', ',', filas, columnas));
+	EXPECT_EQ(filas, 3u);
+	EXPECT_EQ(columnas, 3u);
+
+	expressions_algs::Dataset texto;
+	expressions_algs::Dataset convertido;
+
+	// el fichero convertido es el mismo que se escribe desde los datos cargados
+	ASSERT_TRUE(expressions_algs::Dataset::read_file("tests/test_datos.dat", '@', ',', texto));
+	ASSERT_TRUE(expressions_algs::Dataset::map_binary("tests/test_datos.bin", convertido, true));
+	ASSERT_TRUE(texto.write_binary("tests/test_datos.bin"));
+
+	expressions_algs::Dataset escrito;
+
+	ASSERT_TRUE(expressions_algs::Dataset::map_binary("tests/test_datos.bin", escrito, true));
+	std::remove("tests/test_datos.bin");
+
+	EXPECT_EQ(convertido.get_content_hash(), escrito.get_content_hash());
+	EXPECT_EQ(convertido.to_matrix(), texto.to_matrix());
+	EXPECT_EQ(convertido.get_labels(), texto.get_labels());
+
+	// con lineas de distinto numero de campos no se convierte
+	EXPECT_FALSE(expressions_algs::Dataset::convert_text_file("tests/test_datos_irregular.dat",
+																				 "tests/test_datos.bin", '@', ',', filas, columnas));
+	std::remove("tests/test_datos.bin");
+}
+
+TEST (Dataset, VistaSinCopia) {
+	matriz<double> data (6, std::vector<double>(2));
+	std::vector<double> labels (6);
+
+	for ( unsigned i = 0; i < data.size(); i++) {
+		data[i] = {i * 1.0, i * 2.0};
+		labels[i] = i * 10.0;
+	}
+
+	expressions_algs::Dataset datos (data, labels);
+
+	auto vista = datos.view_rows({5, 1, 3});
+	auto vista_de_vista = vista.view_rows({2, 0});
+
+	// las filas de la vista son las de los datos originales, sin copiarlas
+	EXPECT_TRUE(vista.is_view());
+	EXPECT_FALSE(datos.is_view());
+	EXPECT_EQ(vista.get_row(0), datos.get_row(5));
+	EXPECT_EQ(vista_de_vista.get_row(0), datos.get_row(3));
+
+	EXPECT_EQ(vista.get_labels(), std::vector<double>({50.0, 10.0, 30.0}));
+	EXPECT_DOUBLE_EQ(vista.get_value(1, 1), 2.0);
+	EXPECT_EQ(vista_de_vista.to_matrix(), datos.select_rows({3, 5}).to_matrix());
+}
+
+TEST (Preprocess, SeparacionPorIndices) {
+	Random::set_seed(7);
+
+	auto permutacion = expressions_algs::preprocess::random_permutation(10);
+	auto ordenada = permutacion;
+
+	std::sort(ordenada.begin(), ordenada.end());
+
+	// cada indice aparece una sola vez
+	for ( std::uint32_t i = 0; i < ordenada.size(); i++) {
+		EXPECT_EQ(ordenada[i], i);
+	}
+
+	matriz<double> data (10, std::vector<double>(1));
+	std::vector<double> labels (10);
+
+	for ( unsigned i = 0; i < data.size(); i++) {
+		data[i][0] = i;
+		labels[i] = i * 10.0;
+	}
+
+	// el test es el tramo que empieza en COMIENZO, el resto es entrenamiento en su orden
+	std::vector<std::uint32_t> identidad (10);
+	std::iota(identidad.begin(), identidad.end(), 0);
+
+	auto vistas = expressions_algs::preprocess::split_train_test_view(data, labels, identidad, 0.3, 4);
+
+	EXPECT_EQ(vistas.second.get_indices(), std::vector<std::uint32_t>({4, 5, 6}));
+	EXPECT_EQ(vistas.first.get_indices(), std::vector<std::uint32_t>({0, 1, 2, 3, 7, 8, 9}));
+	EXPECT_DOUBLE_EQ(vistas.second.get_label(1), 50.0);
+
+	auto copia = expressions_algs::preprocess::split_train_test(data, labels, 0.3, 4);
+
+	EXPECT_EQ(copia.first, vistas.first.materialize());
+	EXPECT_EQ(copia.second, vistas.second.materialize());
+
+	expressions_algs::Dataset datos (data, labels);
+	auto seleccion = datos.select_rows({9, 2});
+
+	EXPECT_DOUBLE_EQ(seleccion.get_value(0, 0), 9.0);
+	EXPECT_EQ(seleccion.get_labels(), std::vector<double>({90.0, 20.0}));
+}
+
+#endif
@@ -228,4 +228,159 @@ TEST ( Expression, LeerFichero) {
 	EXPECT_EQ(solucion, std::string("( ( -0.188219  / ( x3  +  -1.088276 ) ) + ( ( -6.747766  -  9.194880 ) * ( -4.898098  * ( ( x3  /  9.770432 ) *  x0 ) ) ) )"));
 }
 
+TEST ( Expression, MetricasEnUnaPasada) {
+	expressions_algs::Expression exp1;
+
+	Random::set_seed(5);
+	exp1.generate_random_expression(15, 0.5, 3);
+
+	std::vector<std::vector<double> > datos (30, std::vector<double>(3));
+	std::vector<double> etiquetas (datos.size());
+
+	for ( unsigned i = 0; i < datos.size(); i++) {
+		datos[i] = {i * 0.1, 1.0 - i * 0.05, 2.0};
+		etiquetas[i] = i * 0.3;
+	}
+
+	// una funcion que no se puede sacar de la pasada comun se llama con las mismas predicciones
+	expressions_algs::aux::eval_function_t maximo = [](const std::vector<double> & predichos,
+																		const std::vector<double> & reales) {
+		double resultado = 0.0;
+
+		for ( unsigned i = 0; i < reales.size(); i++) {
+			resultado = std::max(resultado, std::abs(predichos[i] - reales[i]));
+		}
+
+		return resultado;
+	};
+
+	const auto metricas = exp1.evaluate_metrics(datos, etiquetas, {expressions_algs::aux::mean_absolute_error, maximo});
+
+	exp1.evaluate_expression(datos, etiquetas, expressions_algs::aux::cuadratic_mean_error, true);
+	EXPECT_DOUBLE_EQ(metricas.mse, exp1.get_fitness());
+
+	exp1.evaluate_expression(datos, etiquetas, expressions_algs::aux::root_cuadratic_mean_error, true);
+	EXPECT_DOUBLE_EQ(metricas.rmse, exp1.get_fitness());
+
+	exp1.evaluate_expression(datos, etiquetas, expressions_algs::aux::mean_absolute_error, true);
+	EXPECT_DOUBLE_EQ(metricas.mae, exp1.get_fitness());
+
+	ASSERT_EQ(metricas.values.size(), 2u);
+	EXPECT_EQ(metricas.values[0], metricas.mae);
+
+	exp1.evaluate_expression(datos, etiquetas, maximo, true);
+	EXPECT_EQ(metricas.values[1], exp1.get_fitness());
+}
+
+TEST ( Expression, MetricasComoReducciones) {
+	using namespace expressions_algs::aux;
+
+	const std::vector<double> predichos = {1.0, 2.5, -3.0, 4.25, 0.5};
+	const std::vector<double> reales = {1.5, 2.0, -1.0, 4.0, 3.0};
+
+	// el adaptador de un puntero a funcion reduce fila a fila igual que la metrica conocida
+	EXPECT_EQ(reduce_metric(Runtime_metric(root_cuadratic_mean_error), predichos, reales),
+				 reduce_metric(Root_mean_squared_error(), predichos, reales));
+	EXPECT_EQ(reduce_metric(Runtime_metric(mean_absolute_error), predichos, reales),
+				 mean_absolute_error(predichos, reales));
+
+	eval_function_t maximo = [](const std::vector<double> & p, const std::vector<double> & r) {
+		return std::abs(p[0] - r[0]);
+	};
+
+	EXPECT_FALSE(Runtime_metric(maximo).is_decomposable());
+	EXPECT_EQ(reduce_metric(Runtime_metric(maximo), predichos, reales), 0.5);
+
+	// dos estados parciales se combinan en el de todas las filas
+	Mean_squared_error::state_t primera = Mean_squared_error::init();
+	Mean_squared_error::state_t segunda = Mean_squared_error::init();
+
+	for ( unsigned i = 0; i < reales.size(); i++) {
+		if ( i < 2 ) {
+			primera = Mean_squared_error::accumulate(primera, predichos[i], reales[i]);
+		} else {
+			segunda = Mean_squared_error::accumulate(segunda, predichos[i], reales[i]);
+		}
+	}
+
+	EXPECT_DOUBLE_EQ(Mean_squared_error::finalize(Mean_squared_error::combine(primera, segunda), reales.size()),
+						  cuadratic_mean_error(predichos, reales));
+	EXPECT_DOUBLE_EQ(cuadratic_mean_error(predichos, reales), (0.25 + 0.25 + 4.0 + 0.0625 + 6.25) / 5.0);
+}
+
+TEST ( Expression, CruceSoloPuntosFactibles) {
+	Random::set_seed(8);
+
+	for ( unsigned k = 0; k < 200; k++) {
+		expressions_algs::Expression madre (20, 0.3, 3, 20);
+		expressions_algs::Expression padre (20, 0.3, 3, 20);
+
+		// el tamaño de cada subarbol es el de get_subtree
+		const auto tamanios = madre.get_subtree_sizes();
+
+		for ( unsigned i = 0; i < tamanios.size(); i++) {
+			EXPECT_EQ(tamanios[i], madre.get_subtree(madre.get_tree(), i).size());
+		}
+
+		expressions_algs::Expression hijo1 = madre;
+		expressions_algs::Expression hijo2 = padre;
+
+		madre.tree_crossover(padre, hijo1, hijo2);
+
+		// los nodos se conservan y los dos hijos caben en la profundidad maxima
+		EXPECT_EQ(hijo1.get_tree_length() + hijo2.get_tree_length(), madre.get_tree_length() + padre.get_tree_length());
+		EXPECT_LE(hijo1.get_tree_length(), 20u);
+		EXPECT_LE(hijo2.get_tree_length(), 20u);
+		EXPECT_EQ(hijo1.get_subtree_sizes()[0], hijo1.get_tree_length());
+	}
+}
+
+TEST ( Expression, SubarbolConPresupuesto) {
+	const unsigned longitud_maxima = 20;
+	const unsigned presupuesto = 7;
+	const unsigned muestras = 20000;
+
+	// frecuencia de cada tamaño con el generador condicionado y repitiendo hasta que quepa
+	std::vector<double> condicionado (presupuesto + 1, 0.0);
+	std::vector<double> rechazo (presupuesto + 1, 0.0);
+
+	Random::set_seed(21);
+
+	for ( unsigned k = 0; k < muestras; k++) {
+		std::vector<expressions_algs::Node> arbol;
+		expressions_algs::Expression::append_random_subtree(longitud_maxima, presupuesto, 0.3, 2, arbol);
+
+		ASSERT_LE(arbol.size(), presupuesto);
+		expressions_algs::Expression exp1;
+		exp1.assign_tree(arbol);
+		ASSERT_EQ(exp1.get_subtree_sizes()[0], arbol.size());
+
+		condicionado[arbol.size()] += 1.0 / muestras;
+	}
+
+	for ( unsigned k = 0; k < muestras; k++) {
+		expressions_algs::Expression exp1;
+
+		do {
+			exp1.generate_random_expression(longitud_maxima, 0.3, 2);
+		} while ( exp1.get_tree_length() > presupuesto );
+
+		rechazo[exp1.get_tree_length()] += 1.0 / muestras;
+	}
+
+	for ( unsigned t = 1; t <= presupuesto; t++) {
+		EXPECT_NEAR(condicionado[t], rechazo[t], 0.015);
+	}
+
+	// la mutacion nunca se pasa de la profundidad maxima
+	expressions_algs::Expression exp2 (longitud_maxima, 0.3, 2, longitud_maxima);
+
+	for ( unsigned k = 0; k < 500; k++) {
+		exp2.mutate_GP(2);
+
+		ASSERT_LE(exp2.get_tree_length(), longitud_maxima);
+		ASSERT_EQ(exp2.get_subtree_sizes()[0], exp2.get_tree_length());
+	}
+}
+
 #endif
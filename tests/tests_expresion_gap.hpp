@@ -158,4 +158,53 @@ TEST (GA_P_Expression, ObtenerSurarbol) {
 
 }
 
+
+TEST (GA_P_Expression, MoverSinCopiar) {
+
+	static_assert(std::is_nothrow_move_constructible<expressions_algs::GA_P_Expression>::value);
+	static_assert(std::is_nothrow_move_assignable<expressions_algs::GA_P_Expression>::value);
+
+	expressions_algs::GA_P_Expression exp(10, 0.3, 4, 8);
+	exp.set_fitness(2.5);
+
+	const expressions_algs::GA_P_Expression copia = exp;
+
+	expressions_algs::GA_P_Expression movida (std::move(exp));
+
+	// la expresion movida queda vacia
+	EXPECT_EQ(movida, copia);
+	EXPECT_TRUE(exp.get_tree().empty());
+	EXPECT_EQ(exp.get_chromosome_length(), 0u);
+
+	exp = std::move(movida);
+
+	EXPECT_EQ(exp, copia);
+	EXPECT_EQ(exp.get_fitness(), 2.5);
+}
+
+
+TEST (GA_P_Expression, EscribirYLeerSinPerderPrecision) {
+
+	expressions_algs::GA_P_Expression exp(12, 0.3, 4, 8);
+	exp.set_fitness(1.0 / 3.0);
+
+	std::stringstream flujo;
+	exp.write(flujo);
+
+	expressions_algs::GA_P_Expression leida;
+
+	EXPECT_TRUE(leida.read(flujo));
+	EXPECT_EQ(leida, exp);
+	EXPECT_EQ(leida.get_chromosome(), exp.get_chromosome());
+	EXPECT_EQ(leida.get_fitness(), exp.get_fitness());
+	EXPECT_EQ(leida.is_evaluated(), exp.is_evaluated());
+
+	// un mensaje cortado no se acepta
+	std::stringstream ss_cortado;
+	exp.write(ss_cortado);
+	std::stringstream cortado (ss_cortado.str().substr(0, ss_cortado.str().size() - 1));
+
+	EXPECT_FALSE(leida.read(cortado));
+}
+
 #endif
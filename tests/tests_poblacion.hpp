@@ -0,0 +1,804 @@
+#ifndef TESTS_POBLACION
+#define TESTS_POBLACION
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unistd.h>
+#include "expressions_algs/Population.hpp"
+#include "expressions_algs/Racing_evaluator.hpp"
+#include "expressions_algs/Surrogate_model.hpp"
+#include "expressions_algs/Fold_executor.hpp"
+#include "expressions_algs/Task_scheduler.hpp"
+#include "expressions_algs/Successive_halving.hpp"
+#include "expressions_algs/Island_model.hpp"
+#include "expressions_algs/Island_worker.hpp"
+#include "expressions_algs/GP_alg.hpp"
+#include "expressions_algs/GA_P_alg.hpp"
+
+
+// datos sinteticos donde la etiqueta es la primera variable
+inline expressions_algs::Dataset datos_prueba_poblacion(const unsigned num_datos) {
+	matriz<double> data (num_datos, std::vector<double>(2));
+	std::vector<double> labels (num_datos);
+
+	for ( unsigned i = 0; i < num_datos; i++) {
+		data[i][0] = i * 0.01;
+		data[i][1] = 1.0;
+		labels[i] = data[i][0];
+	}
+
+	return expressions_algs::Dataset(data, labels);
+}
+
+inline expressions_algs::Expression expresion_x0_mas(const double constante) {
+	std::vector<expressions_algs::Node> arbol (3);
+
+	arbol[0].set_node_type(expressions_algs::NodeType::PLUS);
+	arbol[1].set_node_type(expressions_algs::NodeType::VARIABLE);
+	arbol[1].set_value(0);
+	arbol[2].set_node_type(expressions_algs::NodeType::NUMBER);
+	arbol[2].set_numeric_value(constante);
+
+	expressions_algs::Expression exp;
+	exp.assign_tree(arbol);
+
+	return exp;
+}
+
+
+TEST (Racing_evaluator, InactivoConPocosDatos) {
+	auto datos = datos_prueba_poblacion(50);
+
+	expressions_algs::Racing_evaluator racing(40);
+	racing.prepare(datos, datos.get_labels());
+
+	EXPECT_FALSE(racing.is_active());
+}
+
+TEST (Racing_evaluator, PromueveSoloLasPrometedoras) {
+	auto datos = datos_prueba_poblacion(2000);
+
+	expressions_algs::Racing_evaluator racing(64);
+	racing.prepare(datos, datos.get_labels());
+
+	ASSERT_TRUE(racing.is_active());
+
+	auto buena = racing.estimate(expresion_x0_mas(0.0), expressions_algs::aux::cuadratic_mean_error);
+	auto mala = racing.estimate(expresion_x0_mas(100.0), expressions_algs::aux::cuadratic_mean_error);
+
+	EXPECT_TRUE(expressions_algs::aux::compare_floats(buena.first, 0.0));
+	EXPECT_TRUE(racing.promote(buena, 1.0));
+	EXPECT_FALSE(racing.promote(mala, 1.0));
+}
+
+TEST (Population, CompeticionMantieneMejorEvaluado) {
+	auto datos = datos_prueba_poblacion(2000);
+
+	expressions_algs::Population<expressions_algs::Expression> poblacion;
+
+	for ( unsigned i = 0; i < 20; i++) {
+		poblacion.insert(expresion_x0_mas(i * 5.0));
+	}
+
+	expressions_algs::Racing_evaluator racing(64);
+	racing.prepare(datos, datos.get_labels());
+
+	poblacion.evaluate_population(datos, datos.get_labels(), expressions_algs::aux::cuadratic_mean_error, racing);
+
+	EXPECT_TRUE(poblacion.get_best_individual().is_evaluated());
+	EXPECT_EQ(poblacion.get_best_individual_index(), 0u);
+	EXPECT_TRUE(poblacion[19].is_estimated());
+}
+
+TEST (Population, EvaluaPorVentanasDatosProyectados) {
+	auto datos = datos_prueba_poblacion(3000);
+
+	ASSERT_TRUE(datos.write_binary("tests/test_ventanas.bin"));
+
+	expressions_algs::Dataset proyectados;
+
+	ASSERT_TRUE(expressions_algs::Dataset::map_binary("tests/test_ventanas.bin", proyectados));
+	std::remove("tests/test_ventanas.bin");
+
+	// ventanas de 100 filas, con dos variables y la etiqueta
+	proyectados.set_stream_window_bytes(100 * 3 * sizeof(double));
+
+	EXPECT_TRUE(proyectados.is_mapped());
+	EXPECT_FALSE(datos.is_mapped());
+	EXPECT_EQ(proyectados.get_stream_rows(), 100u);
+	EXPECT_EQ(datos.get_stream_rows(), 3000u);
+
+	expressions_algs::Population<expressions_algs::Expression> en_memoria, por_ventanas;
+
+	for ( unsigned i = 0; i < 10; i++) {
+		en_memoria.insert(expresion_x0_mas(i * 0.5));
+		por_ventanas.insert(expresion_x0_mas(i * 0.5));
+	}
+
+	en_memoria.evaluate_population(datos, datos.get_labels(), expressions_algs::aux::cuadratic_mean_error);
+	por_ventanas.evaluate_population(proyectados, proyectados.get_labels(), expressions_algs::aux::cuadratic_mean_error);
+
+	// el error acumulado por ventanas es el mismo que con todos los datos en memoria
+	for ( unsigned i = 0; i < 10; i++) {
+		EXPECT_DOUBLE_EQ(por_ventanas[i].get_fitness(), en_memoria[i].get_fitness());
+	}
+
+	auto exp = expresion_x0_mas(1.0);
+	exp.evaluate_expression(proyectados, proyectados.get_labels(), expressions_algs::aux::mean_absolute_error);
+
+	EXPECT_DOUBLE_EQ(exp.get_fitness(), 1.0);
+}
+
+TEST (Population, EvaluaPorVentanasPocosIndividuos) {
+	auto datos = datos_prueba_poblacion(20000);
+
+	ASSERT_TRUE(datos.write_binary("tests/test_ventanas.bin"));
+
+	expressions_algs::Dataset proyectados;
+
+	ASSERT_TRUE(expressions_algs::Dataset::map_binary("tests/test_ventanas.bin", proyectados));
+	std::remove("tests/test_ventanas.bin");
+
+	proyectados.set_stream_window_bytes(1000 * 3 * sizeof(double));
+
+	const int hebras_anteriores = expressions_algs::Evaluation_scheduler::available_threads();
+
+	// con menos individuos que hebras las hebras se reparten las filas de cada ventana
+	auto evaluar = [&](const expressions_algs::Dataset & data, const int hebras) {
+		expressions_algs::Task_scheduler::set_global_threads(hebras);
+
+		expressions_algs::Population<expressions_algs::Expression> poblacion;
+
+		poblacion.insert(expresion_x0_mas(0.5));
+		poblacion.insert(expresion_x0_mas(2.0));
+
+		poblacion.evaluate_population(data, data.get_labels(), expressions_algs::aux::cuadratic_mean_error);
+
+		return poblacion;
+	};
+
+	const auto en_memoria = evaluar(datos, 1);
+	const auto secuencial = evaluar(proyectados, 1);
+	const auto paralela = evaluar(proyectados, 4);
+
+	expressions_algs::Task_scheduler::set_global_threads(hebras_anteriores);
+
+	for ( unsigned i = 0; i < 2; i++) {
+		EXPECT_DOUBLE_EQ(paralela[i].get_fitness(), en_memoria[i].get_fitness());
+		EXPECT_EQ(paralela[i].get_fitness(), secuencial[i].get_fitness());
+	}
+}
+
+// metrica definida fuera de la biblioteca: el mayor error absoluto
+struct Error_maximo {
+	typedef double state_t;
+
+	state_t init() const {
+		return 0.0;
+	}
+
+	state_t accumulate(const state_t state, const double predicted_value, const double real_value) const {
+		return std::max(state, std::abs(predicted_value - real_value));
+	}
+
+	state_t combine(const state_t first, const state_t second) const {
+		return std::max(first, second);
+	}
+
+	double finalize(const state_t state, const unsigned) const {
+		return state;
+	}
+};
+
+TEST (Population, EvaluaConMetricaPropia) {
+	auto datos = datos_prueba_poblacion(3000);
+
+	ASSERT_TRUE(datos.write_binary("tests/test_metrica.bin"));
+
+	expressions_algs::Dataset proyectados;
+
+	ASSERT_TRUE(expressions_algs::Dataset::map_binary("tests/test_metrica.bin", proyectados));
+	std::remove("tests/test_metrica.bin");
+
+	proyectados.set_stream_window_bytes(100 * 3 * sizeof(double));
+
+	expressions_algs::Population<expressions_algs::Expression> en_memoria, por_ventanas;
+
+	for ( unsigned i = 0; i < 10; i++) {
+		en_memoria.insert(expresion_x0_mas(i * 0.5 - 2.0));
+		por_ventanas.insert(expresion_x0_mas(i * 0.5 - 2.0));
+	}
+
+	en_memoria.evaluate_population(datos, datos.get_labels(), Error_maximo());
+	por_ventanas.evaluate_population(proyectados, proyectados.get_labels(), Error_maximo());
+
+	// la etiqueta es la primera variable, el error es la constante sumada en todas las filas
+	for ( unsigned i = 0; i < 10; i++) {
+		EXPECT_NEAR(en_memoria[i].get_fitness(), std::abs(i * 0.5 - 2.0), 1e-9);
+		EXPECT_DOUBLE_EQ(por_ventanas[i].get_fitness(), en_memoria[i].get_fitness());
+	}
+
+	EXPECT_EQ(en_memoria.get_best_individual_index(), 4u);
+	EXPECT_EQ(por_ventanas.get_best_individual_index(), 4u);
+}
+
+TEST (Surrogate_model, RecuerdaFenotiposEvaluados) {
+	auto datos = datos_prueba_poblacion(500);
+
+	expressions_algs::Surrogate_model surrogate(2.0, 5);
+	surrogate.prepare(datos, datos.get_labels());
+
+	auto mala = surrogate.features(expresion_x0_mas(100.0), expressions_algs::aux::cuadratic_mean_error);
+
+	// sin entrenar nunca descarta
+	EXPECT_FALSE(surrogate.clearly_worse(mala, 1.0));
+
+	for ( unsigned i = 0; i <= 10; i++) {
+		auto exp = expresion_x0_mas(i * 10.0);
+		exp.evaluate_expression(datos, datos.get_labels(), expressions_algs::aux::cuadratic_mean_error);
+
+		surrogate.train(surrogate.features(exp, expressions_algs::aux::cuadratic_mean_error), exp.get_fitness());
+	}
+
+	EXPECT_TRUE(expressions_algs::aux::compare_floats(surrogate.predict(mala), 10000.0));
+	EXPECT_TRUE(surrogate.clearly_worse(mala, 1.0));
+}
+
+TEST (Evaluation_scheduler, EligeEjeSegunTamano) {
+	using expressions_algs::Evaluation_scheduler;
+	using expressions_algs::EvaluationAxis;
+
+	// poco trabajo, una sola hebra
+	Evaluation_scheduler pequeno (2, 20, 100, 8);
+	EXPECT_EQ(pequeno.get_num_threads(), 1u);
+	EXPECT_EQ(pequeno.get_axis(), EvaluationAxis::INDIVIDUALS);
+
+	// muchos individuos, se reparten individuos
+	Evaluation_scheduler poblacion (200, 4000, 100000, 8);
+	EXPECT_EQ(poblacion.get_axis(), EvaluationAxis::INDIVIDUALS);
+	EXPECT_EQ(poblacion.get_row_blocks(), 1u);
+
+	// un solo individuo con muchos datos, se reparten filas
+	Evaluation_scheduler individuo (1, 20, 100000, 8);
+	EXPECT_EQ(individuo.get_axis(), EvaluationAxis::ROWS);
+	EXPECT_EQ(individuo.get_row_blocks(), 32u);
+
+	// pocos individuos, teselas de individuo y bloque de filas
+	Evaluation_scheduler teselas (10, 200, 100000, 8);
+	EXPECT_EQ(teselas.get_axis(), EvaluationAxis::TILES);
+	EXPECT_EQ(teselas.get_row_blocks(), 4u);
+}
+
+TEST (Fold_executor, FoldsIndependientesDelReparto) {
+	using expressions_algs::Fold_executor;
+
+	// como mucho un fold por hebra
+	EXPECT_EQ(Fold_executor(5, 8).get_concurrent_folds(), 5u);
+	EXPECT_EQ(Fold_executor(2, 8).get_concurrent_folds(), 2u);
+	EXPECT_EQ(Fold_executor(5, 1).get_concurrent_folds(), 1u);
+
+	auto ejecutar = [](const unsigned hebras) {
+		std::vector<int> valores (6);
+		Fold_executor ejecutor (valores.size(), hebras);
+
+		ejecutor.run([&valores](const unsigned fold) {
+			Random::set_seed(Fold_executor::fold_seed(42, fold));
+			valores[fold] = Random::get_int(1000000);
+		});
+
+		EXPECT_EQ(ejecutor.get_fold_times().size(), valores.size());
+
+		return valores;
+	};
+
+	Random::set_seed(3);
+	const std::mt19937 generador = Random::get_generator();
+
+	// cada fold tiene su semilla, el resultado no depende del numero de hebras
+	auto secuencial = ejecutar(1);
+
+	EXPECT_EQ(secuencial, ejecutar(3));
+	EXPECT_NE(secuencial[0], secuencial[1]);
+
+	// el generador de la hebra principal no cambia
+	EXPECT_TRUE(generador == Random::get_generator());
+}
+
+TEST (Work_stealing_queue, ReparteLasMasCostosasPrimero) {
+	std::vector<unsigned> tareas = {10, 11, 12, 13, 14};
+	std::vector<double> costes = {1.0, 5.0, 3.0, 4.0, 2.0};
+
+	expressions_algs::Work_stealing_queue cola (tareas, costes, 2);
+	unsigned tarea;
+
+	// el trabajador 0 recibe 11, 12 y 10; el 1 recibe 13 y 14
+	EXPECT_TRUE(cola.next(0, tarea));
+	EXPECT_EQ(tarea, 11u);
+	EXPECT_TRUE(cola.next(1, tarea));
+	EXPECT_EQ(tarea, 13u);
+	EXPECT_TRUE(cola.next(1, tarea));
+	EXPECT_EQ(tarea, 14u);
+
+	// sin tareas propias, el trabajador 1 roba la mas barata del 0
+	EXPECT_TRUE(cola.next(1, tarea));
+	EXPECT_EQ(tarea, 10u);
+	EXPECT_TRUE(cola.next(1, tarea));
+	EXPECT_EQ(tarea, 12u);
+	EXPECT_FALSE(cola.next(0, tarea));
+}
+
+TEST (Successive_halving, PromueveYContinuaLosMejores) {
+	auto datos = datos_prueba_poblacion(200);
+
+	std::vector<expressions_algs::Parameters> candidatos;
+
+	for ( unsigned i = 0; i < 5; i++) {
+		candidatos.push_back(expressions_algs::Parameters(0, expressions_algs::aux::cuadratic_mean_error,
+																		  0.2 * i, 0.05, 4, false));
+	}
+
+	expressions_algs::GP_alg algoritmo (datos, 7, 20, 4, 0.5);
+
+	auto buscar = [&]() {
+		expressions_algs::Successive_halving<expressions_algs::Expression> busqueda (candidatos, 40, 1000, 3);
+		busqueda.search(algoritmo, datos, 11);
+
+		return busqueda;
+	};
+
+	auto busqueda = buscar();
+	const unsigned mejor = busqueda.get_best_candidate();
+
+	// 5 candidatos en el primer peldaño, 2 en el segundo y 1 en el tercero, con 40, 120 y 360 evaluaciones
+	EXPECT_EQ(std::count(busqueda.get_rungs().begin(), busqueda.get_rungs().end(), 0u), 3);
+	EXPECT_EQ(std::count(busqueda.get_rungs().begin(), busqueda.get_rungs().end(), 1u), 1);
+	EXPECT_EQ(busqueda.get_rungs()[mejor], 2u);
+	EXPECT_EQ(busqueda.get_evaluations()[mejor], 360);
+
+	for ( unsigned i = 0; i < candidatos.size(); i++) {
+		if ( busqueda.get_rungs()[i] == 0 ) {
+			EXPECT_EQ(busqueda.get_evaluations()[i], 40);
+		}
+	}
+
+	// el algoritmo del mejor sigue siendo el que se ha ido ajustando, y la busqueda es reproducible
+	auto predicciones = busqueda.get_best_algorithm().predict(datos);
+	EXPECT_FLOAT_EQ(expressions_algs::aux::cuadratic_mean_error(predicciones, datos.get_labels()),
+						 busqueda.get_scores()[mejor]);
+
+	EXPECT_EQ(buscar().get_scores(), busqueda.get_scores());
+}
+
+TEST (Population, InicializacionIndependienteDeHebras) {
+	using expressions_algs::GA_P_Expression;
+
+	const int hebras_anteriores = expressions_algs::Evaluation_scheduler::available_threads();
+
+	auto generar = [](const int hebras) {
+		expressions_algs::Task_scheduler::set_global_threads(hebras);
+
+		Random::set_seed(17);
+
+		return expressions_algs::Population<GA_P_Expression>(300, 20, 0.3, 3, 20);
+	};
+
+	const auto secuencial = generar(1);
+	const auto paralela = generar(3);
+
+	expressions_algs::Task_scheduler::set_global_threads(hebras_anteriores);
+
+	ASSERT_EQ(paralela.get_population_size(), 300u);
+
+	// cada bloque tiene su semilla, la poblacion no depende del reparto entre hebras
+	for ( unsigned i = 0; i < secuencial.get_population_size(); i++) {
+		EXPECT_TRUE(secuencial[i].have_same_tree(paralela[i]));
+		EXPECT_EQ(secuencial[i].get_chromosome(), paralela[i].get_chromosome());
+		EXPECT_EQ(paralela[i].get_chromosome_length(), 20u);
+		EXPECT_FALSE(paralela[i].is_evaluated());
+	}
+
+	EXPECT_FALSE(secuencial[0].have_same_tree(secuencial[1]) &&
+					 secuencial[0].get_chromosome() == secuencial[1].get_chromosome());
+}
+
+
+TEST (Population, EliteSinOrdenar) {
+	using expressions_algs::Expression;
+
+	const int hebras_anteriores = expressions_algs::Evaluation_scheduler::available_threads();
+
+	expressions_algs::Population<Expression> poblacion;
+
+	Random::set_seed(5);
+
+	// mas de 1000 individuos para que la busqueda se haga en paralelo, con fitness repetidos
+	for ( unsigned i = 0; i < 1500; i++) {
+		Expression exp;
+		exp.set_fitness(Random::get_int(300));
+		poblacion.insert(std::move(exp));
+	}
+
+	// un individuo con fitness estimado no entra antes que los evaluados
+	poblacion[7].set_estimated_fitness(-1);
+
+	std::vector<int> esperados (poblacion.get_population_size());
+
+	for ( unsigned i = 0; i < esperados.size(); i++) {
+		esperados[i] = i;
+	}
+
+	std::stable_sort(esperados.begin(), esperados.end(), [&poblacion](const int a, const int b) {
+		return poblacion[a].is_evaluated() > poblacion[b].is_evaluated() ||
+				 (poblacion[a].is_evaluated() == poblacion[b].is_evaluated() &&
+				  poblacion[a].get_fitness() < poblacion[b].get_fitness());
+	});
+
+	esperados.resize(10);
+
+	poblacion.set_elite_size(10);
+
+	for ( const int hebras : {1, 3} ) {
+		expressions_algs::Task_scheduler::set_global_threads(hebras);
+
+		poblacion.search_best_individual();
+
+		EXPECT_EQ(poblacion.get_elite(), esperados);
+		EXPECT_EQ(static_cast<int>(poblacion.get_best_individual_index()), esperados[0]);
+	}
+
+	expressions_algs::Task_scheduler::set_global_threads(hebras_anteriores);
+}
+
+
+TEST (GA_P_alg, EstacionarioConservaElMejor) {
+	auto datos = datos_prueba_poblacion(200);
+
+	const int hebras_anteriores = expressions_algs::Evaluation_scheduler::available_threads();
+
+	expressions_algs::Parameters parametros (2000, expressions_algs::aux::cuadratic_mean_error,
+														  0.75, 0.75, 0.1, 0.1, 0.3, 4, false);
+	parametros.set_steady_state(true);
+
+	auto ajustar = [&](const int hebras) {
+		expressions_algs::Task_scheduler::set_global_threads(hebras);
+
+		Random::set_seed(3);
+
+		expressions_algs::GA_P_alg algoritmo (datos, 3, 50, 6, 0.5);
+		expressions_algs::Parameters inicial (parametros);
+		inicial.set_num_evaluations(0);
+
+		// sin presupuesto solo se evalua la poblacion inicial
+		algoritmo.fit(inicial);
+		const double fitness_inicial = algoritmo.get_best_individual().get_fitness();
+
+		algoritmo.fit(parametros);
+
+		EXPECT_LE(algoritmo.get_best_individual().get_fitness(), fitness_inicial);
+
+		return algoritmo.get_best_individual();
+	};
+
+	// con una hebra el resultado solo depende de la semilla
+	const auto primera = ajustar(1);
+	EXPECT_EQ(primera, ajustar(1));
+
+	// con varias hebras las inserciones se entrelazan, pero el mejor nunca se pierde
+	ajustar(3);
+
+	expressions_algs::Task_scheduler::set_global_threads(hebras_anteriores);
+}
+
+
+TEST (Island_model, DeterministaConCualquierNumeroDeHebras) {
+	auto datos = datos_prueba_poblacion(200);
+
+	expressions_algs::Parameters parametros (3200, expressions_algs::aux::cuadratic_mean_error,
+														  0.75, 0.1, 4, false);
+
+	expressions_algs::GP_alg algoritmo (datos, 7, 20, 6, 0.5);
+
+	for ( const auto topologia : {expressions_algs::MigrationTopology::RING,
+											 expressions_algs::MigrationTopology::RANDOM,
+											 expressions_algs::MigrationTopology::FULLY_CONNECTED} ) {
+
+		auto ajustar = [&](const unsigned hebras) {
+			expressions_algs::Island_model<expressions_algs::Expression> islas (algoritmo, 4, 13, 5, 2, topologia);
+			islas.fit(parametros, hebras);
+
+			return islas;
+		};
+
+		const auto secuencial = ajustar(1);
+		const auto paralelo = ajustar(3);
+
+		// 800 evaluaciones por isla en epocas de 5 generaciones de 20 individuos
+		EXPECT_EQ(secuencial.get_num_migrations(), 7u);
+		EXPECT_EQ(secuencial.get_best_island(), paralelo.get_best_island());
+
+		for ( unsigned i = 0; i < secuencial.get_num_islands(); i++) {
+			EXPECT_EQ(secuencial.get_island(i).get_best_individual(), paralelo.get_island(i).get_best_individual());
+			EXPECT_LE(secuencial.get_best_individual().get_fitness(),
+						 secuencial.get_island(i).get_best_individual().get_fitness());
+		}
+	}
+}
+
+TEST (Island_model, CadaIslaUsaSusHebras) {
+	auto datos = datos_prueba_poblacion(200);
+
+	// planificadores con los que evalua cada hebra
+	static std::mutex cerrojo;
+	static std::map<std::thread::id, std::set<const expressions_algs::Task_scheduler *> > planificadores;
+
+	planificadores.clear();
+
+	// error absoluto medio que no se acumula por filas, asi se evalua en las hebras de cada isla
+	const expressions_algs::aux::eval_function_t registrar_hebra = [](const std::vector<double> & predichos,
+																							const std::vector<double> & reales) {
+		{
+			std::lock_guard<std::mutex> bloqueo (cerrojo);
+			planificadores[std::this_thread::get_id()].insert(&expressions_algs::Task_scheduler::global());
+		}
+
+		double suma = 0.0;
+
+		for ( unsigned i = 0; i < reales.size(); i++) {
+			suma += std::abs(predichos[i] - reales[i]);
+		}
+
+		return suma / reales.size();
+	};
+
+	expressions_algs::Parameters parametros (1600, registrar_hebra, 0.75, 0.1, 4, false);
+	expressions_algs::GP_alg algoritmo (datos, 7, 20, 6, 0.5);
+
+	// dos grupos de dos hebras, uno por isla
+	expressions_algs::Island_model<expressions_algs::Expression> islas (algoritmo, 2, 13, 5, 2);
+	islas.fit(parametros, 4);
+
+	std::map<const expressions_algs::Task_scheduler *, unsigned> hebras_por_grupo;
+
+	EXPECT_EQ(planificadores.count(std::this_thread::get_id()), 0u);
+
+	for ( const auto & hebra : planificadores ) {
+		// una hebra solo evalua con el pool de su grupo, que nunca es el global
+		ASSERT_EQ(hebra.second.size(), 1u);
+
+		const expressions_algs::Task_scheduler * grupo = *hebra.second.begin();
+
+		EXPECT_NE(grupo, &expressions_algs::Task_scheduler::global());
+		hebras_por_grupo[grupo]++;
+	}
+
+	EXPECT_EQ(hebras_por_grupo.size(), 2u);
+
+	for ( const auto & grupo : hebras_por_grupo ) {
+		EXPECT_LE(grupo.second, 2u);
+	}
+}
+
+
+TEST (Island_worker, ProcesosIgualQueIslandModel) {
+	auto datos = datos_prueba_poblacion(200);
+
+	expressions_algs::Parameters parametros (3200, expressions_algs::aux::cuadratic_mean_error,
+														  0.75, 0.75, 0.1, 0.1, 0.3, 4, false);
+
+	expressions_algs::GA_P_alg algoritmo (datos, 7, 20, 6, 0.5);
+	expressions_algs::Island_model<expressions_algs::GA_P_Expression> islas (algoritmo, 3, 13, 5, 2,
+																									 expressions_algs::MigrationTopology::RANDOM);
+	islas.fit(parametros, 1);
+
+	const std::string socket_unix = "unix:/tmp/gap_islas_" + std::to_string(getpid()) + ".sock";
+
+	for ( const std::string & direccion : {socket_unix, std::string("tcp:127.0.0.1:0")} ) {
+		expressions_algs::Island_coordinator coordinador (3, 13, 5, 2, expressions_algs::MigrationTopology::RANDOM);
+		ASSERT_TRUE(coordinador.listen(direccion));
+
+		// cada isla en su hebra como si fuera otro proceso, con su propio algoritmo
+		std::vector<std::thread> trabajadores;
+
+		for ( unsigned i = 0; i < 3; i++) {
+			trabajadores.emplace_back([&]() {
+				expressions_algs::Island_worker<expressions_algs::GA_P_Expression> trabajador;
+
+				if ( trabajador.connect(coordinador.get_address()) ) {
+					expressions_algs::GA_P_alg propio (datos, 7, 20, 6, 0.5);
+					trabajador.fit(propio, parametros);
+				}
+			});
+		}
+
+		const bool terminado = coordinador.run();
+
+		for ( auto & trabajador : trabajadores ) {
+			trabajador.join();
+		}
+
+		ASSERT_TRUE(terminado);
+		EXPECT_EQ(coordinador.get_num_migrations(), islas.get_num_migrations());
+		EXPECT_EQ(coordinador.get_best_island(), islas.get_best_island());
+
+		for ( unsigned i = 0; i < 3; i++) {
+			std::istringstream resultado (coordinador.get_result(i));
+			expressions_algs::GA_P_Expression mejor;
+
+			EXPECT_TRUE(mejor.read(resultado));
+			EXPECT_EQ(mejor, islas.get_island(i).get_best_individual());
+			EXPECT_EQ(mejor.get_fitness(), islas.get_island(i).get_best_individual().get_fitness());
+		}
+	}
+}
+
+
+TEST (GA_P_alg, SolapadoConservaElMejor) {
+	auto datos = datos_prueba_poblacion(200);
+
+	const int hebras_anteriores = expressions_algs::Evaluation_scheduler::available_threads();
+
+	expressions_algs::Parameters parametros (2000, expressions_algs::aux::cuadratic_mean_error,
+														  0.75, 0.75, 0.1, 0.1, 0.3, 4, false);
+	parametros.set_pipelined(true, 0.25);
+
+	auto ajustar = [&](const int hebras) {
+		expressions_algs::Task_scheduler::set_global_threads(hebras);
+
+		Random::set_seed(3);
+
+		expressions_algs::GA_P_alg algoritmo (datos, 3, 50, 6, 0.5);
+		expressions_algs::Parameters inicial (parametros);
+		inicial.set_num_evaluations(0);
+
+		algoritmo.fit(inicial);
+		const double fitness_inicial = algoritmo.get_best_individual().get_fitness();
+
+		algoritmo.fit(parametros);
+
+		EXPECT_LE(algoritmo.get_best_individual().get_fitness(), fitness_inicial);
+
+		return algoritmo.get_best_individual();
+	};
+
+	// cada cruce tiene su semilla, con una hebra el resultado solo depende de la semilla
+	const auto primera = ajustar(1);
+	EXPECT_EQ(primera, ajustar(1));
+
+	// con varias hebras la seleccion empieza antes de terminar la generacion, y el mejor se conserva
+	ajustar(3);
+
+	expressions_algs::Task_scheduler::set_global_threads(hebras_anteriores);
+}
+
+
+TEST (Task_scheduler, BuclesAnidadosSinSuperarLasHebras) {
+	expressions_algs::Task_scheduler planificador (3);
+
+	std::vector<std::atomic<unsigned> > visitas (100 * 50);
+	std::atomic<unsigned> activas (0);
+	std::atomic<unsigned> maximo (0);
+
+	// cada iteracion abre otro bucle paralelo, las hebras que esperan ejecutan las tareas pendientes
+	planificador.parallel_for(0, 100, 1, [&](const unsigned i) {
+		planificador.parallel_for(0, 50, 1, [&](const unsigned j) {
+			const unsigned ahora = ++activas;
+			unsigned anterior = maximo.load();
+
+			while ( ahora > anterior && !maximo.compare_exchange_weak(anterior, ahora) ) {
+			}
+
+			visitas[i * 50 + j]++;
+			activas--;
+		});
+	});
+
+	for ( unsigned k = 0; k < visitas.size(); k++) {
+		EXPECT_EQ(visitas[k].load(), 1u);
+	}
+
+	EXPECT_LE(maximo.load(), planificador.get_num_threads());
+
+	const unsigned long suma = planificador.parallel_reduce(0, 10000, 100, 0UL,
+		[](const unsigned i, unsigned long & parcial) {
+			parcial += i;
+		},
+		[](unsigned long & total, const unsigned long & parcial) {
+			total += parcial;
+		});
+
+	EXPECT_EQ(suma, 49995000UL);
+}
+
+TEST (Task_scheduler, EsperaSoloConTareasDelGrupo) {
+	expressions_algs::Task_scheduler planificador (3);
+
+	// iteracion externa que ejecuta cada hebra, 0 fuera de ellas
+	static thread_local unsigned externa = 0;
+	std::atomic<unsigned> ajenas (0);
+
+	planificador.parallel_for(0, 24, 1, [&](const unsigned i) {
+		// una iteracion externa nunca empieza encima de otra que espera a su bucle interno
+		if ( externa != 0 ) {
+			ajenas++;
+		}
+
+		externa = i + 1;
+
+		planificador.parallel_for(0, 12, 1, [&](const unsigned) {
+			if ( externa != 0 && externa != i + 1 ) {
+				ajenas++;
+			}
+
+			// mientras otras hebras terminan estas tareas, la que espera se queda sin las suyas
+			std::this_thread::sleep_for(std::chrono::microseconds(200));
+		});
+
+		externa = 0;
+	});
+
+	EXPECT_EQ(ajenas.load(), 0u);
+}
+
+TEST (Task_scheduler, PoolDedicadoSoloUsaSusHebras) {
+	const std::vector<unsigned> nucleos = expressions_algs::Task_scheduler::reserve_cores(2);
+	expressions_algs::Task_scheduler dedicado (2, nucleos);
+
+	std::mutex cerrojo;
+	std::set<std::thread::id> hebras;
+	std::atomic<unsigned> fuera_del_pool (0);
+
+	EXPECT_TRUE(dedicado.is_dedicated());
+	EXPECT_FALSE(expressions_algs::Task_scheduler::global().is_dedicated());
+
+	expressions_algs::Task_group grupo (dedicado);
+
+	grupo.run([&]() {
+		// dentro de una tarea los bucles de la biblioteca van al mismo pool
+		if ( &expressions_algs::Task_scheduler::global() != &dedicado ) {
+			fuera_del_pool++;
+		}
+
+		expressions_algs::Task_scheduler::global().parallel_for(0, 64, 1, [&](const unsigned) {
+			std::lock_guard<std::mutex> bloqueo (cerrojo);
+			hebras.insert(std::this_thread::get_id());
+		});
+	});
+
+	// la hebra que espera desde fuera no ejecuta ninguna tarea, tampoco un bucle de un solo trozo
+	grupo.wait();
+
+	dedicado.parallel_for(0, 1, 1, [&](const unsigned) {
+		std::lock_guard<std::mutex> bloqueo (cerrojo);
+		hebras.insert(std::this_thread::get_id());
+	});
+
+	EXPECT_EQ(fuera_del_pool.load(), 0u);
+	EXPECT_EQ(hebras.count(std::this_thread::get_id()), 0u);
+	EXPECT_LE(hebras.size(), 2u);
+
+	#ifdef __linux__
+		// las hebras del pool solo se ejecutan en sus nucleos
+		std::atomic<unsigned> otros_nucleos (0);
+
+		dedicado.parallel_for(0, 8, 1, [&](const unsigned) {
+			cpu_set_t permitidos;
+			pthread_getaffinity_np(pthread_self(), sizeof(permitidos), &permitidos);
+
+			for ( unsigned nucleo = 0; nucleo < CPU_SETSIZE; nucleo++) {
+				if ( CPU_ISSET(nucleo, &permitidos) &&
+					  std::find(nucleos.begin(), nucleos.end(), nucleo) == nucleos.end() ) {
+					otros_nucleos++;
+				}
+			}
+		});
+
+		EXPECT_FALSE(nucleos.empty());
+		EXPECT_EQ(otros_nucleos.load(), 0u);
+	#endif
+}
+
+#endif